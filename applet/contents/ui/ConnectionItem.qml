@@ -46,8 +46,8 @@ PlasmaExtras.ExpandableListItem {
                               Type == PlasmaNM.Enums.Gsm ||
                               Type == PlasmaNM.Enums.Cdma)
 
-    property real rxBytes: 0
-    property real txBytes: 0
+    property real rxBytes: RxRate
+    property real txBytes: TxRate
 
     icon: model.ConnectionIcon
     title: model.ItemUniqueName
@@ -159,8 +159,8 @@ PlasmaExtras.ExpandableListItem {
                     left: parent.left
                     right: parent.right
                 }
-                downloadSpeed: rxBytes
-                uploadSpeed: txBytes
+                downloadHistory: RxRateHistory
+                uploadHistory: TxRateHistory
                 visible: detailsTabBar.currentTab == speedTabButton
             }
         }
@@ -184,7 +184,7 @@ PlasmaExtras.ExpandableListItem {
                 onAccepted: {
                     stateChangeButton.trigger()
                     connectionItem.customExpandedViewContent = detailsComponent
-                    scanTimer.running = true
+                    mainWindow.scanningPaused = false
                 }
 
                 onAcceptableInputChanged: {
@@ -192,16 +192,16 @@ PlasmaExtras.ExpandableListItem {
                 }
 
                 onActiveFocusChanged: {
-                    scanTimer.running = !activeFocus
+                    mainWindow.scanningPaused = activeFocus
                 }
 
                 Component.onCompleted: {
                     stateChangeButton.enabled = false
                     passwordField.forceActiveFocus()
-                    appletProxyModel.dynamicSortFilter = true
                 }
 
                 Component.onDestruction: {
+                    appletProxyModel.sortingFrozen = false
                     stateChangeButton.enabled = true
                     connectionItem.customExpandedViewContent = detailsComponent
                 }
@@ -209,25 +209,6 @@ PlasmaExtras.ExpandableListItem {
         }
     }
 
-    Timer {
-        id: timer
-        repeat: true
-        interval: 2000
-        running: showSpeed
-        property real prevRxBytes
-        property real prevTxBytes
-        Component.onCompleted: {
-            prevRxBytes = RxBytes
-            prevTxBytes = TxBytes
-        }
-        onTriggered: {
-            rxBytes = prevRxBytes == 0 ? 0 : (RxBytes - prevRxBytes) * 1000 / interval
-            txBytes = prevTxBytes == 0 ? 0 : (TxBytes - prevTxBytes) * 1000 / interval
-            prevRxBytes = RxBytes
-            prevTxBytes = TxBytes
-        }
-    }
-
     function changeState() {
         if (Uuid || !predictableWirelessPassword || connectionItem.customExpandedViewContent == passwordDialogComponent) {
             if (ConnectionState == PlasmaNM.Enums.Deactivated) {
@@ -248,7 +229,7 @@ PlasmaExtras.ExpandableListItem {
                 handler.deactivateConnection(ConnectionPath, DevicePath)
             }
         } else if (predictableWirelessPassword) {
-            appletProxyModel.dynamicSortFilter = false
+            appletProxyModel.sortingFrozen = true
             connectionItem.customExpandedViewContent = passwordDialogComponent
             connectionItem.expand()
         }
@@ -283,7 +264,7 @@ PlasmaExtras.ExpandableListItem {
     }
 
     onShowSpeedChanged: {
-        connectionModel.setDeviceStatisticsRefreshRateMs(DevicePath, showSpeed ? 2000 : 0)
+        connectionModel.setDeviceStatisticsRefreshRateMs(DevicePath, showSpeed ? 2000 : 0, connectionItem)
     }
 
     onActivatingChanged: {
@@ -307,9 +288,9 @@ PlasmaExtras.ExpandableListItem {
     }
 
     // Re-activate the default button if the password field is hidden without
-    // sending a password, and start the scan timer
+    // sending a password, and resume scanning
     onItemCollapsed: {
         stateChangeButton.enabled = true;
-        scanTimer.running = true;
+        mainWindow.scanningPaused = false;
     }
 }
@@ -28,8 +28,8 @@ import org.kde.plasma.components 3.0 as PlasmaComponents3
 import org.kde.plasma.core 2.0 as PlasmaCore
 
 ColumnLayout {
-    property alias downloadSpeed: download.value
-    property alias uploadSpeed: upload.value
+    property alias downloadHistory: download.array
+    property alias uploadHistory: upload.array
 
     spacing: PlasmaCore.Units.largeSpacing
 
@@ -83,13 +83,11 @@ ColumnLayout {
                 increment: 100 * 1024
             }
             valueSources: [
-                QuickCharts.ValueHistorySource {
+                QuickCharts.ArraySource {
                     id: upload
-                    maximumHistory: 40
                 },
-                QuickCharts.ValueHistorySource {
+                QuickCharts.ArraySource {
                     id: download
-                    maximumHistory: 40
                 }
             ]
             nameSource: QuickCharts.ArraySource {
@@ -29,6 +29,8 @@ Item {
 
     readonly property string kcm: "kcm_networkmanagement"
     readonly property bool kcmAuthorized: KCMShell.authorize("kcm_networkmanagement.desktop").length == 1
+    // Set while a password is being typed so that the list doesn't change under the user
+    property bool scanningPaused: false
 
     Plasmoid.toolTipMainText: i18n("Networks")
     Plasmoid.toolTipSubText: networkStatus.activeConnections
@@ -73,14 +75,6 @@ Item {
 
     PlasmaNM.Handler {
         id: handler
-    }
-
-    Timer {
-        id: scanTimer
-        interval: 10200
-        repeat: true
-        running: plasmoid.expanded && !connectionIconProvider.airplaneMode
-
-        onTriggered: handler.requestScan()
+        periodicScanning: plasmoid.expanded && !connectionIconProvider.airplaneMode && !mainWindow.scanningPaused
     }
 }
@@ -53,7 +53,6 @@
 #include <QFileDialog>
 #include <QMenu>
 #include <QVBoxLayout>
-#include <QTimer>
 #include <QQmlContext>
 #include <QQmlEngine>
 #include <QQuickItem>
@@ -209,15 +208,9 @@ KCMNetworkmanagement::KCMNetworkmanagement(QWidget *parent, const QVariantList &
 
     connect(NetworkManager::settingsNotifier(), &NetworkManager::SettingsNotifier::connectionAdded, this, &KCMNetworkmanagement::onConnectionAdded, Qt::UniqueConnection);
 
-    // Initialize first scan and then scan every 15 seconds
+    // Initialize first scan and then keep scanning as long as the KCM is open
     m_handler->requestScan();
-
-    m_timer = new QTimer(this);
-    m_timer->setInterval(15000);
-    connect(m_timer, &QTimer::timeout, [this] () {
-        m_handler->requestScan();
-    });
-    m_timer->start();
+    m_handler->setPeriodicScanning(true);
 }
 
 KCMNetworkmanagement::~KCMNetworkmanagement()
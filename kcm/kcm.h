@@ -59,7 +59,6 @@ private:
     QString m_createdConnectionUuid;
     Handler *m_handler;
     ConnectionEditorTabWidget *m_tabWidget;
-    QTimer *m_timer;
     Ui::KCMForm *m_ui;
 };
 
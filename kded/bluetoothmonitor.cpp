@@ -22,6 +22,7 @@
 */
 
 #include "bluetoothmonitor.h"
+#include "connectionsummarycache.h"
 #include "debug.h"
 
 #include <KLocalizedString>
@@ -58,12 +59,11 @@ bool BluetoothMonitor::bluetoothConnectionExists(const QString &bdAddr, const QS
         return false;
     }
 
-    for (const NetworkManager::Connection::Ptr &con : NetworkManager::listConnections()) {
-        if (con && con->settings() && con->settings()->connectionType() == NetworkManager::ConnectionSettings::Bluetooth) {
-            NetworkManager::BluetoothSetting::Ptr btSetting = con->settings()->setting(NetworkManager::Setting::Bluetooth).staticCast<NetworkManager::BluetoothSetting>();
-            if (btSetting->profileType() == profile && btSetting->bluetoothAddress() == NetworkManager::macAddressFromString(bdAddr)) {
-                return true;
-            }
+    const QByteArray bluetoothAddress = NetworkManager::macAddressFromString(bdAddr);
+    for (const ConnectionSummary &summary : ConnectionSummaryCache::instance()->summaries()) {
+        if (summary.type == NetworkManager::ConnectionSettings::Bluetooth &&
+            summary.bluetoothProfile == profile && summary.bluetoothAddress == bluetoothAddress) {
+            return true;
         }
     }
 
@@ -20,8 +20,12 @@
 
 
 #include "monitor.h"
+#include "perfcounters.h"
+#include "scanscheduler.h"
+#include "tracespans.h"
 
 #include <QDBusConnection>
+#include <QDBusServiceWatcher>
 
 Monitor::Monitor(QObject* parent)
     : QObject(parent)
@@ -30,14 +34,27 @@ Monitor::Monitor(QObject* parent)
     m_modemMonitor = new ModemMonitor(this);
 #endif
     m_bluetoothMonitor = new BluetoothMonitor(this);
+    m_trafficAccounting = new TrafficAccounting(this);
+
+    // Keep the one scanning schedule for all the clients
+    ScanScheduler::instance()->setAuthoritative();
+    connect(ScanScheduler::instance(), &ScanScheduler::scheduleChanged, this, &Monitor::scanScheduleChanged);
+    m_scanClientWatcher = new QDBusServiceWatcher(this);
+    m_scanClientWatcher->setConnection(QDBusConnection::sessionBus());
+    m_scanClientWatcher->setWatchMode(QDBusServiceWatcher::WatchForUnregistration);
+    connect(m_scanClientWatcher, &QDBusServiceWatcher::serviceUnregistered, this, &Monitor::scanClientUnregistered);
 
     QDBusConnection::sessionBus().registerService("org.kde.plasmanetworkmanagement");
     QDBusConnection::sessionBus().registerObject("/org/kde/plasmanetworkmanagement", this, QDBusConnection::ExportScriptableContents);
+    // Exports the span recording on the bus right away, not with the first span
+    TraceSpans::instance();
 }
 
 Monitor::~Monitor()
 {
     delete m_bluetoothMonitor;
+    delete m_trafficAccounting;
+    qDeleteAll(m_scanClients);
 #if WITH_MODEMMANAGER_SUPPORT
     delete m_modemMonitor;
 #endif
@@ -53,6 +70,62 @@ void Monitor::addBluetoothConnection(const QString &bdAddr, const QString &servi
     m_bluetoothMonitor->addBluetoothConnection(bdAddr, service, connectionName);
 }
 
+QVariantMap Monitor::connectionTraffic(const QString &uuid, qlonglong from, qlonglong to)
+{
+    const TrafficAccounting::Counters counters = m_trafficAccounting->traffic(uuid, from, to);
+
+    QVariantMap result;
+    result.insert(QStringLiteral("RxBytes"), counters.rxBytes);
+    result.insert(QStringLiteral("TxBytes"), counters.txBytes);
+    return result;
+}
+
+void Monitor::setScanInterest(bool interested)
+{
+    if (!calledFromDBus()) {
+        return;
+    }
+
+    const QString client = message().service();
+    if (interested && !m_scanClients.contains(client)) {
+        QObject *consumer = new QObject(this);
+        m_scanClients.insert(client, consumer);
+        m_scanClientWatcher->addWatchedService(client);
+        ScanScheduler::instance()->setInterested(consumer, true);
+    } else if (!interested && m_scanClients.contains(client)) {
+        m_scanClientWatcher->removeWatchedService(client);
+        delete m_scanClients.take(client);
+    }
+}
+
+void Monitor::requestScan(const QString &interface)
+{
+    ScanScheduler::instance()->scanNow(interface);
+}
+
+QVariantList Monitor::scanSchedule()
+{
+    QVariantList result;
+    for (const QVariant &entry : ScanScheduler::instance()->schedule()) {
+        QVariantMap decision = entry.toMap();
+        const QDateTime nextScan = decision.value(QStringLiteral("NextScan")).toDateTime();
+        decision.insert(QStringLiteral("NextScan"), nextScan.isValid() ? nextScan.toMSecsSinceEpoch() : qlonglong(-1));
+        result << decision;
+    }
+    return result;
+}
+
+QVariantMap Monitor::performanceCounters()
+{
+    return PerfCounters::instance()->snapshot();
+}
+
+void Monitor::scanClientUnregistered(const QString &service)
+{
+    m_scanClientWatcher->removeWatchedService(service);
+    delete m_scanClients.take(service);
+}
+
 #if WITH_MODEMMANAGER_SUPPORT
 void Monitor::unlockModem(const QString& modem)
 {
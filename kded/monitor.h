@@ -22,14 +22,18 @@
 #define PLASMA_NM_MONITOR_H
 
 #include <QObject>
+#include <QDBusContext>
 #include <QDBusPendingCallWatcher>
 
 #include "bluetoothmonitor.h"
+#include "trafficaccounting.h"
 #if WITH_MODEMMANAGER_SUPPORT
 #include "modemmonitor.h"
 #endif
 
-class Q_DECL_EXPORT Monitor : public QObject
+class QDBusServiceWatcher;
+
+class Q_DECL_EXPORT Monitor : public QObject, protected QDBusContext
 {
 Q_OBJECT
 Q_CLASSINFO("D-Bus Interface", "org.kde.plasmanetworkmanagement")
@@ -40,11 +44,42 @@ public:
 public Q_SLOTS:
     Q_SCRIPTABLE bool bluetoothConnectionExists(const QString &bdAddr, const QString &service);
     Q_SCRIPTABLE void addBluetoothConnection(const QString &bdAddr, const QString &service, const QString &connectionName);
+    /**
+     * Returns RxBytes and TxBytes transferred by the connection with the given uuid,
+     * the range is given in seconds since epoch
+     */
+    Q_SCRIPTABLE QVariantMap connectionTraffic(const QString &uuid, qlonglong from, qlonglong to);
+    /**
+     * Registers the interest of the calling client in periodic wireless scans,
+     * it's dropped once the client leaves the bus
+     */
+    Q_SCRIPTABLE void setScanInterest(bool interested);
+    /**
+     * Scans the given interface, or all of them when empty, as soon as possible
+     */
+    Q_SCRIPTABLE void requestScan(const QString &interface);
+    /**
+     * Returns the scanning decision for every wireless interface with Interface, Interval,
+     * NextScan (milliseconds since epoch, -1 when no scan is planned) and Reason
+     */
+    Q_SCRIPTABLE QVariantList scanSchedule();
+    /**
+     * Returns the counters and histograms of the work done by the module, see PerfCounters::snapshot()
+     */
+    Q_SCRIPTABLE QVariantMap performanceCounters();
 #if WITH_MODEMMANAGER_SUPPORT
     Q_SCRIPTABLE void unlockModem(const QString &modem);
 #endif
+Q_SIGNALS:
+    Q_SCRIPTABLE void scanScheduleChanged();
+private Q_SLOTS:
+    void scanClientUnregistered(const QString &service);
 private:
     BluetoothMonitor * m_bluetoothMonitor;
+    TrafficAccounting * m_trafficAccounting;
+    QDBusServiceWatcher * m_scanClientWatcher;
+    // Consumers registered with the scan scheduler for the clients by their unique bus name
+    QHash<QString, QObject*> m_scanClients;
 #if WITH_MODEMMANAGER_SUPPORT
     ModemMonitor * m_modemMonitor;
 #endif
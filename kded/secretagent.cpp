@@ -26,6 +26,8 @@
 #include "debug.h"
 
 #include "configuration.h"
+#include "perfcounters.h"
+#include "tracespans.h"
 
 #include <NetworkManagerQt/Settings>
 #include <NetworkManagerQt/ConnectionSettings>
@@ -154,7 +156,7 @@ void SecretAgent::CancelGetSecrets(const QDBusObjectPath &connection_path, const
             sendError(SecretAgent::AgentCanceled,
                       QLatin1String("Agent canceled the password dialog"),
                       request.message);
-            m_calls.removeAt(i);
+            finishRequest(i);
             break;
         }
     }
@@ -256,7 +258,7 @@ void SecretAgent::dialogAccepted()
                 }
             }
 
-            m_calls.removeAt(i);
+            finishRequest(i);
             break;
         }
     }
@@ -275,7 +277,7 @@ void SecretAgent::dialogRejected()
             sendError(SecretAgent::UserCanceled,
                       QLatin1String("User canceled the password dialog"),
                       request.message);
-            m_calls.removeAt(i);
+            finishRequest(i);
             break;
         }
     }
@@ -293,7 +295,7 @@ void SecretAgent::killDialogs()
         SecretsRequest request = m_calls[i];
         if (request.type == SecretsRequest::GetSecrets) {
             delete request.dialog;
-            m_calls.removeAt(i);
+            finishRequest(i);
         }
 
         ++i;
@@ -323,25 +325,28 @@ void SecretAgent::walletClosed()
 
 void SecretAgent::processNext()
 {
+    TRACE_SPAN("SecretAgent::processNext");
+    PerfCounters::instance()->record(PerfCounters::SecretsQueueDepth, m_calls.count());
+
     int i = 0;
     while (i < m_calls.size()) {
         SecretsRequest &request = m_calls[i];
         switch (request.type) {
         case SecretsRequest::GetSecrets:
             if (processGetSecrets(request)) {
-                m_calls.removeAt(i);
+                finishRequest(i);
                 continue;
             }
             break;
         case SecretsRequest::SaveSecrets:
             if (processSaveSecrets(request)) {
-                m_calls.removeAt(i);
+                finishRequest(i);
                 continue;
             }
             break;
         case SecretsRequest::DeleteSecrets:
             if (processDeleteSecrets(request)) {
-                m_calls.removeAt(i);
+                finishRequest(i);
                 continue;
             }
             break;
@@ -350,6 +355,14 @@ void SecretAgent::processNext()
     }
 }
 
+void SecretAgent::finishRequest(int index)
+{
+    PerfCounters *counters = PerfCounters::instance();
+    counters->increment(PerfCounters::SecretsRequests);
+    counters->recordElapsed(PerfCounters::SecretsRequestLatency, m_calls.at(index).received);
+    m_calls.removeAt(index);
+}
+
 bool SecretAgent::processGetSecrets(SecretsRequest &request) const
 {
     if (m_dialog) {
@@ -25,6 +25,8 @@
 
 #include <NetworkManagerQt/SecretAgent>
 
+#include <QElapsedTimer>
+
 namespace KWallet {
 class Wallet;
 }
@@ -43,7 +45,9 @@ public:
         flags(NetworkManager::SecretAgent::None),
         saveSecretsWithoutReply(false),
         dialog(nullptr)
-    {}
+    {
+        received.start();
+    }
     inline bool operator==(const QString &other) const {
         return callId == other;
     }
@@ -63,6 +67,7 @@ public:
     bool saveSecretsWithoutReply;
     QDBusMessage message;
     PasswordDialog *dialog;
+    QElapsedTimer received;
 };
 
 class Q_DECL_EXPORT SecretAgent : public NetworkManager::SecretAgent
@@ -90,6 +95,10 @@ private Q_SLOTS:
 
 private:
     void processNext();
+    /**
+     * Removes the request at @p index from the queue once it's answered or dropped
+     */
+    void finishRequest(int index);
     /**
      * @brief processGetSecrets requests
      * @param request the request we are processing
@@ -0,0 +1,426 @@
+/*
+    Copyright 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "trafficaccounting.h"
+#include "debug.h"
+
+#include <NetworkManagerQt/ActiveConnection>
+#include <NetworkManagerQt/Device>
+#include <NetworkManagerQt/Manager>
+
+#include <QDateTime>
+#include <QDir>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QUuid>
+
+#include <cstring>
+
+static const char trafficFileMagic[4] = {'P', 'N', 'M', 'T'};
+static const quint32 trafficFileVersion = 1;
+// The file grows by this number of records
+static const quint64 trafficFileChunk = 1024;
+// How long buckets are kept in the given resolution before they're folded into the next one
+static const qint64 minuteBucketsRetention = 2 * 24 * 3600;
+static const qint64 hourBucketsRetention = 62 * 24 * 3600;
+
+struct TrafficFileHeader {
+    char magic[4];
+    quint32 version;
+    quint64 recordCount;
+    quint64 reserved[2];
+};
+
+struct TrafficFileRecord {
+    uchar uuid[16];
+    qint64 start;
+    quint64 rxBytes;
+    quint64 txBytes;
+    quint32 resolution;
+    quint32 reserved;
+};
+
+static_assert(sizeof(TrafficFileHeader) == 32, "Unexpected size of the traffic file header");
+static_assert(sizeof(TrafficFileRecord) == 48, "Unexpected size of the traffic file record");
+
+static qint64 bucketLength(TrafficAccounting::Resolution resolution)
+{
+    switch (resolution) {
+        case TrafficAccounting::Minute:
+            return 60;
+        case TrafficAccounting::Hour:
+            return 3600;
+        default:
+            return 24 * 3600;
+    }
+}
+
+static qint64 bucketStart(qint64 time, TrafficAccounting::Resolution resolution)
+{
+    const qint64 length = bucketLength(resolution);
+    return time - ((time % length) + length) % length;
+}
+
+TrafficAccounting::TrafficAccounting(QObject *parent)
+    : QObject(parent)
+    , m_map(nullptr)
+    , m_capacity(0)
+{
+    const QString directory = QStandardPaths::writableLocation(QStandardPaths::GenericDataLocation) + QStringLiteral("/plasma-nm");
+    QDir().mkpath(directory);
+    m_file.setFileName(directory + QStringLiteral("/traffic"));
+
+    if (load()) {
+        compact();
+    } else {
+        qCWarning(PLASMA_NM) << "Failed to open traffic accounting file" << m_file.fileName();
+    }
+
+    // Runs only while there is some traffic to account
+    m_sampleTimer.setInterval(60 * 1000);
+    connect(&m_sampleTimer, &QTimer::timeout, this, &TrafficAccounting::sample);
+
+    for (const NetworkManager::ActiveConnection::Ptr &activeConnection : NetworkManager::activeConnections()) {
+        activeConnectionAdded(activeConnection->path());
+    }
+
+    connect(NetworkManager::notifier(), &NetworkManager::Notifier::activeConnectionAdded, this, &TrafficAccounting::activeConnectionAdded);
+    connect(NetworkManager::notifier(), &NetworkManager::Notifier::activeConnectionRemoved, this, &TrafficAccounting::activeConnectionRemoved);
+}
+
+TrafficAccounting::~TrafficAccounting()
+{
+    sample();
+
+    if (m_map) {
+        m_file.unmap(m_map);
+    }
+}
+
+TrafficAccounting::Counters TrafficAccounting::traffic(const QString &uuid, qint64 from, qint64 to) const
+{
+    return sum(uuid, Day, from, to);
+}
+
+void TrafficAccounting::activeConnectionAdded(const QString &activeConnection)
+{
+    NetworkManager::ActiveConnection::Ptr active = NetworkManager::findActiveConnection(activeConnection);
+    // Traffic of VPN connections is already accounted to the connection they go through
+    if (!active || active->vpn() || active->devices().isEmpty() || active->uuid().isEmpty()) {
+        return;
+    }
+
+    ActiveConnection connection;
+    connection.uuid = active->uuid();
+    connection.devicePath = active->devices().first();
+    readCounters(connection.devicePath, &connection.interfaceName, &connection.counters);
+    m_activeConnections.insert(activeConnection, connection);
+
+    if (!m_sampleTimer.isActive()) {
+        m_sampleTimer.start();
+    }
+}
+
+void TrafficAccounting::activeConnectionRemoved(const QString &activeConnection)
+{
+    // Account the traffic since the last sample while the interface might still be around
+    sample();
+    m_activeConnections.remove(activeConnection);
+
+    if (m_activeConnections.isEmpty()) {
+        m_sampleTimer.stop();
+    }
+}
+
+void TrafficAccounting::sample()
+{
+    const qint64 now = QDateTime::currentSecsSinceEpoch();
+
+    for (auto it = m_activeConnections.begin(); it != m_activeConnections.end(); ++it) {
+        QString interfaceName;
+        Counters counters;
+        if (!readCounters(it->devicePath, &interfaceName, &counters)) {
+            continue;
+        }
+
+        // The connection moved to another interface (e.g. ppp), start counting from there
+        if (interfaceName != it->interfaceName) {
+            it->interfaceName = interfaceName;
+            it->counters = counters;
+            continue;
+        }
+
+        // Smaller values mean that the counters were reset
+        Counters difference;
+        difference.rxBytes = counters.rxBytes >= it->counters.rxBytes ? counters.rxBytes - it->counters.rxBytes : counters.rxBytes;
+        difference.txBytes = counters.txBytes >= it->counters.txBytes ? counters.txBytes - it->counters.txBytes : counters.txBytes;
+        it->counters = counters;
+
+        if (difference.rxBytes || difference.txBytes) {
+            addBuckets(it->uuid, Minute, now, difference);
+            appendRecord(it->uuid, Minute, bucketStart(now, Minute), difference);
+        }
+    }
+}
+
+void TrafficAccounting::addBuckets(const QString &uuid, Resolution resolution, qint64 start, const Counters &counters)
+{
+    // Every bucket is also part of the coarser ones
+    for (int i = resolution; i < ResolutionCount; ++i) {
+        Counters &bucket = m_buckets[i][uuid][bucketStart(start, static_cast<Resolution>(i))];
+        bucket.rxBytes += counters.rxBytes;
+        bucket.txBytes += counters.txBytes;
+    }
+}
+
+bool TrafficAccounting::appendRecord(const QString &uuid, Resolution resolution, qint64 start, const Counters &counters)
+{
+    if (!m_map) {
+        return false;
+    }
+
+    TrafficFileHeader *header = reinterpret_cast<TrafficFileHeader*>(m_map);
+    if (header->recordCount == m_capacity) {
+        compact();
+        if (!m_map) {
+            return false;
+        }
+        header = reinterpret_cast<TrafficFileHeader*>(m_map);
+        if (header->recordCount == m_capacity && !map(m_capacity + trafficFileChunk)) {
+            return false;
+        }
+        header = reinterpret_cast<TrafficFileHeader*>(m_map);
+    }
+
+    TrafficFileRecord *record = reinterpret_cast<TrafficFileRecord*>(m_map + sizeof(TrafficFileHeader)) + header->recordCount;
+    const QByteArray uuidData = QUuid(uuid).toRfc4122();
+    memcpy(record->uuid, uuidData.constData(), sizeof(record->uuid));
+    record->start = start;
+    record->rxBytes = counters.rxBytes;
+    record->txBytes = counters.txBytes;
+    record->resolution = resolution;
+    record->reserved = 0;
+    // Written after the record, so an interrupted write never exposes a partial one
+    ++header->recordCount;
+
+    return true;
+}
+
+void TrafficAccounting::compact()
+{
+    const qint64 now = QDateTime::currentSecsSinceEpoch();
+    const qint64 minuteCutoff = bucketStart(now - minuteBucketsRetention, Hour);
+    const qint64 hourCutoff = bucketStart(now - hourBucketsRetention, Day);
+
+    // Keep every bucket only in the finest resolution still retained for its time
+    struct Entry {
+        QString uuid;
+        Resolution resolution;
+        qint64 start;
+        Counters counters;
+    };
+    QVector<Entry> entries;
+    bool compactable = false;
+    for (int resolution = Minute; resolution < ResolutionCount; ++resolution) {
+        for (auto it = m_buckets[resolution].constBegin(); it != m_buckets[resolution].constEnd(); ++it) {
+            for (auto bucket = it->constBegin(); bucket != it->constEnd(); ++bucket) {
+                const qint64 start = bucket.key();
+                if ((resolution == Minute && start >= minuteCutoff) ||
+                    (resolution == Hour && start >= hourCutoff && start < minuteCutoff) ||
+                    (resolution == Day && start < hourCutoff)) {
+                    entries.append({it.key(), static_cast<Resolution>(resolution), start, bucket.value()});
+                } else if (resolution == Minute) {
+                    compactable = true;
+                }
+            }
+        }
+    }
+
+    // Folding the old buckets makes the file smaller, otherwise there is nothing to do
+    const TrafficFileHeader *header = reinterpret_cast<const TrafficFileHeader*>(m_map);
+    if (!m_map || (!compactable && header->recordCount <= static_cast<quint64>(entries.count()))) {
+        return;
+    }
+
+    // Old minute buckets are gone now, drop them from the memory as well
+    for (auto it = m_buckets[Minute].begin(); it != m_buckets[Minute].end(); ++it) {
+        it->erase(it->begin(), it->lowerBound(minuteCutoff));
+    }
+    for (auto it = m_buckets[Hour].begin(); it != m_buckets[Hour].end(); ++it) {
+        it->erase(it->begin(), it->lowerBound(hourCutoff));
+    }
+
+    const quint64 capacity = (entries.count() / trafficFileChunk + 1) * trafficFileChunk;
+    QByteArray data(sizeof(TrafficFileHeader) + capacity * sizeof(TrafficFileRecord), 0);
+    TrafficFileHeader *newHeader = reinterpret_cast<TrafficFileHeader*>(data.data());
+    memcpy(newHeader->magic, trafficFileMagic, sizeof(newHeader->magic));
+    newHeader->version = trafficFileVersion;
+    newHeader->recordCount = entries.count();
+    TrafficFileRecord *record = reinterpret_cast<TrafficFileRecord*>(data.data() + sizeof(TrafficFileHeader));
+    for (const Entry &entry : qAsConst(entries)) {
+        const QByteArray uuidData = QUuid(entry.uuid).toRfc4122();
+        memcpy(record->uuid, uuidData.constData(), sizeof(record->uuid));
+        record->start = entry.start;
+        record->rxBytes = entry.counters.rxBytes;
+        record->txBytes = entry.counters.txBytes;
+        record->resolution = entry.resolution;
+        ++record;
+    }
+
+    m_file.unmap(m_map);
+    m_map = nullptr;
+    m_file.close();
+
+    QSaveFile file(m_file.fileName());
+    if (!file.open(QIODevice::WriteOnly) || file.write(data) != data.size() || !file.commit()) {
+        qCWarning(PLASMA_NM) << "Failed to compact traffic accounting file" << m_file.fileName();
+    }
+
+    if (!m_file.open(QIODevice::ReadWrite) || !map(qMax<quint64>(capacity, (m_file.size() - sizeof(TrafficFileHeader)) / sizeof(TrafficFileRecord)))) {
+        qCWarning(PLASMA_NM) << "Failed to open traffic accounting file" << m_file.fileName();
+    }
+}
+
+bool TrafficAccounting::load()
+{
+    if (!m_file.open(QIODevice::ReadWrite)) {
+        return false;
+    }
+
+    bool valid = m_file.size() >= static_cast<qint64>(sizeof(TrafficFileHeader));
+    if (valid) {
+        TrafficFileHeader header;
+        valid = m_file.read(reinterpret_cast<char*>(&header), sizeof(header)) == sizeof(header) &&
+                !memcmp(header.magic, trafficFileMagic, sizeof(header.magic)) && header.version == trafficFileVersion;
+    }
+
+    if (!valid) {
+        if (m_file.size()) {
+            qCWarning(PLASMA_NM) << "Traffic accounting file" << m_file.fileName() << "is not valid, starting from scratch";
+        }
+        TrafficFileHeader header = {};
+        memcpy(header.magic, trafficFileMagic, sizeof(header.magic));
+        header.version = trafficFileVersion;
+        if (!m_file.resize(0) || !m_file.seek(0) || m_file.write(reinterpret_cast<const char*>(&header), sizeof(header)) != sizeof(header)) {
+            return false;
+        }
+    }
+
+    const quint64 capacity = (m_file.size() - sizeof(TrafficFileHeader)) / sizeof(TrafficFileRecord);
+    if (!map(qMax(capacity, trafficFileChunk))) {
+        return false;
+    }
+
+    TrafficFileHeader *header = reinterpret_cast<TrafficFileHeader*>(m_map);
+    // The record count is written last, but don't trust it more than the size of the file
+    header->recordCount = qMin(header->recordCount, m_capacity);
+
+    const TrafficFileRecord *records = reinterpret_cast<const TrafficFileRecord*>(m_map + sizeof(TrafficFileHeader));
+    for (quint64 i = 0; i < header->recordCount; ++i) {
+        const TrafficFileRecord &record = records[i];
+        if (record.resolution >= ResolutionCount) {
+            continue;
+        }
+        const QString uuid = QUuid::fromRfc4122(QByteArray::fromRawData(reinterpret_cast<const char*>(record.uuid), sizeof(record.uuid))).toString(QUuid::WithoutBraces);
+        Counters counters;
+        counters.rxBytes = record.rxBytes;
+        counters.txBytes = record.txBytes;
+        addBuckets(uuid, static_cast<Resolution>(record.resolution), record.start, counters);
+    }
+
+    return true;
+}
+
+bool TrafficAccounting::map(quint64 capacity)
+{
+    if (m_map) {
+        m_file.unmap(m_map);
+        m_map = nullptr;
+    }
+
+    const qint64 size = sizeof(TrafficFileHeader) + capacity * sizeof(TrafficFileRecord);
+    if (m_file.size() < size && !m_file.resize(size)) {
+        return false;
+    }
+
+    m_map = m_file.map(0, size);
+    m_capacity = m_map ? capacity : 0;
+    return m_map;
+}
+
+bool TrafficAccounting::readCounters(const QString &devicePath, QString *interfaceName, Counters *counters) const
+{
+    NetworkManager::Device::Ptr device = NetworkManager::findNetworkInterface(devicePath);
+    if (!device) {
+        return false;
+    }
+
+    *interfaceName = device->ipInterfaceName().isEmpty() ? device->interfaceName() : device->ipInterfaceName();
+
+    // Read the kernel counters directly, NetworkManager updates its statistics only when somebody asks for it
+    const QString statisticsPath = QStringLiteral("/sys/class/net/%1/statistics/").arg(*interfaceName);
+    QFile rxFile(statisticsPath + QStringLiteral("rx_bytes"));
+    QFile txFile(statisticsPath + QStringLiteral("tx_bytes"));
+    if (!rxFile.open(QIODevice::ReadOnly) || !txFile.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    bool rxOk = false;
+    bool txOk = false;
+    counters->rxBytes = rxFile.readAll().trimmed().toULongLong(&rxOk);
+    counters->txBytes = txFile.readAll().trimmed().toULongLong(&txOk);
+    return rxOk && txOk;
+}
+
+TrafficAccounting::Counters TrafficAccounting::sum(const QString &uuid, Resolution resolution, qint64 from, qint64 to) const
+{
+    Counters result;
+    if (from >= to) {
+        return result;
+    }
+
+    const QMap<qint64, Counters> buckets = m_buckets[resolution].value(uuid);
+    if (resolution == Minute) {
+        for (auto it = buckets.lowerBound(from); it != buckets.constEnd() && it.key() < to; ++it) {
+            result.rxBytes += it->rxBytes;
+            result.txBytes += it->txBytes;
+        }
+        return result;
+    }
+
+    // Use the buckets which are entirely within the range and the finer ones for the rest
+    const Resolution finer = static_cast<Resolution>(resolution - 1);
+    const qint64 first = bucketStart(from + bucketLength(resolution) - 1, resolution);
+    const qint64 last = bucketStart(to, resolution);
+    if (first >= last) {
+        return sum(uuid, finer, from, to);
+    }
+
+    for (auto it = buckets.lowerBound(first); it != buckets.constEnd() && it.key() < last; ++it) {
+        result.rxBytes += it->rxBytes;
+        result.txBytes += it->txBytes;
+    }
+
+    const Counters head = sum(uuid, finer, from, first);
+    const Counters tail = sum(uuid, finer, last, to);
+    result.rxBytes += head.rxBytes + tail.rxBytes;
+    result.txBytes += head.txBytes + tail.txBytes;
+    return result;
+}
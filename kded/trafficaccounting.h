@@ -0,0 +1,91 @@
+/*
+    Copyright 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PLASMA_NM_TRAFFIC_ACCOUNTING_H
+#define PLASMA_NM_TRAFFIC_ACCOUNTING_H
+
+#include <QFile>
+#include <QHash>
+#include <QMap>
+#include <QObject>
+#include <QTimer>
+
+/**
+ * Keeps the amount of data transferred by each connection. Device counters are sampled every
+ * minute and the differences are appended to a memory-mapped file as per-minute buckets, which
+ * are folded into per-hour and per-day buckets as they get older.
+ */
+class TrafficAccounting : public QObject
+{
+Q_OBJECT
+public:
+    enum Resolution {
+        Minute,
+        Hour,
+        Day,
+        ResolutionCount
+    };
+
+    struct Counters {
+        quint64 rxBytes = 0;
+        quint64 txBytes = 0;
+    };
+
+    explicit TrafficAccounting(QObject *parent);
+    ~TrafficAccounting() override;
+
+    /**
+     * Traffic of the connection with the given uuid between @p from and @p to,
+     * in seconds since epoch. Days are counted in UTC.
+     */
+    Counters traffic(const QString &uuid, qint64 from, qint64 to) const;
+
+private Q_SLOTS:
+    void activeConnectionAdded(const QString &activeConnection);
+    void activeConnectionRemoved(const QString &activeConnection);
+    void sample();
+
+private:
+    struct ActiveConnection {
+        QString uuid;
+        QString devicePath;
+        QString interfaceName;
+        Counters counters;
+    };
+
+    void addBuckets(const QString &uuid, Resolution resolution, qint64 start, const Counters &counters);
+    bool appendRecord(const QString &uuid, Resolution resolution, qint64 start, const Counters &counters);
+    void compact();
+    bool load();
+    bool map(quint64 capacity);
+    bool readCounters(const QString &devicePath, QString *interfaceName, Counters *counters) const;
+    Counters sum(const QString &uuid, Resolution resolution, qint64 from, qint64 to) const;
+
+    // Active connections by their path
+    QHash<QString, ActiveConnection> m_activeConnections;
+    // Buckets of each resolution by connection uuid and the start of the bucket
+    QHash<QString, QMap<qint64, Counters> > m_buckets[ResolutionCount];
+    QFile m_file;
+    uchar *m_map;
+    quint64 m_capacity;
+    QTimer m_sampleTimer;
+};
+
+#endif // PLASMA_NM_TRAFFIC_ACCOUNTING_H
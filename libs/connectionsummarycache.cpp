@@ -0,0 +1,186 @@
+/*
+    Copyright 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "connectionsummarycache.h"
+#include "debug.h"
+
+#include <NetworkManagerQt/Settings>
+
+#include <QDBusConnection>
+#include <QDBusMetaType>
+#include <QDBusPendingCallWatcher>
+#include <QDBusPendingReply>
+#include <QDBusReply>
+
+#define NM_DBUS_SERVICE "org.freedesktop.NetworkManager"
+#define NM_DBUS_SETTINGS_CONNECTION_INTERFACE "org.freedesktop.NetworkManager.Settings.Connection"
+
+static QDBusMessage getSettingsCall(const QString &path)
+{
+    return QDBusMessage::createMethodCall(QStringLiteral(NM_DBUS_SERVICE), path, QStringLiteral(NM_DBUS_SETTINGS_CONNECTION_INTERFACE), QStringLiteral("GetSettings"));
+}
+
+ConnectionSummaryCache *ConnectionSummaryCache::instance()
+{
+    static ConnectionSummaryCache cache;
+    return &cache;
+}
+
+ConnectionSummaryCache::ConnectionSummaryCache(QObject *parent)
+    : QObject(parent)
+{
+    qDBusRegisterMetaType<NMVariantMapMap>();
+    connect(NetworkManager::settingsNotifier(), &NetworkManager::SettingsNotifier::connectionRemoved, this, &ConnectionSummaryCache::connectionRemoved);
+}
+
+ConnectionSummaryCache::~ConnectionSummaryCache()
+{
+}
+
+ConnectionSummary ConnectionSummaryCache::summary(const QString &path)
+{
+    if (path.isEmpty()) {
+        return ConnectionSummary();
+    }
+
+    const auto it = m_summaries.constFind(path);
+    if (it != m_summaries.constEnd()) {
+        return *it;
+    }
+
+    // The caller needs the summary right away, only the updates are fetched asynchronously
+    const QDBusReply<NMVariantMapMap> reply = QDBusConnection::systemBus().call(getSettingsCall(path));
+    if (!reply.isValid()) {
+        return ConnectionSummary();
+    }
+
+    QDBusConnection::systemBus().connect(QStringLiteral(NM_DBUS_SERVICE), path, QStringLiteral(NM_DBUS_SETTINGS_CONNECTION_INTERFACE), QStringLiteral("Updated"),
+                                         this, SLOT(connectionUpdated(QDBusMessage)));
+    return *m_summaries.insert(path, decode(path, reply.value()));
+}
+
+QList<ConnectionSummary> ConnectionSummaryCache::summaries()
+{
+    QList<ConnectionSummary> result;
+    for (const NetworkManager::Connection::Ptr &connection : NetworkManager::listConnections()) {
+        const ConnectionSummary connectionSummary = summary(connection->path());
+        if (connectionSummary.isValid()) {
+            result << connectionSummary;
+        }
+    }
+    return result;
+}
+
+void ConnectionSummaryCache::connectionRemoved(const QString &path)
+{
+    if (m_summaries.remove(path)) {
+        QDBusConnection::systemBus().disconnect(QStringLiteral(NM_DBUS_SERVICE), path, QStringLiteral(NM_DBUS_SETTINGS_CONNECTION_INTERFACE), QStringLiteral("Updated"),
+                                                this, SLOT(connectionUpdated(QDBusMessage)));
+    }
+}
+
+void ConnectionSummaryCache::connectionUpdated(const QDBusMessage &message)
+{
+    // One GetSettings call per update, replies arrive in the order of the calls
+    const QString path = message.path();
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(QDBusConnection::systemBus().asyncCall(getSettingsCall(path)), this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [this, path] (QDBusPendingCallWatcher *watcher) {
+        watcher->deleteLater();
+
+        const QDBusPendingReply<NMVariantMapMap> reply = *watcher;
+        if (!reply.isValid()) {
+            qCWarning(PLASMA_NM) << "Failed to get settings of" << path << ":" << reply.error().message();
+            return;
+        }
+
+        // The connection might have been removed in the meantime
+        auto it = m_summaries.find(path);
+        if (it != m_summaries.end()) {
+            *it = decode(path, reply.value());
+            Q_EMIT summaryChanged(path);
+        }
+    });
+}
+
+static NetworkManager::WirelessSecurityType securityTypeFromMap(const QVariantMap &securitySetting)
+{
+    // Same as NetworkManager::securityTypeFromConnectionSetting(), without parsing the settings
+    const QString keyMgmt = securitySetting.value(QStringLiteral("key-mgmt")).toString();
+    const QStringList proto = securitySetting.value(QStringLiteral("proto")).toStringList();
+    const bool wpaOnly = proto.contains(QLatin1String("wpa")) && !proto.contains(QLatin1String("rsn"));
+
+    if (keyMgmt == QLatin1String("none")) {
+        return NetworkManager::StaticWep;
+    } else if (keyMgmt == QLatin1String("ieee8021x")) {
+        return securitySetting.value(QStringLiteral("auth-alg")).toString() == QLatin1String("leap") ? NetworkManager::Leap : NetworkManager::DynamicWep;
+    } else if (keyMgmt == QLatin1String("wpa-psk")) {
+        return wpaOnly ? NetworkManager::WpaPsk : NetworkManager::Wpa2Psk;
+    } else if (keyMgmt == QLatin1String("sae")) {
+        return NetworkManager::SAE;
+    } else if (keyMgmt == QLatin1String("wpa-eap")) {
+        return wpaOnly ? NetworkManager::WpaEap : NetworkManager::Wpa2Eap;
+    }
+
+    return NetworkManager::NoneSecurity;
+}
+
+ConnectionSummary ConnectionSummaryCache::decode(const QString &path, const NMVariantMapMap &settings)
+{
+    const QVariantMap connectionSetting = settings.value(QStringLiteral("connection"));
+
+    ConnectionSummary summary;
+    summary.path = path;
+    summary.id = connectionSetting.value(QStringLiteral("id")).toString();
+    summary.uuid = connectionSetting.value(QStringLiteral("uuid")).toString();
+    summary.type = NetworkManager::ConnectionSettings::typeFromString(connectionSetting.value(QStringLiteral("type")).toString());
+    if (connectionSetting.contains(QStringLiteral("timestamp"))) {
+        summary.timestamp = QDateTime::fromSecsSinceEpoch(connectionSetting.value(QStringLiteral("timestamp")).toLongLong());
+    }
+    summary.slave = !connectionSetting.value(QStringLiteral("master")).toString().isEmpty()
+                    && !connectionSetting.value(QStringLiteral("slave-type")).toString().isEmpty();
+
+    if (summary.type == NetworkManager::ConnectionSettings::Vpn) {
+        const QVariantMap vpnSetting = settings.value(NetworkManager::Setting::typeAsString(NetworkManager::Setting::Vpn));
+        summary.vpnServiceType = vpnSetting.value(QStringLiteral("service-type")).toString();
+    } else if (summary.type == NetworkManager::ConnectionSettings::Wireless) {
+        const QVariantMap wirelessSetting = settings.value(NetworkManager::Setting::typeAsString(NetworkManager::Setting::Wireless));
+        summary.ssid = QString::fromUtf8(wirelessSetting.value(QStringLiteral("ssid")).toByteArray());
+        summary.bssid = NetworkManager::macAddressAsString(wirelessSetting.value(QStringLiteral("bssid")).toByteArray());
+        summary.restrictedMacAddress = NetworkManager::macAddressAsString(wirelessSetting.value(QStringLiteral("mac-address")).toByteArray());
+        const QString mode = wirelessSetting.value(QStringLiteral("mode")).toString();
+        if (mode == QLatin1String("adhoc")) {
+            summary.mode = NetworkManager::WirelessSetting::Adhoc;
+        } else if (mode == QLatin1String("ap")) {
+            summary.mode = NetworkManager::WirelessSetting::Ap;
+        }
+        summary.securityType = securityTypeFromMap(settings.value(NetworkManager::Setting::typeAsString(NetworkManager::Setting::WirelessSecurity)));
+    } else if (summary.type == NetworkManager::ConnectionSettings::Bluetooth) {
+        const QVariantMap bluetoothSetting = settings.value(NetworkManager::Setting::typeAsString(NetworkManager::Setting::Bluetooth));
+        summary.bluetoothAddress = bluetoothSetting.value(QStringLiteral("bdaddr")).toByteArray();
+        const QString profile = bluetoothSetting.value(QStringLiteral("type")).toString();
+        if (profile == QLatin1String("dun")) {
+            summary.bluetoothProfile = NetworkManager::BluetoothSetting::Dun;
+        } else if (profile == QLatin1String("panu")) {
+            summary.bluetoothProfile = NetworkManager::BluetoothSetting::Panu;
+        }
+    }
+
+    return summary;
+}
@@ -0,0 +1,107 @@
+/*
+    Copyright 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PLASMA_NM_CONNECTION_SUMMARY_CACHE_H
+#define PLASMA_NM_CONNECTION_SUMMARY_CACHE_H
+
+#include <QDateTime>
+#include <QHash>
+#include <QObject>
+
+#include <NetworkManagerQt/BluetoothSetting>
+#include <NetworkManagerQt/ConnectionSettings>
+#include <NetworkManagerQt/GenericTypes>
+#include <NetworkManagerQt/Utils>
+#include <NetworkManagerQt/WirelessSetting>
+
+/**
+ * The few connection settings needed to list a connection
+ */
+class Q_DECL_EXPORT ConnectionSummary
+{
+public:
+    bool isValid() const { return !path.isEmpty(); }
+
+    QString path;
+    QString id;
+    QString uuid;
+    NetworkManager::ConnectionSettings::ConnectionType type = NetworkManager::ConnectionSettings::Unknown;
+    QDateTime timestamp;
+    bool slave = false;
+    // Vpn only
+    QString vpnServiceType;
+    // Wireless only
+    QString ssid;
+    QString bssid;
+    QString restrictedMacAddress;
+    NetworkManager::WirelessSetting::NetworkMode mode = NetworkManager::WirelessSetting::Infrastructure;
+    NetworkManager::WirelessSecurityType securityType = NetworkManager::UnknownSecurity;
+    // Bluetooth only
+    QByteArray bluetoothAddress;
+    NetworkManager::BluetoothSetting::ProfileType bluetoothProfile = NetworkManager::BluetoothSetting::Unknown;
+};
+
+class QDBusMessage;
+
+/**
+ * Summaries of the saved connections shared by all the models and monitors in the process.
+ * A summary is decoded from the raw settings of the connection, which are fetched once when
+ * the summary is first read and again asynchronously whenever NetworkManager reports an update.
+ * The parsed settings of NetworkManagerQt are never built for it.
+ */
+class Q_DECL_EXPORT ConnectionSummaryCache : public QObject
+{
+Q_OBJECT
+public:
+    static ConnectionSummaryCache *instance();
+
+    /**
+     * Returns the summary of the given connection, an invalid one when there is no such connection
+     */
+    ConnectionSummary summary(const QString &path);
+
+    /**
+     * Returns summaries of all the saved connections
+     */
+    QList<ConnectionSummary> summaries();
+
+Q_SIGNALS:
+    /**
+     * Emitted once the summary of an updated connection is decoded again
+     */
+    void summaryChanged(const QString &path);
+
+private Q_SLOTS:
+    void connectionRemoved(const QString &path);
+    void connectionUpdated(const QDBusMessage &message);
+
+private:
+    explicit ConnectionSummaryCache(QObject *parent = nullptr);
+    ~ConnectionSummaryCache() override;
+
+    /**
+     * Decodes only the keys the summary consists of
+     */
+    static ConnectionSummary decode(const QString &path, const NMVariantMapMap &settings);
+
+    QHash<QString, ConnectionSummary> m_summaries;
+};
+
+#endif // PLASMA_NM_CONNECTION_SUMMARY_CACHE_H
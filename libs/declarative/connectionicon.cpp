@@ -20,6 +20,7 @@
 
 #include "connectionicon.h"
 #include "configuration.h"
+#include "tracespans.h"
 #include "uiutils.h"
 
 #include <NetworkManagerQt/BluetoothDevice>
@@ -299,6 +300,7 @@ void ConnectionIcon::setStates()
 
 void ConnectionIcon::setIcons()
 {
+    TRACE_SPAN("ConnectionIcon::setIcons");
     m_signal = 0;
 #if WITH_MODEMMANAGER_SUPPORT
     if (m_modemNetwork) {
@@ -34,12 +34,16 @@
 #include "kcmidentitymodel.h"
 #include "networkmodel.h"
 #include "mobileproxymodel.h"
+#include "tracespans.h"
 
 #include "handler.h"
 #include "enums.h"
 
 void QmlPlugins::registerTypes(const char* uri)
 {
+    // Exports the span recording on the bus right away, not with the first span
+    TraceSpans::instance();
+
     // @uri org.kde.plasma.networkmanagement.AvailableDevices
     qmlRegisterType<AvailableDevices>(uri, 0, 2, "AvailableDevices");
     // @uri org.kde.plasma.networkmanagement.ConnectionIcon
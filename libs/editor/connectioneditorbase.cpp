@@ -22,6 +22,7 @@
 #include "connectioneditorbase.h"
 
 #include "debug.h"
+#include "tracespans.h"
 #include "settings/bondwidget.h"
 #include "settings/bridgewidget.h"
 #include "settings/btwidget.h"
@@ -197,6 +198,7 @@ void ConnectionEditorBase::addSettingWidget(SettingWidget *widget, const QString
 
 void ConnectionEditorBase::initialize()
 {
+    TRACE_SPAN("ConnectionEditorBase::initialize");
     const bool emptyConnection = m_connection->id().isEmpty();
     const NetworkManager::ConnectionSettings::ConnectionType type = m_connection->connectionType();
 
@@ -21,6 +21,8 @@
 #include "handler.h"
 #include "connectioneditordialog.h"
 #include "configuration.h"
+#include "perfcounters.h"
+#include "scanscheduler.h"
 #include "uiutils.h"
 #include "debug.h"
 
@@ -60,9 +62,6 @@
 #define AGENT_PATH "/modules/networkmanagement"
 #define AGENT_IFACE "org.kde.plasmanetworkmanagement"
 
-// 10 seconds
-#define NM_REQUESTSCAN_LIMIT_RATE 10000
-
 Handler::Handler(QObject *parent)
     : QObject(parent)
     , m_tmpWirelessEnabled(NetworkManager::isWirelessEnabled())
@@ -496,48 +495,31 @@ void Handler::updateConnection(const NetworkManager::Connection::Ptr& connection
 
 void Handler::requestScan(const QString &interface)
 {
-    for (NetworkManager::Device::Ptr device : NetworkManager::networkInterfaces()) {
-        if (device->type() == NetworkManager::Device::Wifi) {
-            NetworkManager::WirelessDevice::Ptr wifiDevice = device.objectCast<NetworkManager::WirelessDevice>();
+    PerfCounters::instance()->increment(PerfCounters::ScansRequested);
+    ScanScheduler::instance()->scanNow(interface);
+}
 
-            if (wifiDevice && wifiDevice->state() != NetworkManager::WirelessDevice::Unavailable) {
-                if (!interface.isEmpty() && interface != wifiDevice->interfaceName()) {
-                    continue;
-                }
+bool Handler::periodicScanning() const
+{
+    return ScanScheduler::instance()->isInterested(const_cast<Handler*>(this));
+}
 
-                if (!checkRequestScanRateLimit(wifiDevice)) {
-                    QDateTime now = QDateTime::currentDateTime();
-                    // for NM < 1.12, lastScan is not available
-                    QDateTime lastScan = wifiDevice->lastScan();
-                    QDateTime lastRequestScan = wifiDevice->lastRequestScan();
-                    // Compute the next time we can run a scan
-                    int timeout = NM_REQUESTSCAN_LIMIT_RATE;
-                    if (lastScan.isValid() && lastScan.msecsTo(now) < NM_REQUESTSCAN_LIMIT_RATE) {
-                        timeout = NM_REQUESTSCAN_LIMIT_RATE - lastScan.msecsTo(now);
-                    } else if (lastRequestScan.isValid() && lastRequestScan.msecsTo(now) < NM_REQUESTSCAN_LIMIT_RATE) {
-                        timeout = NM_REQUESTSCAN_LIMIT_RATE - lastRequestScan.msecsTo(now);
-                    }
-                    qCDebug(PLASMA_NM) << "Rescheduling a request scan for" << wifiDevice->interfaceName() << "in" << timeout;
-                    scheduleRequestScan(wifiDevice->interfaceName(), timeout);
+void Handler::setPeriodicScanning(bool enabled)
+{
+    if (enabled != periodicScanning()) {
+        ScanScheduler::instance()->setInterested(this, enabled);
+        Q_EMIT periodicScanningChanged(enabled);
+    }
+}
 
-                    if (!interface.isEmpty()) {
-                        return;
-                    }
-                    continue;
-                } else if (m_wirelessScanRetryTimer.contains(interface)){
-                    m_wirelessScanRetryTimer.value(interface)->stop();
-                    delete m_wirelessScanRetryTimer.take(interface);
-                }
+QVariantList Handler::scanSchedule() const
+{
+    return ScanScheduler::instance()->schedule();
+}
 
-                qCDebug(PLASMA_NM) << "Requesting wifi scan on device" << wifiDevice->interfaceName();
-                QDBusPendingReply<> reply = wifiDevice->requestScan();
-                QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(reply, this);
-                watcher->setProperty("action", Handler::RequestScan);
-                watcher->setProperty("interface", wifiDevice->interfaceName());
-                connect(watcher, &QDBusPendingCallWatcher::finished, this, &Handler::replyFinished);
-            }
-        }
-    }
+QVariantMap Handler::performanceCounters() const
+{
+    return PerfCounters::instance()->snapshot();
 }
 
 void Handler::createHotspot()
@@ -644,25 +626,6 @@ void Handler::stopHotspot()
     Q_EMIT hotspotDisabled();
 }
 
-bool Handler::checkRequestScanRateLimit(const NetworkManager::WirelessDevice::Ptr &wifiDevice)
-{
-    QDateTime now = QDateTime::currentDateTime();
-    QDateTime lastScan = wifiDevice->lastScan();
-    QDateTime lastRequestScan = wifiDevice->lastRequestScan();
-
-    // if the last scan finished within the last 10 seconds
-    bool ret = lastScan.isValid() && lastScan.msecsTo(now) < NM_REQUESTSCAN_LIMIT_RATE;
-    // or if the last Request was sent within the last 10 seconds
-    ret |= lastRequestScan.isValid() && lastRequestScan.msecsTo(now) < NM_REQUESTSCAN_LIMIT_RATE;
-    // skip the request scan
-    if (ret) {
-        qCDebug(PLASMA_NM) << "Last scan finished " << lastScan.msecsTo(now) << "ms ago and last request scan was sent "
-                           << lastRequestScan.msecsTo(now) << "ms ago, Skipping scanning interface:" << wifiDevice->interfaceName();
-        return false;
-    }
-    return true;
-}
-
 bool Handler::checkHotspotSupported()
 {
     if (NetworkManager::checkVersion(1, 16, 0)) {
@@ -698,37 +661,6 @@ bool Handler::checkHotspotSupported()
     return false;
 }
 
-void Handler::scheduleRequestScan(const QString &interface, int timeout)
-{
-    QTimer *timer;
-    if (!m_wirelessScanRetryTimer.contains(interface)) {
-        // create a timer for the interface
-        timer = new QTimer();
-        timer->setSingleShot(true);
-        m_wirelessScanRetryTimer.insert(interface, timer);
-        auto retryAction = [this, interface]() {
-            requestScan(interface);
-        };
-        connect(timer, &QTimer::timeout, this, retryAction);
-    } else {
-        // set the new value for an existing timer
-        timer = m_wirelessScanRetryTimer.value(interface);
-        if (timer->isActive()) {
-            timer->stop();
-        }
-    }
-
-    // +1 ms is added to avoid having the scan being rejetted by nm
-    // because it is run at the exact last millisecond of the requestScan threshold
-    timer->setInterval(timeout + 1);
-    timer->start();
-}
-
-void Handler::scanRequestFailed(const QString &interface)
-{
-    scheduleRequestScan(interface, 2000);
-}
-
 void Handler::secretAgentError(const QString &connectionPath, const QString &message)
 {
     // If the password was wrong, forget it
@@ -768,13 +700,6 @@ void Handler::replyFinished(QDBusPendingCallWatcher * watcher)
                 notification = new KNotification("FailedToUpdateConnection", KNotification::CloseOnTimeout, this);
                 notification->setTitle(i18n("Failed to update connection %1", watcher->property("connection").toString()));
                 break;
-            case Handler::RequestScan:
-            {
-                const QString interface = watcher->property("interface").toString();
-                qCWarning(PLASMA_NM) << "Wireless scan on" << interface << "failed:" << error;
-                scanRequestFailed(interface);
-                break;
-            }
             case Handler::CreateHotspot:
                 notification = new KNotification("FailedToCreateHotspot", KNotification::CloseOnTimeout, this);
                 notification->setTitle(i18n("Failed to create hotspot %1", watcher->property("connection").toString()));
@@ -806,9 +731,6 @@ void Handler::replyFinished(QDBusPendingCallWatcher * watcher)
                 notification = new KNotification("ConnectionUpdated", KNotification::CloseOnTimeout, this);
                 notification->setText(i18n("Connection %1 has been updated", watcher->property("connection").toString()));
                 break;
-            case Handler::RequestScan:
-                qCDebug(PLASMA_NM) << "Wireless scan on" << watcher->property("interface").toString() << "succeeded";
-                break;
             default:
                 break;
         }
@@ -53,9 +53,17 @@ public:
     ~Handler() override;
 
     Q_PROPERTY(bool hotspotSupported READ hotspotSupported NOTIFY hotspotSupportedChanged);
+    /**
+     * Whether wireless networks should be scanned periodically for this handler, the schedule is shared with
+     * all the other handlers in the process
+     */
+    Q_PROPERTY(bool periodicScanning READ periodicScanning WRITE setPeriodicScanning NOTIFY periodicScanningChanged);
 public:
     bool hotspotSupported() const { return m_hotspotSupported; };
 
+    bool periodicScanning() const;
+    void setPeriodicScanning(bool enabled);
+
 public Q_SLOTS:
     /**
      * Activates given connection
@@ -119,7 +127,18 @@ public Q_SLOTS:
      * @map - NMVariantMapMap with new connection settings
      */
     void updateConnection(const NetworkManager::Connection::Ptr &connection, const NMVariantMapMap &map);
+    /**
+     * Scans the given interface, or all of them, as soon as possible, e.g. when the list of networks is shown
+     */
     void requestScan(const QString &interface = QString());
+    /**
+     * Current scanning decisions for all wireless interfaces, see ScanScheduler::schedule()
+     */
+    QVariantList scanSchedule() const;
+    /**
+     * Counters and histograms of the work done in this process, see PerfCounters::snapshot()
+     */
+    QVariantMap performanceCounters() const;
 
     void createHotspot();
     void stopHotspot();
@@ -138,6 +157,7 @@ Q_SIGNALS:
     void hotspotCreated();
     void hotspotDisabled();
     void hotspotSupportedChanged(bool hotspotSupported);
+    void periodicScanningChanged(bool periodicScanning);
 private:
     bool m_hotspotSupported;
     bool m_tmpWirelessEnabled;
@@ -149,13 +169,9 @@ private:
     QString m_tmpDevicePath;
     QString m_tmpSpecificPath;
     QMap<QString, bool> m_bluetoothAdapters;
-    QMap<QString, QTimer*> m_wirelessScanRetryTimer;
 
     void enableBluetooth(bool enable);
-    void scanRequestFailed(const QString &interface);
-    bool checkRequestScanRateLimit(const NetworkManager::WirelessDevice::Ptr &wifiDevice);
     bool checkHotspotSupported();
-    void scheduleRequestScan(const QString &interface, int timeout);
 };
 
 #endif // PLASMA_NM_HANDLER_H
@@ -20,37 +20,205 @@
 
 #include "appletproxymodel.h"
 #include "networkmodel.h"
+#include "perfcounters.h"
+#include "tracespans.h"
 #include "uiutils.h"
 
+#include <QSet>
+
+#include <algorithm>
+#include <functional>
+
 AppletProxyModel::AppletProxyModel(QObject *parent)
-    : QSortFilterProxyModel(parent)
+    : QAbstractProxyModel(parent)
+    , m_filterRegExp(QString(), Qt::CaseInsensitive)
+    , m_networkModel(nullptr)
+    , m_sortingFrozen(false)
 {
-    setDynamicSortFilter(true);
-    setFilterCaseSensitivity(Qt::CaseInsensitive);
-    sort(0, Qt::DescendingOrder);
 }
 
 AppletProxyModel::~AppletProxyModel()
 {
 }
 
+QModelIndex AppletProxyModel::index(int row, int column, const QModelIndex &parent) const
+{
+    if (parent.isValid() || column != 0 || row < 0 || row >= m_proxyToSource.count()) {
+        return QModelIndex();
+    }
+
+    return createIndex(row, column);
+}
+
+QModelIndex AppletProxyModel::parent(const QModelIndex &child) const
+{
+    Q_UNUSED(child);
+    return QModelIndex();
+}
+
+int AppletProxyModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_proxyToSource.count();
+}
+
+int AppletProxyModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : 1;
+}
+
+QModelIndex AppletProxyModel::mapFromSource(const QModelIndex &sourceIndex) const
+{
+    if (!sourceIndex.isValid() || sourceIndex.row() >= m_sourceToProxy.count()) {
+        return QModelIndex();
+    }
+
+    const int proxyRow = m_sourceToProxy.at(sourceIndex.row());
+    if (proxyRow < 0) {
+        return QModelIndex();
+    }
+
+    return createIndex(proxyRow, sourceIndex.column());
+}
+
+QModelIndex AppletProxyModel::mapToSource(const QModelIndex &proxyIndex) const
+{
+    if (!sourceModel() || !proxyIndex.isValid() || proxyIndex.row() >= m_proxyToSource.count()) {
+        return QModelIndex();
+    }
+
+    return sourceModel()->index(m_proxyToSource.at(proxyIndex.row()), proxyIndex.column());
+}
+
+void AppletProxyModel::setSourceModel(QAbstractItemModel *sourceModel)
+{
+    if (sourceModel == this->sourceModel()) {
+        return;
+    }
+
+    if (this->sourceModel()) {
+        disconnect(this->sourceModel(), &QAbstractItemModel::dataChanged, this, &AppletProxyModel::sourceDataChanged);
+        disconnect(this->sourceModel(), &QAbstractItemModel::modelAboutToBeReset, this, &AppletProxyModel::sourceModelAboutToBeReset);
+        disconnect(this->sourceModel(), &QAbstractItemModel::modelReset, this, &AppletProxyModel::sourceModelReset);
+        disconnect(this->sourceModel(), &QAbstractItemModel::layoutAboutToBeChanged, this, &AppletProxyModel::sourceModelAboutToBeReset);
+        disconnect(this->sourceModel(), &QAbstractItemModel::layoutChanged, this, &AppletProxyModel::sourceModelReset);
+        disconnect(this->sourceModel(), &QAbstractItemModel::rowsInserted, this, &AppletProxyModel::sourceRowsInserted);
+        disconnect(this->sourceModel(), &QAbstractItemModel::rowsAboutToBeRemoved, this, &AppletProxyModel::sourceRowsAboutToBeRemoved);
+        disconnect(this->sourceModel(), &QAbstractItemModel::rowsRemoved, this, &AppletProxyModel::sourceRowsRemoved);
+    }
+
+    beginResetModel();
+    QAbstractProxyModel::setSourceModel(sourceModel);
+    m_networkModel = qobject_cast<NetworkModel*>(sourceModel);
+    buildMapping();
+    endResetModel();
+
+    if (sourceModel) {
+        connect(sourceModel, &QAbstractItemModel::dataChanged, this, &AppletProxyModel::sourceDataChanged);
+        connect(sourceModel, &QAbstractItemModel::modelAboutToBeReset, this, &AppletProxyModel::sourceModelAboutToBeReset);
+        connect(sourceModel, &QAbstractItemModel::modelReset, this, &AppletProxyModel::sourceModelReset);
+        // NetworkModel doesn't change its layout, so we don't need to care about preserving anything here
+        connect(sourceModel, &QAbstractItemModel::layoutAboutToBeChanged, this, &AppletProxyModel::sourceModelAboutToBeReset);
+        connect(sourceModel, &QAbstractItemModel::layoutChanged, this, &AppletProxyModel::sourceModelReset);
+        connect(sourceModel, &QAbstractItemModel::rowsInserted, this, &AppletProxyModel::sourceRowsInserted);
+        connect(sourceModel, &QAbstractItemModel::rowsAboutToBeRemoved, this, &AppletProxyModel::sourceRowsAboutToBeRemoved);
+        connect(sourceModel, &QAbstractItemModel::rowsRemoved, this, &AppletProxyModel::sourceRowsRemoved);
+    }
+}
+
+QRegExp AppletProxyModel::filterRegExp() const
+{
+    return m_filterRegExp;
+}
+
+void AppletProxyModel::setFilterRegExp(const QString &pattern)
+{
+    TRACE_SPAN("AppletProxyModel::setFilterRegExp");
+    if (m_filterRegExp.pattern() == pattern) {
+        return;
+    }
+
+    m_filterRegExp.setPattern(pattern);
+
+    if (!sourceModel()) {
+        return;
+    }
+
+    for (int proxyRow = m_proxyToSource.count() - 1; proxyRow >= 0; --proxyRow) {
+        if (!filterAcceptsRow(m_proxyToSource.at(proxyRow), QModelIndex())) {
+            removeProxyRow(proxyRow);
+        }
+    }
+
+    for (int sourceRow = 0; sourceRow < m_sourceToProxy.count(); ++sourceRow) {
+        if (m_sourceToProxy.at(sourceRow) < 0 && filterAcceptsRow(sourceRow, QModelIndex())) {
+            insertSourceRow(sourceRow);
+        }
+    }
+}
+
+bool AppletProxyModel::sortingFrozen() const
+{
+    return m_sortingFrozen;
+}
+
+void AppletProxyModel::setSortingFrozen(bool frozen)
+{
+    if (m_sortingFrozen == frozen) {
+        return;
+    }
+
+    m_sortingFrozen = frozen;
+
+    if (!frozen && sourceModel()) {
+        // Catch up with the changes which were held back while frozen
+        for (int proxyRow = m_proxyToSource.count() - 1; proxyRow >= 0; --proxyRow) {
+            if (!filterAcceptsRow(m_proxyToSource.at(proxyRow), QModelIndex())) {
+                removeProxyRow(proxyRow);
+            }
+        }
+
+        if (!m_proxyToSource.isEmpty()) {
+            const QVector<int> mappedRows = m_proxyToSource;
+            resort(mappedRows);
+        }
+
+        for (int sourceRow = 0; sourceRow < m_sourceToProxy.count(); ++sourceRow) {
+            if (m_sourceToProxy.at(sourceRow) < 0 && filterAcceptsRow(sourceRow, QModelIndex())) {
+                insertSourceRow(sourceRow);
+            }
+        }
+    }
+
+    Q_EMIT sortingFrozenChanged();
+}
+
 bool AppletProxyModel::filterAcceptsRow(int source_row, const QModelIndex &source_parent) const
 {
     const QModelIndex index = sourceModel()->index(source_row, 0, source_parent);
 
+    bool isSlave;
+    NetworkManager::ConnectionSettings::ConnectionType type;
+    NetworkModelItem::ItemType itemType;
+    if (m_networkModel) {
+        const NetworkModelItem *item = m_networkModel->itemAt(source_row);
+        isSlave = item->slave();
+        type = item->type();
+        itemType = item->itemType();
+    } else {
+        isSlave = sourceModel()->data(index, NetworkModel::SlaveRole).toBool();
+        type = (NetworkManager::ConnectionSettings::ConnectionType) sourceModel()->data(index, NetworkModel::TypeRole).toUInt();
+        itemType = (NetworkModelItem::ItemType) sourceModel()->data(index, NetworkModel::ItemTypeRole).toUInt();
+    }
+
     // slaves are filtered-out when not searching for a connection (makes the state of search results clear)
-    const bool isSlave = sourceModel()->data(index, NetworkModel::SlaveRole).toBool();
     if (isSlave && filterRegExp().isEmpty()) {
         return false;
     }
 
-    const NetworkManager::ConnectionSettings::ConnectionType type = (NetworkManager::ConnectionSettings::ConnectionType) sourceModel()->data(index, NetworkModel::TypeRole).toUInt();
     if (!UiUtils::isConnectionTypeSupported(type)) {
         return false;
     }
 
-    NetworkModelItem::ItemType itemType = (NetworkModelItem::ItemType)sourceModel()->data(index, NetworkModel::ItemTypeRole).toUInt();
-
     if (itemType != NetworkModelItem::AvailableConnection &&
         itemType != NetworkModelItem::AvailableAccessPoint) {
         return false;
@@ -60,74 +228,257 @@ bool AppletProxyModel::filterAcceptsRow(int source_row, const QModelIndex &sourc
         return true;
     }
 
+    if (m_networkModel) {
+        return m_networkModel->internedString(m_networkModel->columns().uniqueNames.at(source_row)).contains(filterRegExp());
+    }
+
     return sourceModel()->data(index, NetworkModel::ItemUniqueNameRole).toString().contains(filterRegExp());
 }
 
 bool AppletProxyModel::lessThan(const QModelIndex &left, const QModelIndex &right) const
 {
-    const bool leftAvailable = (NetworkModelItem::ItemType)sourceModel()->data(left, NetworkModel::ItemTypeRole).toUInt() != NetworkModelItem::UnavailableConnection;
-    const bool leftConnected = sourceModel()->data(left, NetworkModel::ConnectionStateRole).toUInt() == NetworkManager::ActiveConnection::Activated;
-    const int leftConnectionState = sourceModel()->data(left, NetworkModel::ConnectionStateRole).toUInt();
-    const QString leftName = sourceModel()->data(left, NetworkModel::NameRole).toString();
-    const UiUtils::SortedConnectionType leftType = UiUtils::connectionTypeToSortedType((NetworkManager::ConnectionSettings::ConnectionType) sourceModel()->data(left, NetworkModel::TypeRole).toUInt());
-    const QString leftUuid = sourceModel()->data(left, NetworkModel::UuidRole).toString();
-    const int leftSignal = sourceModel()->data(left, NetworkModel::SignalRole).toInt();
-    const QDateTime leftDate = sourceModel()->data(left, NetworkModel::TimeStampRole).toDateTime();
-
-    const bool rightAvailable = (NetworkModelItem::ItemType)sourceModel()->data(right, NetworkModel::ItemTypeRole).toUInt() != NetworkModelItem::UnavailableConnection;
-    const bool rightConnected = sourceModel()->data(right, NetworkModel::ConnectionStateRole).toUInt() == NetworkManager::ActiveConnection::Activated;
-    const int rightConnectionState = sourceModel()->data(right, NetworkModel::ConnectionStateRole).toUInt();
-    const QString rightName = sourceModel()->data(right, NetworkModel::NameRole).toString();
-    const UiUtils::SortedConnectionType rightType = UiUtils::connectionTypeToSortedType((NetworkManager::ConnectionSettings::ConnectionType) sourceModel()->data(right, NetworkModel::TypeRole).toUInt());
-    const QString rightUuid = sourceModel()->data(right, NetworkModel::UuidRole).toString();
-    const int rightSignal = sourceModel()->data(right, NetworkModel::SignalRole).toInt();
-    const QDateTime rightDate = sourceModel()->data(right, NetworkModel::TimeStampRole).toDateTime();
-
-    if (leftAvailable < rightAvailable) {
-        return true;
-    } else if (leftAvailable > rightAvailable) {
-        return false;
+    // Only NetworkModel provides sort keys, rows of other models keep their order
+    if (!m_networkModel) {
+        return right.row() < left.row();
     }
 
-    if (leftConnected < rightConnected) {
-        return true;
-    } else if (leftConnected > rightConnected) {
-        return false;
+    // Availability, connection state, uuid, type, timestamp and signal strength are packed in this order,
+    // names are needed only when everything else is equal
+    const quint64 leftKey = m_networkModel->columns().appletKeys.at(left.row());
+    const quint64 rightKey = m_networkModel->columns().appletKeys.at(right.row());
+    if (leftKey != rightKey) {
+        return leftKey < rightKey;
     }
 
-    if (leftConnectionState > rightConnectionState) {
-        return true;
-    } else if (leftConnectionState < rightConnectionState) {
-        return false;
+    return m_networkModel->compareNames(left.row(), right.row()) > 0;
+}
+
+void AppletProxyModel::sourceDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight, const QVector<int> &roles)
+{
+    TRACE_SPAN("AppletProxyModel::sourceDataChanged");
+    if (!topLeft.isValid() || topLeft.parent().isValid()) {
+        return;
     }
 
-    if (leftUuid.isEmpty() && !rightUuid.isEmpty()) {
-        return true;
-    } else if (!leftUuid.isEmpty() && rightUuid.isEmpty()) {
-        return false;
+    static const QVector<int> filterRoles = { NetworkModel::ItemTypeRole, NetworkModel::ItemUniqueNameRole, NetworkModel::SlaveRole, NetworkModel::TypeRole };
+    // While frozen rows stay where they are, setSortingFrozen(false) puts them in place afterwards
+    const bool filterAffected = !m_sortingFrozen && (roles.isEmpty() || std::any_of(roles.cbegin(), roles.cend(), [] (int role) { return filterRoles.contains(role); }));
+    const bool orderAffected = !m_sortingFrozen && (roles.isEmpty() || roles.contains(NetworkModel::SortKeyRole));
+
+    QVector<int> acceptedRows;
+    QVector<int> rejectedProxyRows;
+    QVector<int> changedRows;
+
+    for (int sourceRow = topLeft.row(); sourceRow <= bottomRight.row(); ++sourceRow) {
+        const bool mapped = m_sourceToProxy.at(sourceRow) >= 0;
+        const bool accepted = filterAffected ? filterAcceptsRow(sourceRow, QModelIndex()) : mapped;
+
+        if (!mapped && accepted) {
+            acceptedRows << sourceRow;
+        } else if (mapped && !accepted) {
+            rejectedProxyRows << m_sourceToProxy.at(sourceRow);
+        } else if (mapped) {
+            changedRows << sourceRow;
+        }
     }
 
-    if (leftType < rightType) {
-        return false;
-    } else if (leftType > rightType) {
-        return true;
+    std::sort(rejectedProxyRows.begin(), rejectedProxyRows.end(), std::greater<int>());
+    for (int proxyRow : qAsConst(rejectedProxyRows)) {
+        removeProxyRow(proxyRow);
     }
 
-    if (leftDate > rightDate) {
-        return false;
-    } else if (leftDate < rightDate) {
-        return true;
+    if (orderAffected && !changedRows.isEmpty()) {
+        resort(changedRows);
     }
 
-    if (leftSignal < rightSignal) {
-        return true;
-    } else if (leftSignal > rightSignal) {
-        return false;
+    // Rows are inserted once the rest is in order again, their position is found by binary search
+    for (int sourceRow : qAsConst(acceptedRows)) {
+        insertSourceRow(sourceRow);
     }
 
-    if (QString::localeAwareCompare(leftName, rightName) > 0) {
-        return true;
-    } else {
-        return false;
+    for (int sourceRow : qAsConst(changedRows)) {
+        const QModelIndex index = createIndex(m_sourceToProxy.at(sourceRow), 0);
+        Q_EMIT dataChanged(index, index, roles);
+    }
+}
+
+void AppletProxyModel::sourceModelAboutToBeReset()
+{
+    beginResetModel();
+}
+
+void AppletProxyModel::sourceModelReset()
+{
+    buildMapping();
+    endResetModel();
+}
+
+void AppletProxyModel::sourceRowsInserted(const QModelIndex &parent, int first, int last)
+{
+    if (parent.isValid()) {
+        return;
+    }
+
+    const int count = last - first + 1;
+    for (int &sourceRow : m_proxyToSource) {
+        if (sourceRow >= first) {
+            sourceRow += count;
+        }
+    }
+    m_sourceToProxy.insert(first, count, -1);
+
+    for (int sourceRow = first; sourceRow <= last; ++sourceRow) {
+        if (filterAcceptsRow(sourceRow, QModelIndex())) {
+            insertSourceRow(sourceRow);
+        }
+    }
+}
+
+void AppletProxyModel::sourceRowsAboutToBeRemoved(const QModelIndex &parent, int first, int last)
+{
+    if (parent.isValid()) {
+        return;
+    }
+
+    QVector<int> proxyRows;
+    for (int sourceRow = first; sourceRow <= last; ++sourceRow) {
+        if (m_sourceToProxy.at(sourceRow) >= 0) {
+            proxyRows << m_sourceToProxy.at(sourceRow);
+        }
+    }
+
+    std::sort(proxyRows.begin(), proxyRows.end(), std::greater<int>());
+    for (int proxyRow : qAsConst(proxyRows)) {
+        removeProxyRow(proxyRow);
+    }
+}
+
+void AppletProxyModel::sourceRowsRemoved(const QModelIndex &parent, int first, int last)
+{
+    if (parent.isValid()) {
+        return;
+    }
+
+    const int count = last - first + 1;
+    m_sourceToProxy.remove(first, count);
+    for (int &sourceRow : m_proxyToSource) {
+        if (sourceRow > last) {
+            sourceRow -= count;
+        }
+    }
+}
+
+void AppletProxyModel::buildMapping()
+{
+    TRACE_SPAN("AppletProxyModel::buildMapping");
+    m_proxyToSource.clear();
+    m_sourceToProxy.clear();
+
+    if (!sourceModel()) {
+        return;
+    }
+
+    const int sourceRowCount = sourceModel()->rowCount();
+    m_sourceToProxy.fill(-1, sourceRowCount);
+    for (int sourceRow = 0; sourceRow < sourceRowCount; ++sourceRow) {
+        if (filterAcceptsRow(sourceRow, QModelIndex())) {
+            m_proxyToSource << sourceRow;
+        }
+    }
+
+    std::stable_sort(m_proxyToSource.begin(), m_proxyToSource.end(), [this] (int left, int right) { return goesBefore(left, right); });
+    updateMapping(0, m_proxyToSource.count() - 1);
+    PerfCounters::instance()->increment(PerfCounters::ProxySorts);
+}
+
+bool AppletProxyModel::goesBefore(int sourceRow, int otherSourceRow) const
+{
+    // Rows are sorted in descending order
+    return lessThan(sourceModel()->index(otherSourceRow, 0), sourceModel()->index(sourceRow, 0));
+}
+
+void AppletProxyModel::insertSourceRow(int sourceRow)
+{
+    const auto it = std::upper_bound(m_proxyToSource.cbegin(), m_proxyToSource.cend(), sourceRow, [this] (int left, int right) { return goesBefore(left, right); });
+    const int proxyRow = it - m_proxyToSource.cbegin();
+
+    beginInsertRows(QModelIndex(), proxyRow, proxyRow);
+    m_proxyToSource.insert(proxyRow, sourceRow);
+    updateMapping(proxyRow, m_proxyToSource.count() - 1);
+    endInsertRows();
+}
+
+void AppletProxyModel::moveProxyRow(int proxyRow, int destination)
+{
+    // Same meaning of destination as in beginMoveRows()
+    if (destination == proxyRow || destination == proxyRow + 1) {
+        return;
+    }
+
+    const int newProxyRow = destination > proxyRow ? destination - 1 : destination;
+
+    beginMoveRows(QModelIndex(), proxyRow, proxyRow, QModelIndex(), destination);
+    m_proxyToSource.move(proxyRow, newProxyRow);
+    updateMapping(qMin(proxyRow, newProxyRow), qMax(proxyRow, newProxyRow));
+    endMoveRows();
+}
+
+void AppletProxyModel::removeProxyRow(int proxyRow)
+{
+    beginRemoveRows(QModelIndex(), proxyRow, proxyRow);
+    m_sourceToProxy[m_proxyToSource.at(proxyRow)] = -1;
+    m_proxyToSource.remove(proxyRow);
+    updateMapping(proxyRow, m_proxyToSource.count() - 1);
+    endRemoveRows();
+}
+
+void AppletProxyModel::resort(const QVector<int> &sourceRows)
+{
+    const QSet<int> changedRows(sourceRows.cbegin(), sourceRows.cend());
+
+    // A changed row is still in place when its neighbours didn't change and it still fits between them,
+    // this is the usual case for signal strength updates
+    QVector<int> misplacedRows;
+    for (int sourceRow : sourceRows) {
+        const int proxyRow = m_sourceToProxy.at(sourceRow);
+        const int previous = proxyRow > 0 ? m_proxyToSource.at(proxyRow - 1) : -1;
+        const int next = proxyRow + 1 < m_proxyToSource.count() ? m_proxyToSource.at(proxyRow + 1) : -1;
+
+        if ((previous < 0 || (!changedRows.contains(previous) && !goesBefore(sourceRow, previous))) &&
+            (next < 0 || (!changedRows.contains(next) && !goesBefore(next, sourceRow)))) {
+            continue;
+        }
+
+        misplacedRows << sourceRow;
+    }
+
+    if (misplacedRows.isEmpty()) {
+        return;
+    }
+    PerfCounters::instance()->increment(PerfCounters::ProxyResorts, misplacedRows.count());
+
+    // All the other rows are still sorted, so each misplaced row can be moved right in front of the row
+    // which should follow it
+    const QSet<int> misplaced(misplacedRows.cbegin(), misplacedRows.cend());
+    QVector<int> sortedRows;
+    sortedRows.reserve(m_proxyToSource.count());
+    for (int sourceRow : qAsConst(m_proxyToSource)) {
+        if (!misplaced.contains(sourceRow)) {
+            sortedRows << sourceRow;
+        }
+    }
+
+    for (int sourceRow : qAsConst(misplacedRows)) {
+        const auto it = std::upper_bound(sortedRows.begin(), sortedRows.end(), sourceRow, [this] (int left, int right) { return goesBefore(left, right); });
+        const int destination = it != sortedRows.end() ? m_sourceToProxy.at(*it) : m_proxyToSource.count();
+        sortedRows.insert(it, sourceRow);
+        moveProxyRow(m_sourceToProxy.at(sourceRow), destination);
+    }
+}
+
+void AppletProxyModel::updateMapping(int firstProxyRow, int lastProxyRow)
+{
+    for (int proxyRow = firstProxyRow; proxyRow <= lastProxyRow; ++proxyRow) {
+        m_sourceToProxy[m_proxyToSource.at(proxyRow)] = proxyRow;
     }
 }
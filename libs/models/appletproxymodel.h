@@ -21,21 +21,78 @@
 #ifndef PLASMA_NM_APPLET_PROXY_MODEL_H
 #define PLASMA_NM_APPLET_PROXY_MODEL_H
 
-#include <QSortFilterProxyModel>
+#include <QAbstractProxyModel>
+#include <QRegExp>
 
 #include "networkmodelitem.h"
 
-class Q_DECL_EXPORT AppletProxyModel : public QSortFilterProxyModel
+class NetworkModel;
+
+/**
+ * Filters and sorts NetworkModel for the applet.
+ *
+ * Rows are kept in order incrementally: a row whose sort key changed is moved to its new position
+ * found by binary search, changes of other roles are only forwarded.
+ */
+class Q_DECL_EXPORT AppletProxyModel : public QAbstractProxyModel
 {
 Q_OBJECT
-    Q_PROPERTY(QAbstractItemModel * sourceModel READ sourceModel WRITE setSourceModel)
+    /**
+     * While set, changed rows are neither filtered nor moved, e.g. to keep a row in place while
+     * the user types its password. Clearing it re-filters and re-sorts all rows once.
+     */
+    Q_PROPERTY(bool sortingFrozen READ sortingFrozen WRITE setSortingFrozen NOTIFY sortingFrozenChanged)
 public:
     explicit AppletProxyModel(QObject *parent = nullptr);
     ~AppletProxyModel() override;
 
+    QModelIndex index(int row, int column, const QModelIndex &parent = QModelIndex()) const override;
+    QModelIndex parent(const QModelIndex &child) const override;
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+
+    QModelIndex mapFromSource(const QModelIndex &sourceIndex) const override;
+    QModelIndex mapToSource(const QModelIndex &proxyIndex) const override;
+    void setSourceModel(QAbstractItemModel *sourceModel) override;
+
+    QRegExp filterRegExp() const;
+
+    bool sortingFrozen() const;
+    void setSortingFrozen(bool frozen);
+
+public Q_SLOTS:
+    void setFilterRegExp(const QString &pattern);
+
+Q_SIGNALS:
+    void sortingFrozenChanged();
+
 protected:
-    bool filterAcceptsRow(int source_row, const QModelIndex &source_parent) const override;
-    bool lessThan(const QModelIndex &left, const QModelIndex &right) const override;
+    virtual bool filterAcceptsRow(int source_row, const QModelIndex &source_parent) const;
+    virtual bool lessThan(const QModelIndex &left, const QModelIndex &right) const;
+
+private Q_SLOTS:
+    void sourceDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight, const QVector<int> &roles);
+    void sourceModelAboutToBeReset();
+    void sourceModelReset();
+    void sourceRowsInserted(const QModelIndex &parent, int first, int last);
+    void sourceRowsAboutToBeRemoved(const QModelIndex &parent, int first, int last);
+    void sourceRowsRemoved(const QModelIndex &parent, int first, int last);
+
+private:
+    void buildMapping();
+    bool goesBefore(int sourceRow, int otherSourceRow) const;
+    void insertSourceRow(int sourceRow);
+    void moveProxyRow(int proxyRow, int destination);
+    void removeProxyRow(int proxyRow);
+    void resort(const QVector<int> &sourceRows);
+    void updateMapping(int firstProxyRow, int lastProxyRow);
+
+    QRegExp m_filterRegExp;
+    // Set when the source model is a NetworkModel, its columns are then read directly
+    NetworkModel *m_networkModel;
+    bool m_sortingFrozen;
+    QVector<int> m_proxyToSource;
+    QVector<int> m_sourceToProxy;
 };
 
 
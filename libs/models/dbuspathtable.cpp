@@ -0,0 +1,99 @@
+/*
+    Copyright 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "dbuspathtable.h"
+
+DBusPathTable *DBusPathTable::instance()
+{
+    static DBusPathTable table;
+    return &table;
+}
+
+DBusPathTable::DBusPathTable()
+{
+    // Handle 0 is the empty path and is never released
+    m_entries.append(Entry());
+}
+
+DBusPathTable::~DBusPathTable()
+{
+}
+
+DBusPathTable::Handle DBusPathTable::acquire(const QString &path)
+{
+    if (path.isEmpty()) {
+        return 0;
+    }
+
+    Handle handle = m_handles.value(path);
+    if (!handle) {
+        if (m_freeHandles.isEmpty()) {
+            handle = m_entries.count();
+            m_entries.append(Entry());
+        } else {
+            handle = m_freeHandles.takeLast();
+        }
+        m_entries[handle].path = path;
+        m_handles.insert(path, handle);
+    }
+
+    ++m_entries[handle].refs;
+    return handle;
+}
+
+void DBusPathTable::ref(Handle handle)
+{
+    if (handle) {
+        ++m_entries[handle].refs;
+    }
+}
+
+void DBusPathTable::release(Handle handle)
+{
+    if (!handle) {
+        return;
+    }
+
+    Entry &entry = m_entries[handle];
+    if (--entry.refs == 0) {
+        m_handles.remove(entry.path);
+        entry.path.clear();
+        m_freeHandles.append(handle);
+    }
+}
+
+DBusPathTable::Handle DBusPathTable::find(const QString &path) const
+{
+    if (path.isEmpty()) {
+        return 0;
+    }
+
+    return m_handles.value(path);
+}
+
+QString DBusPathTable::path(Handle handle) const
+{
+    return m_entries.at(handle).path;
+}
+
+int DBusPathTable::count() const
+{
+    return m_handles.count();
+}
@@ -0,0 +1,77 @@
+/*
+    Copyright 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PLASMA_NM_DBUS_PATH_TABLE_H
+#define PLASMA_NM_DBUS_PATH_TABLE_H
+
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+/**
+ * Interns D-Bus object paths for the whole process. Every path is stored once and identified
+ * by a small integer handle, so items referring to the same object share its path and comparing
+ * paths is an integer comparison. Handles are reference counted and reused once released,
+ * the empty path is always handle 0. Meant to be used from the main thread only.
+ */
+class Q_DECL_EXPORT DBusPathTable
+{
+public:
+    typedef quint32 Handle;
+
+    static DBusPathTable *instance();
+
+    /**
+     * Returns the handle of the path and adds a reference to it
+     */
+    Handle acquire(const QString &path);
+    /**
+     * Adds a reference to an already acquired handle
+     */
+    void ref(Handle handle);
+    void release(Handle handle);
+
+    /**
+     * Returns the handle of the path without referencing it, 0 when the path is empty or not interned,
+     * i.e. no item can refer to it
+     */
+    Handle find(const QString &path) const;
+    QString path(Handle handle) const;
+
+    /**
+     * Number of paths currently interned
+     */
+    int count() const;
+
+private:
+    DBusPathTable();
+    ~DBusPathTable();
+
+    struct Entry {
+        QString path;
+        int refs = 0;
+    };
+
+    QVector<Entry> m_entries;
+    QVector<Handle> m_freeHandles;
+    QHash<QString, Handle> m_handles;
+};
+
+#endif // PLASMA_NM_DBUS_PATH_TABLE_H
@@ -0,0 +1,126 @@
+/*
+    Copyright 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "devicestatisticsbroker.h"
+#include "debug.h"
+
+#include <NetworkManagerQt/Device>
+#include <NetworkManagerQt/DeviceStatistics>
+#include <NetworkManagerQt/Manager>
+
+DeviceStatisticsBroker *DeviceStatisticsBroker::instance()
+{
+    static DeviceStatisticsBroker broker;
+    return &broker;
+}
+
+DeviceStatisticsBroker::DeviceStatisticsBroker(QObject *parent)
+    : QObject(parent)
+{
+}
+
+DeviceStatisticsBroker::~DeviceStatisticsBroker()
+{
+}
+
+void DeviceStatisticsBroker::setRefreshRateMs(QObject *consumer, const QString &devicePath, uint refreshRate)
+{
+    if (!consumer || devicePath.isEmpty()) {
+        return;
+    }
+
+    QHash<QObject*, uint> &requests = m_requests[devicePath];
+    if (refreshRate) {
+        if (requests.value(consumer) == refreshRate) {
+            return;
+        }
+        requests.insert(consumer, refreshRate);
+        connect(consumer, &QObject::destroyed, this, &DeviceStatisticsBroker::consumerDestroyed, Qt::UniqueConnection);
+    } else if (!requests.remove(consumer)) {
+        if (requests.isEmpty()) {
+            m_requests.remove(devicePath);
+        }
+        return;
+    }
+
+    applyRefreshRate(devicePath);
+}
+
+void DeviceStatisticsBroker::release(QObject *consumer)
+{
+    QStringList devices;
+    for (auto it = m_requests.begin(); it != m_requests.end(); ++it) {
+        if (it.value().remove(consumer)) {
+            devices << it.key();
+        }
+    }
+
+    for (const QString &devicePath : qAsConst(devices)) {
+        applyRefreshRate(devicePath);
+    }
+
+    disconnect(consumer, &QObject::destroyed, this, &DeviceStatisticsBroker::consumerDestroyed);
+}
+
+uint DeviceStatisticsBroker::refreshRateMs(const QString &devicePath) const
+{
+    return m_refreshRates.value(devicePath);
+}
+
+void DeviceStatisticsBroker::consumerDestroyed(QObject *consumer)
+{
+    release(consumer);
+}
+
+void DeviceStatisticsBroker::applyRefreshRate(const QString &devicePath)
+{
+    uint refreshRate = 0;
+    const QHash<QObject*, uint> requests = m_requests.value(devicePath);
+    for (uint requested : requests) {
+        if (!refreshRate || requested < refreshRate) {
+            refreshRate = requested;
+        }
+    }
+
+    if (requests.isEmpty()) {
+        m_requests.remove(devicePath);
+    }
+
+    NetworkManager::Device::Ptr device = NetworkManager::findNetworkInterface(devicePath);
+    if (!device) {
+        m_refreshRates.remove(devicePath);
+        return;
+    }
+
+    NetworkManager::DeviceStatistics::Ptr deviceStatistics = device->deviceStatistics();
+    if (refreshRate) {
+        m_refreshRates.insert(devicePath, refreshRate);
+        if (deviceStatistics->refreshRateMs() != refreshRate) {
+            qCDebug(PLASMA_NM) << "Device " << devicePath << ": statistics refresh rate set to " << refreshRate;
+            deviceStatistics->setRefreshRateMs(refreshRate);
+        }
+    } else if (m_refreshRates.contains(devicePath)) {
+        // Leave the statistics running when somebody else has changed the refresh rate meanwhile
+        if (deviceStatistics->refreshRateMs() == m_refreshRates.take(devicePath)) {
+            qCDebug(PLASMA_NM) << "Device " << devicePath << ": statistics turned off";
+            deviceStatistics->setRefreshRateMs(0);
+        }
+    }
+}
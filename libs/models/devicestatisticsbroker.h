@@ -0,0 +1,67 @@
+/*
+    Copyright 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PLASMA_NM_DEVICE_STATISTICS_BROKER_H
+#define PLASMA_NM_DEVICE_STATISTICS_BROKER_H
+
+#include <QHash>
+#include <QObject>
+
+/**
+ * Shares the refresh rate of NetworkManager device statistics between all its consumers
+ * in the process. NetworkManager is programmed with the shortest requested interval and
+ * the statistics are turned off only when no consumer is left.
+ */
+class Q_DECL_EXPORT DeviceStatisticsBroker : public QObject
+{
+Q_OBJECT
+public:
+    static DeviceStatisticsBroker *instance();
+
+    /**
+     * Requests statistics of the given device to be refreshed at least every @p refreshRate
+     * milliseconds, 0 withdraws the request. Requests are released automatically when
+     * the consumer is destroyed.
+     */
+    void setRefreshRateMs(QObject *consumer, const QString &devicePath, uint refreshRate);
+
+    /**
+     * Withdraws all the requests of the given consumer
+     */
+    void release(QObject *consumer);
+
+    uint refreshRateMs(const QString &devicePath) const;
+
+private Q_SLOTS:
+    void consumerDestroyed(QObject *consumer);
+
+private:
+    explicit DeviceStatisticsBroker(QObject *parent = nullptr);
+    ~DeviceStatisticsBroker() override;
+
+    void applyRefreshRate(const QString &devicePath);
+
+    // Requested refresh rates per device and consumer
+    QHash<QString, QHash<QObject*, uint> > m_requests;
+    // Refresh rates we have set on the devices
+    QHash<QString, uint> m_refreshRates;
+};
+
+#endif // PLASMA_NM_DEVICE_STATISTICS_BROKER_H
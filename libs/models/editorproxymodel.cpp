@@ -70,47 +70,31 @@ bool EditorProxyModel::filterAcceptsRow(int source_row, const QModelIndex &sourc
 
 bool EditorProxyModel::lessThan(const QModelIndex &left, const QModelIndex &right) const
 {
-    const bool leftConnected = sourceModel()->data(left, NetworkModel::ConnectionStateRole).toUInt() == NetworkManager::ActiveConnection::Activated;
-    const QString leftName = sourceModel()->data(left, NetworkModel::NameRole).toString();
-    const UiUtils::SortedConnectionType leftType = UiUtils::connectionTypeToSortedType((NetworkManager::ConnectionSettings::ConnectionType) sourceModel()->data(left, NetworkModel::TypeRole).toUInt());
-    const QString leftVpnType = sourceModel()->data(left, NetworkModel::VpnType).toString();
-    const QDateTime leftDate = sourceModel()->data(left, NetworkModel::TimeStampRole).toDateTime();
-
-    const bool rightConnected = sourceModel()->data(right, NetworkModel::ConnectionStateRole).toUInt() == NetworkManager::ActiveConnection::Activated;
-    const QString rightName = sourceModel()->data(right, NetworkModel::NameRole).toString();
-    const UiUtils::SortedConnectionType rightType = UiUtils::connectionTypeToSortedType((NetworkManager::ConnectionSettings::ConnectionType) sourceModel()->data(right, NetworkModel::TypeRole).toUInt());
-    const QString rightVpnType = sourceModel()->data(right, NetworkModel::VpnType).toString();
-    const QDateTime rightDate = sourceModel()->data(right, NetworkModel::TimeStampRole).toDateTime();
-
-    if (leftType < rightType) {
-        return false;
-    } else if (leftType > rightType) {
-        return true;
+    // Only NetworkModel provides sort keys, rows of other models keep their order
+    const NetworkModel *networkModel = qobject_cast<const NetworkModel*>(sourceModel());
+    if (!networkModel) {
+        return right.row() < left.row();
     }
 
-    if (leftType == rightType && leftType == UiUtils::Vpn) {
-        if (QString::localeAwareCompare(leftVpnType, rightVpnType) < 0) {
-            return false;
-        } else if (QString::localeAwareCompare(leftVpnType, rightVpnType) > 0) {
-            return true;
-        }
+    // Type, connection state and timestamp are packed in this order
+    const quint64 leftKey = networkModel->columns().editorKeys.at(left.row());
+    const quint64 rightKey = networkModel->columns().editorKeys.at(right.row());
+    const quint64 leftType = leftKey >> NetworkItemsList::EditorKeyTypeShift;
+    if (leftType != rightKey >> NetworkItemsList::EditorKeyTypeShift) {
+        return leftKey < rightKey;
     }
 
-    if (leftConnected < rightConnected) {
-        return true;
-    } else if (leftConnected > rightConnected) {
-        return false;
+    // VPN connections are grouped by their plugins
+    if (255 - leftType == UiUtils::Vpn) {
+        const int vpnTypeComparison = networkModel->compareVpnTypes(left.row(), right.row());
+        if (vpnTypeComparison != 0) {
+            return vpnTypeComparison > 0;
+        }
     }
 
-    if (leftDate > rightDate) {
-        return false;
-    } else if (leftDate < rightDate) {
-        return true;
+    if (leftKey != rightKey) {
+        return leftKey < rightKey;
     }
 
-    if (QString::localeAwareCompare(leftName, rightName) > 0) {
-        return true;
-    } else {
-        return false;
-    }
+    return networkModel->compareNames(left.row(), right.row()) > 0;
 }
@@ -34,6 +34,25 @@ KcmIdentityModel::KcmIdentityModel(QObject *parent)
     : QIdentityProxyModel(parent)
 {
     NetworkModel *baseModel = new NetworkModel(this);
+
+    // Connected before the source model is set, so the cache follows the rows before the views are told about them
+    connect(baseModel, &QAbstractItemModel::rowsInserted, this, [this] (const QModelIndex &parent, int first, int last) {
+        Q_UNUSED(parent);
+        if (first <= m_rowCache.count()) {
+            m_rowCache.insert(first, last - first + 1, RowData());
+        }
+    });
+    connect(baseModel, &QAbstractItemModel::rowsRemoved, this, [this] (const QModelIndex &parent, int first, int last) {
+        Q_UNUSED(parent);
+        if (first < m_rowCache.count()) {
+            m_rowCache.remove(first, qMin(last, m_rowCache.count() - 1) - first + 1);
+        }
+    });
+    connect(baseModel, &QAbstractItemModel::dataChanged, this, &KcmIdentityModel::sourceDataChanged);
+    connect(baseModel, &QAbstractItemModel::modelReset, this, &KcmIdentityModel::clearRowCache);
+    connect(baseModel, &QAbstractItemModel::layoutChanged, this, &KcmIdentityModel::clearRowCache);
+    connect(baseModel, &QAbstractItemModel::rowsMoved, this, &KcmIdentityModel::clearRowCache);
+
     setSourceModel(baseModel);
 }
 
@@ -66,40 +85,66 @@ QHash<int, QByteArray> KcmIdentityModel::roleNames() const
 
 QVariant KcmIdentityModel::data(const QModelIndex &index, int role) const
 {
-    const QModelIndex sourceIndex = sourceModel()->index(index.row(), 0);
-    NetworkManager::ConnectionSettings::ConnectionType type = static_cast<NetworkManager::ConnectionSettings::ConnectionType>(sourceModel()->data(sourceIndex, NetworkModel::TypeRole).toInt());
+    if (role != KcmConnectionIconRole && role != KcmConnectionTypeRole && role != KcmVpnConnectionExportable) {
+        return sourceModel()->data(index, role);
+    }
 
-    NetworkManager::ConnectionSettings::Ptr settings;
-    NetworkManager::VpnSetting::Ptr vpnSetting ;
-    if (type == NetworkManager::ConnectionSettings::Vpn) {
-        settings = NetworkManager::findConnection(sourceModel()->data(sourceIndex, NetworkModel::ConnectionPathRole).toString())->settings();
-        if (settings) {
-            vpnSetting = settings->setting(NetworkManager::Setting::Vpn).staticCast<NetworkManager::VpnSetting>();
-        }
+    const int row = index.row();
+    if (row < 0 || row >= sourceModel()->rowCount()) {
+        return QVariant();
+    }
+
+    if (m_rowCache.count() < sourceModel()->rowCount()) {
+        m_rowCache.resize(sourceModel()->rowCount());
     }
 
-    QString tooltip;
-    const QString iconName = UiUtils::iconAndTitleForConnectionSettingsType(type, tooltip);
+    RowData &rowData = m_rowCache[row];
+    if (!rowData.valid) {
+        rowData = computeRowData(row);
+    }
 
     if (role == KcmConnectionIconRole) {
-        return iconName;
+        return rowData.icon;
     } else if (role == KcmConnectionTypeRole) {
-        if (type == NetworkManager::ConnectionSettings::Vpn && vpnSetting) {
-            return QString("%1 (%2)").arg(tooltip).arg(vpnSetting->serviceType().section('.', -1));
-        }
-        return tooltip;
-    } else if (role == KcmVpnConnectionExportable) {
-        if (type == NetworkManager::ConnectionSettings::Vpn && vpnSetting) {
-            return (vpnSetting->serviceType().endsWith(QLatin1String("vpnc")) ||
-                    vpnSetting->serviceType().endsWith(QLatin1String("openvpn")) ||
-                    vpnSetting->serviceType().endsWith(QLatin1String("wireguard")));
-        }
-        return false;
+        return rowData.type;
     } else {
-        return sourceModel()->data(index, role);
+        return rowData.exportable;
     }
+}
 
-    return QVariant();
+KcmIdentityModel::RowData KcmIdentityModel::computeRowData(int row) const
+{
+    const QModelIndex sourceIndex = sourceModel()->index(row, 0);
+    NetworkManager::ConnectionSettings::ConnectionType type = static_cast<NetworkManager::ConnectionSettings::ConnectionType>(sourceModel()->data(sourceIndex, NetworkModel::TypeRole).toInt());
+    // The last section of the VPN service type, e.g. openvpn
+    const QString vpnType = type == NetworkManager::ConnectionSettings::Vpn ? sourceModel()->data(sourceIndex, NetworkModel::VpnType).toString() : QString();
+
+    RowData rowData;
+    rowData.valid = true;
+    rowData.icon = UiUtils::iconAndTitleForConnectionSettingsType(type, rowData.type);
+    if (!vpnType.isEmpty()) {
+        rowData.type = QString("%1 (%2)").arg(rowData.type).arg(vpnType);
+        rowData.exportable = vpnType.endsWith(QLatin1String("vpnc")) ||
+                             vpnType.endsWith(QLatin1String("openvpn")) ||
+                             vpnType.endsWith(QLatin1String("wireguard"));
+    }
+    return rowData;
+}
+
+void KcmIdentityModel::sourceDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight, const QVector<int> &roles)
+{
+    if (!roles.isEmpty() && !roles.contains(NetworkModel::TypeRole) && !roles.contains(NetworkModel::VpnType)) {
+        return;
+    }
+
+    for (int row = topLeft.row(); row <= bottomRight.row() && row < m_rowCache.count(); ++row) {
+        m_rowCache[row].valid = false;
+    }
+}
+
+void KcmIdentityModel::clearRowCache()
+{
+    m_rowCache.clear();
 }
 
 QModelIndex KcmIdentityModel::index(int row, int column, const QModelIndex &parent) const
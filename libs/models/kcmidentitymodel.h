@@ -23,6 +23,7 @@
 
 #include <QIdentityProxyModel>
 #include <QModelIndex>
+#include <QVector>
 
 class Q_DECL_EXPORT KcmIdentityModel : public QIdentityProxyModel
 {
@@ -45,6 +46,23 @@ public:
     QModelIndex index(int row, int column, const QModelIndex &parent = QModelIndex()) const override;
 
     QModelIndex mapToSource(const QModelIndex &proxyIndex) const override;
+
+private Q_SLOTS:
+    void sourceDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight, const QVector<int> &roles);
+    void clearRowCache();
+
+private:
+    // Values of the Kcm roles, they depend only on the type of the connection
+    struct RowData {
+        bool valid = false;
+        QString icon;
+        QString type;
+        bool exportable = false;
+    };
+
+    RowData computeRowData(int row) const;
+
+    mutable QVector<RowData> m_rowCache;
 };
 
 #endif // PLASMA_NM_KCM_IDENTITY_MODEL_H
@@ -23,6 +23,7 @@
 #include "mobileproxymodel.h"
 #include "networkmodel.h"
 #include "networkmodelitem.h"
+#include "perfcounters.h"
 #include "uiutils.h"
 
 MobileProxyModel::MobileProxyModel(QObject* parent)
@@ -30,6 +31,10 @@ MobileProxyModel::MobileProxyModel(QObject* parent)
 {
     setDynamicSortFilter(true);
     sort(0, Qt::DescendingOrder);
+
+    connect(this, &QSortFilterProxyModel::layoutChanged, this, [] () {
+        PerfCounters::instance()->increment(PerfCounters::ProxyResorts);
+    });
 }
 
 MobileProxyModel::~MobileProxyModel()
@@ -49,17 +54,21 @@ bool MobileProxyModel::showSavedMode() const{
 bool MobileProxyModel::filterAcceptsRow(int source_row, const QModelIndex& source_parent) const
 {
     const QModelIndex index = sourceModel()->index(source_row, 0, source_parent);
+    const NetworkModel *networkModel = qobject_cast<const NetworkModel*>(sourceModel());
+    const NetworkModelItem *item = networkModel ? networkModel->itemAt(source_row) : nullptr;
 
     // slaves are always filtered-out
-    const bool isSlave = sourceModel()->data(index, NetworkModel::SlaveRole).toBool();
+    const bool isSlave = item ? item->slave() : sourceModel()->data(index, NetworkModel::SlaveRole).toBool();
 
     if (isSlave) {
         return false;
     }
 
-    const NetworkManager::ConnectionSettings::ConnectionType type = (NetworkManager::ConnectionSettings::ConnectionType) sourceModel()->data(index, NetworkModel::TypeRole).toUInt();
+    const NetworkManager::ConnectionSettings::ConnectionType type = item ? item->type()
+                                                                         : (NetworkManager::ConnectionSettings::ConnectionType) sourceModel()->data(index, NetworkModel::TypeRole).toUInt();
     if (type == NetworkManager::ConnectionSettings::Wireless) {
-        NetworkModelItem::ItemType itemType = (NetworkModelItem::ItemType)sourceModel()->data(index, NetworkModel::ItemTypeRole).toUInt(); 
+        NetworkModelItem::ItemType itemType = item ? item->itemType()
+                                                   : (NetworkModelItem::ItemType) sourceModel()->data(index, NetworkModel::ItemTypeRole).toUInt();
         if (showSavedMode()) {
             return itemType == NetworkModelItem::UnavailableConnection;
         } else {
@@ -71,61 +80,19 @@ bool MobileProxyModel::filterAcceptsRow(int source_row, const QModelIndex& sourc
 
 bool MobileProxyModel::lessThan(const QModelIndex& left, const QModelIndex& right) const
 {
-    const bool leftAvailable = (NetworkModelItem::ItemType)sourceModel()->data(left, NetworkModel::ItemTypeRole).toUInt() != NetworkModelItem::UnavailableConnection;
-    const bool leftConnected = sourceModel()->data(left, NetworkModel::ConnectionStateRole).toUInt() == NetworkManager::ActiveConnection::Activated;
-    const int leftConnectionState = sourceModel()->data(left, NetworkModel::ConnectionStateRole).toUInt();
-    const QString leftName = sourceModel()->data(left, NetworkModel::NameRole).toString();
-    const QString leftUuid = sourceModel()->data(left, NetworkModel::UuidRole).toString();
-    const int leftSignal = sourceModel()->data(left, NetworkModel::SignalRole).toInt();
-    const QDateTime leftDate = sourceModel()->data(left, NetworkModel::TimeStampRole).toDateTime();
-
-    const bool rightAvailable = (NetworkModelItem::ItemType)sourceModel()->data(right, NetworkModel::ItemTypeRole).toUInt() != NetworkModelItem::UnavailableConnection;
-    const bool rightConnected = sourceModel()->data(right, NetworkModel::ConnectionStateRole).toUInt() == NetworkManager::ActiveConnection::Activated;
-    const int rightConnectionState = sourceModel()->data(right, NetworkModel::ConnectionStateRole).toUInt();
-    const QString rightName = sourceModel()->data(right, NetworkModel::NameRole).toString();
-    const QString rightUuid = sourceModel()->data(right, NetworkModel::UuidRole).toString();
-    const int rightSignal = sourceModel()->data(right, NetworkModel::SignalRole).toInt();
-    const QDateTime rightDate = sourceModel()->data(right, NetworkModel::TimeStampRole).toDateTime();
-
-    if (leftAvailable < rightAvailable) {
-        return true;
-    } else if (leftAvailable > rightAvailable) {
-        return false;
-    }
-
-    if (leftConnected < rightConnected) {
-        return true;
-    } else if (leftConnected > rightConnected) {
-        return false;
+    // Only NetworkModel provides sort keys, rows of other models keep their order
+    const NetworkModel *networkModel = qobject_cast<const NetworkModel*>(sourceModel());
+    if (!networkModel) {
+        return right.row() < left.row();
     }
 
-    if (leftConnectionState > rightConnectionState) {
-        return true;
-    } else if (leftConnectionState < rightConnectionState) {
-        return false;
+    // Availability, connection state, uuid, timestamp and signal strength are packed in this order,
+    // names are needed only when everything else is equal
+    const quint64 leftKey = networkModel->columns().mobileKeys.at(left.row());
+    const quint64 rightKey = networkModel->columns().mobileKeys.at(right.row());
+    if (leftKey != rightKey) {
+        return leftKey < rightKey;
     }
 
-    if (leftUuid.isEmpty() && !rightUuid.isEmpty()) {
-        return true;
-    } else if (!leftUuid.isEmpty() && rightUuid.isEmpty()) {
-        return false;
-    }
-
-    if (leftDate > rightDate) {
-        return false;
-    } else if (leftDate < rightDate) {
-        return true;
-    }
-
-    if (leftSignal < rightSignal) {
-        return true;
-    } else if (leftSignal > rightSignal) {
-        return false;
-    }
-
-    if (QString::localeAwareCompare(leftName, rightName) > 0) {
-        return true;
-    } else {
-        return false;
-    }
+    return networkModel->compareNames(left.row(), right.row()) > 0;
 }
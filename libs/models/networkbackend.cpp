@@ -0,0 +1,143 @@
+/*
+    Copyright 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "networkbackend.h"
+
+NetworkBackend::NetworkBackend(QObject *parent)
+    : QObject(parent)
+{
+}
+
+NetworkBackend::~NetworkBackend()
+{
+}
+
+// Enums are stored as qint32 so that the traces don't depend on their underlying types
+template<typename T>
+static void readEnum(QDataStream &stream, T &value)
+{
+    qint32 raw;
+    stream >> raw;
+    value = static_cast<T>(raw);
+}
+
+QDataStream &operator<<(QDataStream &stream, const ConnectionSummary &connection)
+{
+    return stream << connection.path << connection.id << connection.uuid << qint32(connection.type)
+                  << connection.timestamp << connection.slave << connection.vpnServiceType
+                  << connection.ssid << connection.bssid << connection.restrictedMacAddress
+                  << qint32(connection.mode) << qint32(connection.securityType)
+                  << connection.bluetoothAddress << qint32(connection.bluetoothProfile);
+}
+
+QDataStream &operator>>(QDataStream &stream, ConnectionSummary &connection)
+{
+    stream >> connection.path >> connection.id >> connection.uuid;
+    readEnum(stream, connection.type);
+    stream >> connection.timestamp >> connection.slave >> connection.vpnServiceType
+           >> connection.ssid >> connection.bssid >> connection.restrictedMacAddress;
+    readEnum(stream, connection.mode);
+    readEnum(stream, connection.securityType);
+    stream >> connection.bluetoothAddress;
+    readEnum(stream, connection.bluetoothProfile);
+    return stream;
+}
+
+QDataStream &operator<<(QDataStream &stream, const BackendDevice &device)
+{
+    return stream << device.path << device.interfaceName << qint32(device.type) << qint32(device.state)
+                  << device.managed << device.hardwareAddress << device.availableConnections
+                  << quint64(device.rxBytes) << quint64(device.txBytes) << qint32(device.signal)
+                  << device.ipV4Address << device.ipV4Gateway << device.ipV4Nameserver
+                  << device.ipV6Address << device.ipV6Nameserver << qint32(device.bitRate)
+                  << device.permanentHardwareAddress << device.bluetoothName << qint32(device.bluetoothCapabilities)
+                  << quint32(device.vlanId) << device.modemOperator << quint32(device.modemAccessTechnologies);
+}
+
+QDataStream &operator>>(QDataStream &stream, BackendDevice &device)
+{
+    quint64 rxBytes, txBytes;
+    qint32 signal, bitRate, bluetoothCapabilities;
+    quint32 vlanId, modemAccessTechnologies;
+    stream >> device.path >> device.interfaceName;
+    readEnum(stream, device.type);
+    readEnum(stream, device.state);
+    stream >> device.managed >> device.hardwareAddress >> device.availableConnections
+           >> rxBytes >> txBytes >> signal
+           >> device.ipV4Address >> device.ipV4Gateway >> device.ipV4Nameserver
+           >> device.ipV6Address >> device.ipV6Nameserver >> bitRate
+           >> device.permanentHardwareAddress >> device.bluetoothName >> bluetoothCapabilities
+           >> vlanId >> device.modemOperator >> modemAccessTechnologies;
+    device.rxBytes = rxBytes;
+    device.txBytes = txBytes;
+    device.signal = signal;
+    device.bitRate = bitRate;
+    device.bluetoothCapabilities = NetworkManager::BluetoothDevice::Capabilities(bluetoothCapabilities);
+    device.vlanId = vlanId;
+    device.modemAccessTechnologies = modemAccessTechnologies;
+    return stream;
+}
+
+QDataStream &operator<<(QDataStream &stream, const BackendActiveConnection &activeConnection)
+{
+    return stream << activeConnection.path << activeConnection.connectionPath << activeConnection.uuid
+                  << activeConnection.devicePath << activeConnection.specificObject << qint32(activeConnection.state)
+                  << activeConnection.vpn << qint32(activeConnection.vpnState) << activeConnection.vpnBanner;
+}
+
+QDataStream &operator>>(QDataStream &stream, BackendActiveConnection &activeConnection)
+{
+    stream >> activeConnection.path >> activeConnection.connectionPath >> activeConnection.uuid
+           >> activeConnection.devicePath >> activeConnection.specificObject;
+    readEnum(stream, activeConnection.state);
+    stream >> activeConnection.vpn;
+    readEnum(stream, activeConnection.vpnState);
+    stream >> activeConnection.vpnBanner;
+    return stream;
+}
+
+QDataStream &operator<<(QDataStream &stream, const BackendAccessPoint &accessPoint)
+{
+    return stream << accessPoint.path << accessPoint.hardwareAddress << qint32(accessPoint.signal);
+}
+
+QDataStream &operator>>(QDataStream &stream, BackendAccessPoint &accessPoint)
+{
+    qint32 signal;
+    stream >> accessPoint.path >> accessPoint.hardwareAddress >> signal;
+    accessPoint.signal = signal;
+    return stream;
+}
+
+QDataStream &operator<<(QDataStream &stream, const BackendWirelessNetwork &network)
+{
+    return stream << network.devicePath << network.ssid << qint32(network.signal) << network.referenceAccessPoint
+                  << network.accessPoints << qint32(network.securityType) << qint32(network.mode);
+}
+
+QDataStream &operator>>(QDataStream &stream, BackendWirelessNetwork &network)
+{
+    qint32 signal;
+    stream >> network.devicePath >> network.ssid >> signal >> network.referenceAccessPoint >> network.accessPoints;
+    network.signal = signal;
+    readEnum(stream, network.securityType);
+    readEnum(stream, network.mode);
+    return stream;
+}
@@ -0,0 +1,229 @@
+/*
+    Copyright 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PLASMA_NM_NETWORK_BACKEND_H
+#define PLASMA_NM_NETWORK_BACKEND_H
+
+#include <QDataStream>
+#include <QObject>
+#include <QStringList>
+
+#include <NetworkManagerQt/ActiveConnection>
+#include <NetworkManagerQt/BluetoothDevice>
+#include <NetworkManagerQt/Device>
+#include <NetworkManagerQt/Manager>
+#include <NetworkManagerQt/Utils>
+#include <NetworkManagerQt/VpnConnection>
+
+#include "connectionsummarycache.h"
+
+/**
+ * State of a network device as seen by NetworkModel
+ */
+class Q_DECL_EXPORT BackendDevice
+{
+public:
+    bool isValid() const { return !path.isEmpty(); }
+
+    QString path;
+    // IP interface name when there is one, the interface name otherwise
+    QString interfaceName;
+    NetworkManager::Device::Type type = NetworkManager::Device::UnknownType;
+    NetworkManager::Device::State state = NetworkManager::Device::UnknownState;
+    bool managed = false;
+    QString hardwareAddress;
+    QStringList availableConnections;
+    qulonglong rxBytes = 0;
+    qulonglong txBytes = 0;
+    // Signal quality of modems
+    int signal = 0;
+
+    // Properties shown only in the details of the items, deviceDetailsChanged() is emitted when they change
+    QString ipV4Address;
+    QString ipV4Gateway;
+    QString ipV4Nameserver;
+    QString ipV6Address;
+    QString ipV6Nameserver;
+    // In kbit/s, wired and wireless devices only
+    int bitRate = 0;
+    QString permanentHardwareAddress;
+    QString bluetoothName;
+    NetworkManager::BluetoothDevice::Capabilities bluetoothCapabilities = NetworkManager::BluetoothDevice::NoCapability;
+    uint vlanId = 0;
+    // Operator name of GSM modems, network id of CDMA modems
+    QString modemOperator;
+    // ModemManager::Modem::AccessTechnologies
+    uint modemAccessTechnologies = 0;
+};
+
+class Q_DECL_EXPORT BackendActiveConnection
+{
+public:
+    bool isValid() const { return !path.isEmpty(); }
+
+    QString path;
+    QString connectionPath;
+    QString uuid;
+    // The first device of the active connection, none for VPN connections
+    QString devicePath;
+    QString specificObject;
+    NetworkManager::ActiveConnection::State state = NetworkManager::ActiveConnection::Unknown;
+    bool vpn = false;
+    NetworkManager::VpnConnection::State vpnState = NetworkManager::VpnConnection::Unknown;
+    QString vpnBanner;
+};
+
+class Q_DECL_EXPORT BackendAccessPoint
+{
+public:
+    QString path;
+    QString hardwareAddress;
+    int signal = 0;
+};
+
+/**
+ * Wireless network of a device, i.e. access points sharing an SSID
+ */
+class Q_DECL_EXPORT BackendWirelessNetwork
+{
+public:
+    bool isValid() const { return !devicePath.isEmpty(); }
+
+    QString devicePath;
+    QString ssid;
+    int signal = 0;
+    BackendAccessPoint referenceAccessPoint;
+    QList<BackendAccessPoint> accessPoints;
+    // Derived from the reference access point and the capabilities of the device
+    NetworkManager::WirelessSecurityType securityType = NetworkManager::UnknownSecurity;
+    NetworkManager::WirelessSetting::NetworkMode mode = NetworkManager::WirelessSetting::Infrastructure;
+};
+
+/**
+ * Source of the state NetworkModel presents. Objects are identified by their D-Bus paths and
+ * returned as values, wireless networks by their device path and SSID. Change signals are
+ * emitted once the new state can be queried.
+ *
+ * NetworkManagerBackend follows NetworkManager on the system bus, TraceBackend replays
+ * a recorded session.
+ */
+class Q_DECL_EXPORT NetworkBackend : public QObject
+{
+Q_OBJECT
+public:
+    explicit NetworkBackend(QObject *parent = nullptr);
+    ~NetworkBackend() override;
+
+    virtual NetworkManager::Status status() const = 0;
+    virtual NetworkManager::Connectivity connectivity() const = 0;
+    /**
+     * Path of the active connection the default route goes through, empty when there is none
+     */
+    virtual QString primaryConnection() const = 0;
+
+    virtual QStringList devices() const = 0;
+    virtual BackendDevice device(const QString &path) const = 0;
+
+    virtual QStringList activeConnections() const = 0;
+    virtual BackendActiveConnection activeConnection(const QString &path) const = 0;
+
+    virtual ConnectionSummary connection(const QString &path) const = 0;
+    /**
+     * Asks for the paths of all the saved connections, they are delivered by connectionsListed()
+     */
+    virtual void listConnections() = 0;
+
+    virtual QStringList wirelessNetworks(const QString &devicePath) const = 0;
+    virtual BackendWirelessNetwork wirelessNetwork(const QString &devicePath, const QString &ssid) const = 0;
+    /**
+     * Returns the network of the device the access point belongs to, an invalid one when there is no such access point
+     */
+    virtual BackendWirelessNetwork wirelessNetworkOfAccessPoint(const QString &devicePath, const QString &accessPoint) const = 0;
+    /**
+     * Requests accessPointSignalChanged() to be emitted for the access point, reference access points
+     * are followed through wirelessNetworkSignalChanged() without this
+     */
+    virtual void watchAccessPoint(const QString &devicePath, const QString &accessPoint) = 0;
+
+    /**
+     * Requests statistics of the device to be refreshed at least every @p refreshRate milliseconds,
+     * 0 withdraws the request. Requests of different consumers are combined, the requests of
+     * @p consumer are dropped once it's destroyed.
+     */
+    virtual void setDeviceStatisticsRefreshRateMs(QObject *consumer, const QString &devicePath, uint refreshRate) = 0;
+    /**
+     * Withdraws all the statistics requests of the given consumer
+     */
+    virtual void releaseDeviceStatistics(QObject *consumer) = 0;
+    /**
+     * Refresh rate of the statistics of the device in effect, 0 when they are turned off
+     */
+    virtual uint deviceStatisticsRefreshRateMs(const QString &devicePath) const = 0;
+
+Q_SIGNALS:
+    void statusChanged(NetworkManager::Status status);
+    void connectivityChanged(NetworkManager::Connectivity connectivity);
+    void primaryConnectionChanged(const QString &path);
+
+    void deviceAdded(const QString &path);
+    void deviceRemoved(const QString &path);
+    void deviceStateChanged(const QString &path, NetworkManager::Device::State state, NetworkManager::Device::State oldState,
+                            NetworkManager::Device::StateChangeReason reason);
+    void deviceInterfaceNameChanged(const QString &path);
+    /**
+     * Properties which are shown only in the details changed, like IP configuration or bit rate
+     */
+    void deviceDetailsChanged(const QString &path);
+    void deviceStatisticsChanged(const QString &path, qulonglong rxBytes, qulonglong txBytes);
+    void deviceSignalChanged(const QString &path, int signal);
+    void availableConnectionAppeared(const QString &devicePath, const QString &connection);
+    void availableConnectionDisappeared(const QString &devicePath, const QString &connection);
+
+    void activeConnectionAdded(const QString &path);
+    void activeConnectionRemoved(const QString &path);
+    void activeConnectionStateChanged(const QString &path, NetworkManager::ActiveConnection::State state);
+    void vpnConnectionStateChanged(const QString &path, NetworkManager::VpnConnection::State state, NetworkManager::VpnConnection::StateChangeReason reason);
+    void vpnConnectionBannerChanged(const QString &path, const QString &banner);
+
+    void connectionAdded(const QString &path);
+    void connectionRemoved(const QString &path);
+    void connectionUpdated(const QString &path);
+    void connectionsListed(const QStringList &paths);
+
+    void wirelessNetworkAppeared(const QString &devicePath, const QString &ssid);
+    void wirelessNetworkDisappeared(const QString &devicePath, const QString &ssid);
+    void wirelessNetworkSignalChanged(const QString &devicePath, const QString &ssid, const QString &referenceAccessPoint, int signal);
+    void wirelessNetworkReferenceAccessPointChanged(const QString &devicePath, const QString &ssid, const QString &accessPoint);
+    void accessPointSignalChanged(const QString &devicePath, const QString &accessPoint, int signal);
+};
+
+// Serialization used by the traces of TraceBackend
+Q_DECL_EXPORT QDataStream &operator<<(QDataStream &stream, const ConnectionSummary &connection);
+Q_DECL_EXPORT QDataStream &operator>>(QDataStream &stream, ConnectionSummary &connection);
+Q_DECL_EXPORT QDataStream &operator<<(QDataStream &stream, const BackendDevice &device);
+Q_DECL_EXPORT QDataStream &operator>>(QDataStream &stream, BackendDevice &device);
+Q_DECL_EXPORT QDataStream &operator<<(QDataStream &stream, const BackendActiveConnection &activeConnection);
+Q_DECL_EXPORT QDataStream &operator>>(QDataStream &stream, BackendActiveConnection &activeConnection);
+Q_DECL_EXPORT QDataStream &operator<<(QDataStream &stream, const BackendAccessPoint &accessPoint);
+Q_DECL_EXPORT QDataStream &operator>>(QDataStream &stream, BackendAccessPoint &accessPoint);
+Q_DECL_EXPORT QDataStream &operator<<(QDataStream &stream, const BackendWirelessNetwork &network);
+Q_DECL_EXPORT QDataStream &operator>>(QDataStream &stream, BackendWirelessNetwork &network);
+
+#endif // PLASMA_NM_NETWORK_BACKEND_H
@@ -20,10 +20,52 @@
 
 #include "networkitemslist.h"
 #include "networkmodelitem.h"
+#include "uiutils.h"
+
+static QString itemValue(const NetworkModelItem *item, const NetworkItemsList::FilterType type)
+{
+    // Paths are compared through their handles, see itemPath()
+    switch (type) {
+        case NetworkItemsList::Name:
+            return item->name();
+        case NetworkItemsList::Ssid:
+            return item->ssid();
+        case NetworkItemsList::Uuid:
+            return item->uuid();
+        default:
+            break;
+    }
+
+    return QString();
+}
+
+static bool isPathType(const NetworkItemsList::FilterType type)
+{
+    return type == NetworkItemsList::ActiveConnection || type == NetworkItemsList::Connection || type == NetworkItemsList::Device;
+}
+
+static DBusPathTable::Handle itemPath(const NetworkModelItem *item, const NetworkItemsList::FilterType type)
+{
+    switch (type) {
+        case NetworkItemsList::ActiveConnection:
+            return item->activeConnectionPathHandle();
+        case NetworkItemsList::Connection:
+            return item->connectionPathHandle();
+        case NetworkItemsList::Device:
+            return item->devicePathHandle();
+        default:
+            break;
+    }
+
+    return 0;
+}
 
 NetworkItemsList::NetworkItemsList(QObject *parent)
     : QObject(parent)
+    , m_collator(QLocale())
 {
+    // Id 0 is the empty string and is never released
+    m_strings.append(InternedString());
 }
 
 NetworkItemsList::~NetworkItemsList()
@@ -33,45 +75,21 @@ NetworkItemsList::~NetworkItemsList()
 
 bool NetworkItemsList::contains(const NetworkItemsList::FilterType type, const QString &parameter) const
 {
-    for (NetworkModelItem *item : m_items) {
-        switch (type) {
-            case NetworkItemsList::ActiveConnection:
-                if (item->activeConnectionPath() == parameter) {
-                    return true;
-                }
-                break;
-            case NetworkItemsList::Connection:
-                if (item->connectionPath() == parameter) {
-                    return true;
-                }
-                break;
-            case NetworkItemsList::Device:
-                if (item->devicePath() == parameter) {
-                    return true;
-                }
-                break;
-            case NetworkItemsList::Name:
-                if (item->name() == parameter) {
-                    return true;
-                }
-                break;
-            case NetworkItemsList::Ssid:
-                if (item->ssid() == parameter) {
-                    return true;
-                }
-                break;
-            case NetworkItemsList::Uuid:
-                if (item->uuid() == parameter) {
-                    return true;
-                }
-                break;
-            case NetworkItemsList::Type:
-                break;
-            default: break;
-        }
+    if (type == NetworkItemsList::Type) {
+        return false;
     }
 
-    return false;
+    if (parameter.isEmpty()) {
+        return !scanItems(type, parameter, QString()).isEmpty();
+    }
+
+    if (isPathType(type)) {
+        // Paths which are not interned are not referenced by any item
+        const DBusPathTable::Handle path = DBusPathTable::instance()->find(parameter);
+        return path && m_pathIndexes[type].contains(path);
+    }
+
+    return m_indexes[type].contains(parameter);
 }
 
 int NetworkItemsList::count() const
@@ -81,12 +99,35 @@ int NetworkItemsList::count() const
 
 int NetworkItemsList::indexOf(NetworkModelItem *item) const
 {
-    return m_items.indexOf(item);
+    if (!item || item->m_itemsList != this) {
+        return -1;
+    }
+
+    return item->m_row;
 }
 
 void NetworkItemsList::insertItem(NetworkModelItem *item)
 {
+    item->m_row = m_items.count();
     m_items << item;
+    item->m_itemsList = this;
+    addToIndexes(item);
+
+    m_columns.uniqueNames.append(0);
+    m_columns.appletKeys.append(0);
+    m_columns.mobileKeys.append(0);
+    m_columns.editorKeys.append(0);
+    m_columns.nameKeys.push_back(m_collator.sortKey(item->name()));
+    m_columns.vpnTypes.append(0);
+    updateColumns(item->m_row, ~NetworkModelItem::roleBit(NetworkModel::NameRole));
+}
+
+void NetworkItemsList::insertItems(const QList<NetworkModelItem*> &items)
+{
+    m_items.reserve(m_items.count() + items.count());
+    for (NetworkModelItem *item : items) {
+        insertItem(item);
+    }
 }
 
 NetworkModelItem *NetworkItemsList::itemAt(int index) const
@@ -99,77 +140,348 @@ QList< NetworkModelItem*> NetworkItemsList::items() const
     return m_items;
 }
 
+int NetworkItemsList::nameCount(const QString &name) const
+{
+    if (name.isEmpty()) {
+        return scanItems(NetworkItemsList::Name, name, QString()).count();
+    }
+
+    return m_indexes[NetworkItemsList::Name].value(name).count();
+}
+
 void NetworkItemsList::removeItem(NetworkModelItem *item)
 {
-    m_items.removeAll(item);
+    const int row = indexOf(item);
+    if (row < 0) {
+        return;
+    }
+
+    removeItems(row, 1);
+}
+
+void NetworkItemsList::removeItems(int row, int count)
+{
+    for (int i = row; i < row + count; ++i) {
+        NetworkModelItem *item = m_items.at(i);
+        removeFromIndexes(item);
+        item->m_itemsList = nullptr;
+        item->m_row = -1;
+        releaseString(m_columns.uniqueNames.at(i));
+        releaseString(m_columns.vpnTypes.at(i));
+    }
+    m_items.erase(m_items.begin() + row, m_items.begin() + row + count);
+    m_columns.uniqueNames.remove(row, count);
+    m_columns.appletKeys.remove(row, count);
+    m_columns.mobileKeys.remove(row, count);
+    m_columns.editorKeys.remove(row, count);
+    m_columns.nameKeys.erase(m_columns.nameKeys.begin() + row, m_columns.nameKeys.begin() + row + count);
+    m_columns.vpnTypes.remove(row, count);
+
+    // Items behind the removed ones moved up
+    for (int i = row; i < m_items.count(); ++i) {
+        m_items.at(i)->m_row = i;
+    }
+}
+
+QString NetworkItemsList::uniqueName(const NetworkModelItem *item) const
+{
+    if (nameCount(item->name()) > 1) {
+        return item->originalName();
+    }
+
+    return item->name();
+}
+
+void NetworkItemsList::updateColumns(int row)
+{
+    updateColumns(row, m_items.at(row)->changedRolesMask());
+}
+
+void NetworkItemsList::updateColumns(int row, quint64 roles)
+{
+    const NetworkModelItem *item = m_items.at(row);
+
+    if (roles & NetworkModelItem::roleBit(NetworkModel::ItemUniqueNameRole)) {
+        // The new name is interned before the old one is released, so an unchanged name keeps its id
+        const quint32 oldUniqueName = m_columns.uniqueNames.at(row);
+        m_columns.uniqueNames[row] = intern(uniqueName(item));
+        releaseString(oldUniqueName);
+    }
+    if (roles & NetworkModelItem::roleBit(NetworkModel::SortKeyRole)) {
+        updateSortKeys(row);
+    }
+
+    // Collation keys are allocated, they are rebuilt only when the name changes
+    if (roles & NetworkModelItem::roleBit(NetworkModel::NameRole)) {
+        m_columns.nameKeys[row] = m_collator.sortKey(item->name());
+    }
+    if (roles & NetworkModelItem::roleBit(NetworkModel::VpnType)) {
+        const quint32 oldVpnType = m_columns.vpnTypes.at(row);
+        m_columns.vpnTypes[row] = intern(item->vpnType());
+        releaseString(oldVpnType);
+    }
+}
+
+void NetworkItemsList::updateSortKeys(int row)
+{
+    const NetworkModelItem *item = m_items.at(row);
+
+    const quint64 available = item->itemType() != NetworkModelItem::UnavailableConnection ? 1 : 0;
+    const quint64 connected = item->connectionState() == NetworkManager::ActiveConnection::Activated ? 1 : 0;
+    // Higher connection states go first, i.e. activating connections before deactivated ones
+    const quint64 state = 7 - qBound(0, static_cast<int>(item->connectionState()), 7);
+    const quint64 hasUuid = item->uuid().isEmpty() ? 0 : 1;
+    // Types which are listed first in UiUtils::SortedConnectionType go first
+    const quint64 type = 255 - static_cast<quint64>(UiUtils::connectionTypeToSortedType(item->type()));
+    // 34 bits are enough for the number of seconds until year 2514
+    const QDateTime timestamp = item->timestamp();
+    const quint64 seconds = timestamp.isValid() ? qBound<qint64>(0, timestamp.toSecsSinceEpoch(), (Q_INT64_C(1) << 34) - 1) : 0;
+    const quint64 signal = qBound(0, item->signal(), 127);
+
+    m_columns.appletKeys[row] = available << 54 | connected << 53 | state << 50 | hasUuid << 49 | type << 41 | seconds << 7 | signal;
+    m_columns.mobileKeys[row] = available << 46 | connected << 45 | state << 42 | hasUuid << 41 | seconds << 7 | signal;
+    m_columns.editorKeys[row] = type << EditorKeyTypeShift | connected << 34 | seconds;
+}
+
+int NetworkItemsList::compareNames(int leftRow, int rightRow) const
+{
+    return m_columns.nameKeys[leftRow].compare(m_columns.nameKeys[rightRow]);
+}
+
+int NetworkItemsList::compareVpnTypes(int leftRow, int rightRow) const
+{
+    const quint32 left = m_columns.vpnTypes.at(leftRow);
+    const quint32 right = m_columns.vpnTypes.at(rightRow);
+    // Few connections are VPNs and they mostly share their plugins, no need to keep collation keys
+    return left == right ? 0 : m_collator.compare(m_strings.at(left).string, m_strings.at(right).string);
+}
+
+bool NetworkItemsList::updateCollator()
+{
+    if (m_collator.locale() == QLocale()) {
+        return false;
+    }
+
+    m_collator = QCollator(QLocale());
+    for (int row = 0; row < m_items.count(); ++row) {
+        m_columns.nameKeys[row] = m_collator.sortKey(m_items.at(row)->name());
+    }
+    return true;
 }
 
 QList< NetworkModelItem*> NetworkItemsList::returnItems(const NetworkItemsList::FilterType type, const QString &parameter, const QString &additionalParameter) const
 {
-    QList<NetworkModelItem*> result;
+    if (type == NetworkItemsList::Type) {
+        return QList<NetworkModelItem*>();
+    }
 
-    for (NetworkModelItem *item : m_items) {
-        switch (type) {
-            case NetworkItemsList::ActiveConnection:
-                if (item->activeConnectionPath() == parameter) {
-                    result << item;
-                }
-                break;
-            case NetworkItemsList::Connection:
-                if (item->connectionPath() == parameter) {
-                    if (additionalParameter.isEmpty()) {
-                        result << item;
-                    } else {
-                        if (item->devicePath() == additionalParameter) {
-                            result << item;
-                        }
-                    }
-                }
-                break;
-            case NetworkItemsList::Device:
-                if (item->devicePath() == parameter) {
-                    result << item;
-                }
-                break;
-            case NetworkItemsList::Name:
-                if (item->name() == parameter) {
-                    result << item;
-                }
-                break;
-            case NetworkItemsList::Ssid:
-                if (item->ssid() == parameter) {
-                    if (additionalParameter.isEmpty()) {
-                        result << item;
-                    } else {
-                        if (item->devicePath() == additionalParameter) {
-                            result << item;
-                        }
-                    }
-                }
-                break;
-            case NetworkItemsList::Uuid:
-                if (item->uuid() == parameter) {
-                    result << item;
-                }
-                break;
-            case NetworkItemsList::Type:
-                break;
+    if (parameter.isEmpty()) {
+        return scanItems(type, parameter, additionalParameter);
+    }
+
+    DBusPathTable *table = DBusPathTable::instance();
+    QList<NetworkModelItem*> items;
+    if (isPathType(type)) {
+        const DBusPathTable::Handle path = table->find(parameter);
+        if (!path) {
+            return items;
         }
+        items = m_pathIndexes[type].value(path);
+    } else {
+        items = m_indexes[type].value(parameter);
+    }
+
+    // The device path is taken into account only for connections and access points
+    if (additionalParameter.isEmpty() || (type != NetworkItemsList::Connection && type != NetworkItemsList::Ssid)) {
+        return items;
     }
 
+    const DBusPathTable::Handle devicePath = table->find(additionalParameter);
+    QList<NetworkModelItem*> result;
+    if (!devicePath) {
+        return result;
+    }
+    for (NetworkModelItem *item : items) {
+        if (item->devicePathHandle() == devicePath) {
+            result << item;
+        }
+    }
     return result;
 }
 
 QList<NetworkModelItem*> NetworkItemsList::returnItems(const NetworkItemsList::FilterType type, NetworkManager::ConnectionSettings::ConnectionType typeParameter) const
 {
+    if (type != NetworkItemsList::Type) {
+        return QList<NetworkModelItem*>();
+    }
+
+    return m_typeIndex.value(typeParameter);
+}
+
+void NetworkItemsList::addToIndexes(NetworkModelItem *item)
+{
+    for (int type = NetworkItemsList::ActiveConnection; type < NetworkItemsList::Name; ++type) {
+        updatePathIndex(item, static_cast<FilterType>(type), 0, itemPath(item, static_cast<FilterType>(type)));
+    }
+
+    for (int type = NetworkItemsList::Name; type < NetworkItemsList::Type; ++type) {
+        updateIndex(item, static_cast<FilterType>(type), QString(), itemValue(item, static_cast<FilterType>(type)));
+    }
+
+    m_typeIndex[item->type()] << item;
+}
+
+void NetworkItemsList::removeFromIndexes(NetworkModelItem *item)
+{
+    for (int type = NetworkItemsList::ActiveConnection; type < NetworkItemsList::Name; ++type) {
+        updatePathIndex(item, static_cast<FilterType>(type), itemPath(item, static_cast<FilterType>(type)), 0);
+    }
+
+    for (int type = NetworkItemsList::Name; type < NetworkItemsList::Type; ++type) {
+        updateIndex(item, static_cast<FilterType>(type), itemValue(item, static_cast<FilterType>(type)), QString());
+    }
+
+    auto it = m_typeIndex.find(item->type());
+    if (it != m_typeIndex.end()) {
+        it->removeOne(item);
+        if (it->isEmpty()) {
+            m_typeIndex.erase(it);
+        }
+    }
+}
+
+void NetworkItemsList::updateIndex(NetworkModelItem *item, const NetworkItemsList::FilterType type, const QString &oldValue, const QString &newValue)
+{
+    QHash<QString, QList<NetworkModelItem*>> &index = m_indexes[type];
+    NetworkModelItem *uniqueNameChangedItem = nullptr;
+
+    if (!oldValue.isEmpty()) {
+        auto it = index.find(oldValue);
+        if (it != index.end()) {
+            it->removeOne(item);
+            if (it->isEmpty()) {
+                index.erase(it);
+            } else if (type == NetworkItemsList::Name && it->count() == 1) {
+                // The remaining item doesn't need to be distinguished by its device name anymore
+                uniqueNameChangedItem = it->first();
+            }
+        }
+    }
+
+    if (!newValue.isEmpty()) {
+        QList<NetworkModelItem*> &items = index[newValue];
+        items << item;
+        if (type == NetworkItemsList::Name && items.count() == 2) {
+            // The item which had the name so far needs to be distinguished by its device name now
+            if (uniqueNameChangedItem) {
+                uniqueNameChangedItem->markRoleChanged(NetworkModel::ItemUniqueNameRole);
+                Q_EMIT itemUniqueNameChanged(uniqueNameChangedItem);
+            }
+            uniqueNameChangedItem = items.first();
+        }
+    }
+
+    if (uniqueNameChangedItem) {
+        uniqueNameChangedItem->markRoleChanged(NetworkModel::ItemUniqueNameRole);
+        Q_EMIT itemUniqueNameChanged(uniqueNameChangedItem);
+    }
+}
+
+void NetworkItemsList::updatePathIndex(NetworkModelItem *item, const NetworkItemsList::FilterType type, DBusPathTable::Handle oldPath, DBusPathTable::Handle newPath)
+{
+    QHash<DBusPathTable::Handle, QList<NetworkModelItem*>> &index = m_pathIndexes[type];
+
+    if (oldPath) {
+        auto it = index.find(oldPath);
+        if (it != index.end()) {
+            it->removeOne(item);
+            if (it->isEmpty()) {
+                index.erase(it);
+            }
+        }
+    }
+
+    if (newPath) {
+        index[newPath] << item;
+    }
+}
+
+void NetworkItemsList::updateTypeIndex(NetworkModelItem *item, NetworkManager::ConnectionSettings::ConnectionType oldType, NetworkManager::ConnectionSettings::ConnectionType newType)
+{
+    auto it = m_typeIndex.find(oldType);
+    if (it != m_typeIndex.end()) {
+        it->removeOne(item);
+        if (it->isEmpty()) {
+            m_typeIndex.erase(it);
+        }
+    }
+
+    m_typeIndex[newType] << item;
+}
+
+QList<NetworkModelItem*> NetworkItemsList::scanItems(const NetworkItemsList::FilterType type, const QString &parameter, const QString &additionalParameter) const
+{
+    // Items with an empty value are not indexed, so we have to look at all of them
     QList<NetworkModelItem*> result;
+    DBusPathTable *table = DBusPathTable::instance();
+    const bool pathType = isPathType(type);
+    const DBusPathTable::Handle path = table->find(parameter);
+    const DBusPathTable::Handle devicePath = table->find(additionalParameter);
+
+    // Paths which are not interned are not referenced by any item
+    if ((pathType && !parameter.isEmpty() && !path) ||
+        ((type == NetworkItemsList::Connection || type == NetworkItemsList::Ssid) && !additionalParameter.isEmpty() && !devicePath)) {
+        return result;
+    }
 
     for (NetworkModelItem *item : m_items) {
-        if (type == NetworkItemsList::Type) {
-            if (item->type() == typeParameter) {
-                result << item;
-            }
+        if (pathType ? itemPath(item, type) != path : itemValue(item, type) != parameter) {
+            continue;
+        }
+
+        if ((type == NetworkItemsList::Connection || type == NetworkItemsList::Ssid) &&
+            !additionalParameter.isEmpty() && item->devicePathHandle() != devicePath) {
+            continue;
         }
+
+        result << item;
     }
+
     return result;
 }
+
+quint32 NetworkItemsList::intern(const QString &string)
+{
+    if (string.isEmpty()) {
+        return 0;
+    }
+
+    quint32 id = m_stringIds.value(string);
+    if (!id) {
+        if (m_freeStringIds.isEmpty()) {
+            id = m_strings.count();
+            m_strings.append(InternedString());
+        } else {
+            id = m_freeStringIds.takeLast();
+        }
+        m_strings[id].string = string;
+        m_stringIds.insert(string, id);
+    }
+
+    ++m_strings[id].refs;
+    return id;
+}
+
+void NetworkItemsList::releaseString(quint32 id)
+{
+    if (!id) {
+        return;
+    }
+
+    InternedString &entry = m_strings[id];
+    if (--entry.refs == 0) {
+        m_stringIds.remove(entry.string);
+        entry.string.clear();
+        m_freeStringIds.append(id);
+    }
+}
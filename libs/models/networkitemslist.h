@@ -22,9 +22,16 @@
 #define PLASMA_NM_MODEL_NETWORK_ITEMS_LIST_H
 
 #include <QAbstractListModel>
+#include <QCollator>
+#include <QCollatorSortKey>
+#include <QVector>
+
+#include <vector>
 
 #include <NetworkManagerQt/ConnectionSettings>
 
+#include "dbuspathtable.h"
+
 class NetworkModelItem;
 
 class NetworkItemsList : public QObject
@@ -41,6 +48,26 @@ public:
         Type
     };
 
+    // The editor key holds 255 - UiUtils::SortedConnectionType above the connection state and the timestamp
+    enum { EditorKeyTypeShift = 35 };
+
+    /**
+     * Values derived from the items which the proxy models sort and filter by, one contiguous array
+     * per value indexed by row, computed only when the item publishes a change of the value. The
+     * orderings of the proxy models are packed into a single integer each. Strings are stored as ids
+     * of interned strings, which are reference counted by the rows and reused once released.
+     */
+    struct Columns {
+        QVector<quint32> uniqueNames;
+        QVector<quint64> appletKeys;
+        QVector<quint64> mobileKeys;
+        QVector<quint64> editorKeys;
+        // Collation keys of the names, QCollatorSortKey can't be default constructed
+        std::vector<QCollatorSortKey> nameKeys;
+        // Interned VPN plugin names, 0 for other connections
+        QVector<quint32> vpnTypes;
+    };
+
     explicit NetworkItemsList(QObject *parent = nullptr);
     ~NetworkItemsList() override;
 
@@ -49,13 +76,85 @@ public:
     int indexOf(NetworkModelItem *item) const;
     NetworkModelItem *itemAt(int index) const;
     QList<NetworkModelItem*> items() const;
+    const Columns &columns() const { return m_columns; }
+    QString internedString(quint32 id) const { return m_strings.at(id).string; }
+    /**
+     * Returns the name of the item, or its original name when other items share the name
+     */
+    QString uniqueName(const NetworkModelItem *item) const;
+    /**
+     * Refreshes the columns of the given row from its item, done whenever changes of the item are published
+     */
+    void updateColumns(int row);
+    /**
+     * Compare the names and the VPN plugin names of two rows in the order of the current locale
+     */
+    int compareNames(int leftRow, int rightRow) const;
+    int compareVpnTypes(int leftRow, int rightRow) const;
+    /**
+     * Rebuilds the collator for the current locale and the collation keys of all rows,
+     * returns false when the locale didn't change
+     */
+    bool updateCollator();
+    /**
+     * Returns how many items share the given name
+     */
+    int nameCount(const QString &name) const;
     QList<NetworkModelItem*> returnItems(const FilterType type, const QString &parameter, const QString &additionalParameter = QString()) const;
     QList<NetworkModelItem*> returnItems(const FilterType type, NetworkManager::ConnectionSettings::ConnectionType typeParameter) const;
 
     void insertItem(NetworkModelItem *item);
+    /**
+     * Appends the items in the given order
+     */
+    void insertItems(const QList<NetworkModelItem*> &items);
     void removeItem(NetworkModelItem *item);
+    /**
+     * Removes @p count items starting at @p row, the items are not deleted
+     */
+    void removeItems(int row, int count);
+
+Q_SIGNALS:
+    /**
+     * Emitted when the item stopped or started sharing its name with other items,
+     * ItemUniqueNameRole is already marked as changed for the item
+     */
+    void itemUniqueNameChanged(NetworkModelItem *item);
+
 private:
+    // Items notify us from their setters, so the indexes below never go stale
+    friend class NetworkModelItem;
+
+    void addToIndexes(NetworkModelItem *item);
+    void removeFromIndexes(NetworkModelItem *item);
+    void updateIndex(NetworkModelItem *item, const FilterType type, const QString &oldValue, const QString &newValue);
+    void updatePathIndex(NetworkModelItem *item, const FilterType type, DBusPathTable::Handle oldPath, DBusPathTable::Handle newPath);
+    void updateTypeIndex(NetworkModelItem *item, NetworkManager::ConnectionSettings::ConnectionType oldType, NetworkManager::ConnectionSettings::ConnectionType newType);
+    QList<NetworkModelItem*> scanItems(const FilterType type, const QString &parameter, const QString &additionalParameter) const;
+    // Returns the id of the string and adds a reference to it, the empty string is always id 0
+    quint32 intern(const QString &string);
+    void releaseString(quint32 id);
+    // Refreshes the columns depending on the given roles, see NetworkModelItem::roleBit()
+    void updateColumns(int row, quint64 roles);
+    void updateSortKeys(int row);
+
     QList<NetworkModelItem*> m_items;
+    // One index per path based FilterType (ActiveConnection - Device) keyed by the interned paths
+    // and one per remaining string based FilterType (Name - Uuid), empty values are not indexed
+    QHash<DBusPathTable::Handle, QList<NetworkModelItem*>> m_pathIndexes[Name];
+    QHash<QString, QList<NetworkModelItem*>> m_indexes[Type];
+    QHash<int, QList<NetworkModelItem*>> m_typeIndex;
+    Columns m_columns;
+    QCollator m_collator;
+
+    struct InternedString {
+        QString string;
+        int refs = 0;
+    };
+
+    QVector<InternedString> m_strings;
+    QVector<quint32> m_freeStringIds;
+    QHash<QString, quint32> m_stringIds;
 };
 
 #endif // PLASMA_NM_MODEL_NETWORK_ITEMS_LIST_H
@@ -0,0 +1,615 @@
+/*
+    Copyright 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "networkmanagerbackend.h"
+#include "devicestatisticsbroker.h"
+#include "debug.h"
+
+#include <NetworkManagerQt/AccessPoint>
+#include <NetworkManagerQt/BondDevice>
+#include <NetworkManagerQt/BridgeDevice>
+#include <NetworkManagerQt/InfinibandDevice>
+#include <NetworkManagerQt/Settings>
+#include <NetworkManagerQt/TeamDevice>
+#include <NetworkManagerQt/VlanDevice>
+#include <NetworkManagerQt/WiredDevice>
+
+#if WITH_MODEMMANAGER_SUPPORT
+#include <ModemManagerQt/manager.h>
+#include <ModemManagerQt/modem3gpp.h>
+#include <ModemManagerQt/modemcdma.h>
+#endif
+
+#include <QDBusConnection>
+#include <QDBusMessage>
+#include <QDBusObjectPath>
+#include <QDBusPendingCallWatcher>
+#include <QDBusPendingReply>
+
+NetworkManagerBackend::NetworkManagerBackend(QObject *parent)
+    : NetworkBackend(parent)
+{
+    connect(NetworkManager::notifier(), &NetworkManager::Notifier::activeConnectionAdded, this, &NetworkManagerBackend::onActiveConnectionAdded);
+    connect(NetworkManager::notifier(), &NetworkManager::Notifier::activeConnectionRemoved, this, &NetworkBackend::activeConnectionRemoved);
+    connect(NetworkManager::settingsNotifier(), &NetworkManager::SettingsNotifier::connectionAdded, this, &NetworkBackend::connectionAdded);
+    connect(NetworkManager::settingsNotifier(), &NetworkManager::SettingsNotifier::connectionRemoved, this, &NetworkBackend::connectionRemoved);
+    connect(ConnectionSummaryCache::instance(), &ConnectionSummaryCache::summaryChanged, this, &NetworkBackend::connectionUpdated);
+    connect(NetworkManager::notifier(), &NetworkManager::Notifier::deviceAdded, this, &NetworkManagerBackend::onDeviceAdded);
+    connect(NetworkManager::notifier(), &NetworkManager::Notifier::deviceRemoved, this, &NetworkManagerBackend::onDeviceRemoved);
+    connect(NetworkManager::notifier(), &NetworkManager::Notifier::statusChanged, this, &NetworkBackend::statusChanged);
+    connect(NetworkManager::notifier(), &NetworkManager::Notifier::connectivityChanged, this, &NetworkBackend::connectivityChanged);
+    connect(NetworkManager::notifier(), &NetworkManager::Notifier::primaryConnectionChanged, this, &NetworkBackend::primaryConnectionChanged);
+
+    for (const NetworkManager::Device::Ptr &device : NetworkManager::networkInterfaces()) {
+        watchDevice(device);
+    }
+
+    for (const NetworkManager::ActiveConnection::Ptr &activeConnection : NetworkManager::activeConnections()) {
+        watchActiveConnection(activeConnection);
+    }
+}
+
+NetworkManagerBackend::~NetworkManagerBackend()
+{
+}
+
+NetworkManager::Status NetworkManagerBackend::status() const
+{
+    return NetworkManager::status();
+}
+
+NetworkManager::Connectivity NetworkManagerBackend::connectivity() const
+{
+    return NetworkManager::connectivity();
+}
+
+QString NetworkManagerBackend::primaryConnection() const
+{
+    const NetworkManager::ActiveConnection::Ptr activeConnection = NetworkManager::primaryConnection();
+    return activeConnection ? activeConnection->path() : QString();
+}
+
+QStringList NetworkManagerBackend::devices() const
+{
+    QStringList paths;
+    for (const NetworkManager::Device::Ptr &device : NetworkManager::networkInterfaces()) {
+        paths << device->uni();
+    }
+    return paths;
+}
+
+BackendDevice NetworkManagerBackend::device(const QString &path) const
+{
+    BackendDevice result;
+    NetworkManager::Device::Ptr device = path.isEmpty() ? NetworkManager::Device::Ptr() : NetworkManager::findNetworkInterface(path);
+    if (!device) {
+        return result;
+    }
+
+    result.path = device->uni();
+    result.interfaceName = device->ipInterfaceName().isEmpty() ? device->interfaceName() : device->ipInterfaceName();
+    result.type = device->type();
+    result.state = device->state();
+    result.managed = device->managed();
+    for (const NetworkManager::Connection::Ptr &connection : device->availableConnections()) {
+        result.availableConnections << connection->path();
+    }
+
+    NetworkManager::DeviceStatistics::Ptr deviceStatistics = device->deviceStatistics();
+    result.rxBytes = deviceStatistics->rxBytes();
+    result.txBytes = deviceStatistics->txBytes();
+
+    // Only the first address and nameserver are shown
+    const NetworkManager::IpConfig ipV4Config = device->ipV4Config();
+    if (ipV4Config.isValid()) {
+        if (!ipV4Config.addresses().isEmpty() && !ipV4Config.addresses().first().ip().isNull()) {
+            result.ipV4Address = ipV4Config.addresses().first().ip().toString();
+        }
+        result.ipV4Gateway = ipV4Config.gateway();
+        if (!ipV4Config.nameservers().isEmpty() && !ipV4Config.nameservers().first().isNull()) {
+            result.ipV4Nameserver = ipV4Config.nameservers().first().toString();
+        }
+    }
+
+    const NetworkManager::IpConfig ipV6Config = device->ipV6Config();
+    if (ipV6Config.isValid()) {
+        if (!ipV6Config.addresses().isEmpty() && !ipV6Config.addresses().first().ip().isNull()) {
+            result.ipV6Address = ipV6Config.addresses().first().ip().toString();
+        }
+        if (!ipV6Config.nameservers().isEmpty() && !ipV6Config.nameservers().first().isNull()) {
+            result.ipV6Nameserver = ipV6Config.nameservers().first().toString();
+        }
+    }
+
+    switch (device->type()) {
+        case NetworkManager::Device::Ethernet: {
+            NetworkManager::WiredDevice::Ptr wiredDevice = device.objectCast<NetworkManager::WiredDevice>();
+            result.hardwareAddress = wiredDevice->hardwareAddress();
+            result.permanentHardwareAddress = wiredDevice->permanentHardwareAddress();
+            result.bitRate = wiredDevice->bitRate();
+            break;
+        }
+        case NetworkManager::Device::Wifi: {
+            NetworkManager::WirelessDevice::Ptr wifiDevice = device.objectCast<NetworkManager::WirelessDevice>();
+            result.hardwareAddress = wifiDevice->hardwareAddress();
+            result.permanentHardwareAddress = wifiDevice->permanentHardwareAddress();
+            result.bitRate = wifiDevice->bitRate();
+            break;
+        }
+        case NetworkManager::Device::Bluetooth: {
+            NetworkManager::BluetoothDevice::Ptr bluetoothDevice = device.objectCast<NetworkManager::BluetoothDevice>();
+            result.hardwareAddress = bluetoothDevice->hardwareAddress();
+            result.bluetoothName = bluetoothDevice->name();
+            result.bluetoothCapabilities = bluetoothDevice->bluetoothCapabilities();
+            break;
+        }
+        case NetworkManager::Device::InfiniBand:
+            result.hardwareAddress = device.objectCast<NetworkManager::InfinibandDevice>()->hwAddress();
+            break;
+        case NetworkManager::Device::Bond:
+            result.hardwareAddress = device.objectCast<NetworkManager::BondDevice>()->hwAddress();
+            break;
+        case NetworkManager::Device::Bridge:
+            result.hardwareAddress = device.objectCast<NetworkManager::BridgeDevice>()->hwAddress();
+            break;
+        case NetworkManager::Device::Vlan: {
+            NetworkManager::VlanDevice::Ptr vlanDevice = device.objectCast<NetworkManager::VlanDevice>();
+            result.hardwareAddress = vlanDevice->hwAddress();
+            result.vlanId = vlanDevice->vlanId();
+            break;
+        }
+        case NetworkManager::Device::Team:
+            result.hardwareAddress = device.objectCast<NetworkManager::TeamDevice>()->hwAddress();
+            break;
+#if WITH_MODEMMANAGER_SUPPORT
+        case NetworkManager::Device::Modem: {
+            ModemManager::ModemDevice::Ptr modemDevice = ModemManager::findModemDevice(device->udi());
+            if (!modemDevice) {
+                break;
+            }
+            ModemManager::Modem::Ptr modemInterface = modemDevice->interface(ModemManager::ModemDevice::ModemInterface).objectCast<ModemManager::Modem>();
+            if (modemInterface) {
+                result.signal = modemInterface->signalQuality().signal;
+                result.modemAccessTechnologies = modemInterface->accessTechnologies();
+            }
+            ModemManager::Modem3gpp::Ptr gsmNetwork = modemDevice->interface(ModemManager::ModemDevice::GsmInterface).objectCast<ModemManager::Modem3gpp>();
+            ModemManager::ModemCdma::Ptr cdmaNetwork = modemDevice->interface(ModemManager::ModemDevice::CdmaInterface).objectCast<ModemManager::ModemCdma>();
+            if (gsmNetwork) {
+                result.modemOperator = gsmNetwork->operatorName();
+            } else if (cdmaNetwork) {
+                result.modemOperator = QString::number(cdmaNetwork->nid());
+            }
+            break;
+        }
+#endif
+        default:
+            break;
+    }
+
+    return result;
+}
+
+QStringList NetworkManagerBackend::activeConnections() const
+{
+    return NetworkManager::activeConnectionsPaths();
+}
+
+BackendActiveConnection NetworkManagerBackend::activeConnection(const QString &path) const
+{
+    BackendActiveConnection result;
+    NetworkManager::ActiveConnection::Ptr activeConnection = path.isEmpty() ? NetworkManager::ActiveConnection::Ptr() : NetworkManager::findActiveConnection(path);
+    if (!activeConnection) {
+        return result;
+    }
+
+    result.path = activeConnection->path();
+    NetworkManager::Connection::Ptr connection = activeConnection->connection();
+    if (connection) {
+        result.connectionPath = connection->path();
+    }
+    result.uuid = activeConnection->uuid();
+    // Not necessary to have device for VPN connections
+    if (!activeConnection->vpn() && !activeConnection->devices().isEmpty()) {
+        result.devicePath = activeConnection->devices().first();
+    }
+    result.specificObject = activeConnection->specificObject();
+    result.state = activeConnection->state();
+    result.vpn = activeConnection->vpn();
+    if (result.vpn) {
+        NetworkManager::VpnConnection::Ptr vpnConnection = activeConnection.objectCast<NetworkManager::VpnConnection>();
+        if (vpnConnection) {
+            result.vpnState = vpnConnection->state();
+            result.vpnBanner = vpnConnection->banner();
+        }
+    }
+
+    return result;
+}
+
+ConnectionSummary NetworkManagerBackend::connection(const QString &path) const
+{
+    if (path.isEmpty()) {
+        return ConnectionSummary();
+    }
+
+    return ConnectionSummaryCache::instance()->summary(path);
+}
+
+void NetworkManagerBackend::listConnections()
+{
+    QDBusMessage message = QDBusMessage::createMethodCall(QStringLiteral("org.freedesktop.NetworkManager"),
+                                                          QStringLiteral("/org/freedesktop/NetworkManager/Settings"),
+                                                          QStringLiteral("org.freedesktop.NetworkManager.Settings"),
+                                                          QStringLiteral("ListConnections"));
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(QDBusConnection::systemBus().asyncCall(message), this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, &NetworkManagerBackend::listConnectionsFinished);
+}
+
+void NetworkManagerBackend::listConnectionsFinished(QDBusPendingCallWatcher *watcher)
+{
+    QDBusPendingReply<QList<QDBusObjectPath>> reply = *watcher;
+    watcher->deleteLater();
+
+    QStringList paths;
+    if (reply.isError()) {
+        qCWarning(PLASMA_NM) << "Failed to list connections:" << reply.error().message();
+        for (const NetworkManager::Connection::Ptr &connection : NetworkManager::listConnections()) {
+            paths << connection->path();
+        }
+    } else {
+        for (const QDBusObjectPath &path : reply.value()) {
+            paths << path.path();
+        }
+    }
+
+    Q_EMIT connectionsListed(paths);
+}
+
+QStringList NetworkManagerBackend::wirelessNetworks(const QString &devicePath) const
+{
+    QStringList ssids;
+    NetworkManager::WirelessDevice::Ptr wifiDevice = NetworkManager::findNetworkInterface(devicePath).objectCast<NetworkManager::WirelessDevice>();
+    if (wifiDevice) {
+        for (const NetworkManager::WirelessNetwork::Ptr &network : wifiDevice->networks()) {
+            ssids << network->ssid();
+        }
+    }
+    return ssids;
+}
+
+BackendWirelessNetwork NetworkManagerBackend::wirelessNetwork(const QString &devicePath, const QString &ssid) const
+{
+    NetworkManager::WirelessDevice::Ptr wifiDevice = NetworkManager::findNetworkInterface(devicePath).objectCast<NetworkManager::WirelessDevice>();
+    if (!wifiDevice) {
+        return BackendWirelessNetwork();
+    }
+
+    return toWirelessNetwork(wifiDevice->findNetwork(ssid), wifiDevice);
+}
+
+BackendWirelessNetwork NetworkManagerBackend::wirelessNetworkOfAccessPoint(const QString &devicePath, const QString &accessPoint) const
+{
+    NetworkManager::WirelessDevice::Ptr wifiDevice = NetworkManager::findNetworkInterface(devicePath).objectCast<NetworkManager::WirelessDevice>();
+    if (!wifiDevice) {
+        return BackendWirelessNetwork();
+    }
+
+    NetworkManager::AccessPoint::Ptr ap = wifiDevice->findAccessPoint(accessPoint);
+    if (!ap) {
+        return BackendWirelessNetwork();
+    }
+
+    return toWirelessNetwork(wifiDevice->findNetwork(ap->ssid()), wifiDevice);
+}
+
+void NetworkManagerBackend::setDeviceStatisticsRefreshRateMs(QObject *consumer, const QString &devicePath, uint refreshRate)
+{
+    DeviceStatisticsBroker::instance()->setRefreshRateMs(consumer, devicePath, refreshRate);
+}
+
+void NetworkManagerBackend::releaseDeviceStatistics(QObject *consumer)
+{
+    DeviceStatisticsBroker::instance()->release(consumer);
+}
+
+uint NetworkManagerBackend::deviceStatisticsRefreshRateMs(const QString &devicePath) const
+{
+    return DeviceStatisticsBroker::instance()->refreshRateMs(devicePath);
+}
+
+void NetworkManagerBackend::watchAccessPoint(const QString &devicePath, const QString &accessPoint)
+{
+    NetworkManager::WirelessDevice::Ptr wifiDevice = NetworkManager::findNetworkInterface(devicePath).objectCast<NetworkManager::WirelessDevice>();
+    NetworkManager::AccessPoint::Ptr ap = wifiDevice ? wifiDevice->findAccessPoint(accessPoint) : NetworkManager::AccessPoint::Ptr();
+    if (!ap) {
+        return;
+    }
+
+    m_accessPointDevices.insert(accessPoint, devicePath);
+    connect(ap.data(), &NetworkManager::AccessPoint::signalStrengthChanged, this, &NetworkManagerBackend::onAccessPointSignalStrengthChanged, Qt::UniqueConnection);
+}
+
+BackendWirelessNetwork NetworkManagerBackend::toWirelessNetwork(const NetworkManager::WirelessNetwork::Ptr &network, const NetworkManager::WirelessDevice::Ptr &device)
+{
+    BackendWirelessNetwork result;
+    if (!network) {
+        return result;
+    }
+
+    result.devicePath = device->uni();
+    result.ssid = network->ssid();
+    result.signal = network->signalStrength();
+
+    NetworkManager::AccessPoint::Ptr ap = network->referenceAccessPoint();
+    if (ap) {
+        result.referenceAccessPoint.path = ap->uni();
+        result.referenceAccessPoint.hardwareAddress = ap->hardwareAddress();
+        result.referenceAccessPoint.signal = ap->signalStrength();
+
+        if (ap->capabilities().testFlag(NetworkManager::AccessPoint::Privacy) || ap->wpaFlags() || ap->rsnFlags()) {
+            result.securityType = NetworkManager::findBestWirelessSecurity(device->wirelessCapabilities(), true, (device->mode() == NetworkManager::WirelessDevice::Adhoc),
+                                                                           ap->capabilities(), ap->wpaFlags(), ap->rsnFlags());
+            if (ap->mode() == NetworkManager::AccessPoint::Infra) {
+                result.mode = NetworkManager::WirelessSetting::Infrastructure;
+            } else if (ap->mode() == NetworkManager::AccessPoint::Adhoc) {
+                result.mode = NetworkManager::WirelessSetting::Adhoc;
+            } else if (ap->mode() == NetworkManager::AccessPoint::ApMode) {
+                result.mode = NetworkManager::WirelessSetting::Ap;
+            }
+        }
+    }
+
+    for (const NetworkManager::AccessPoint::Ptr &accessPoint : network->accessPoints()) {
+        BackendAccessPoint backendAccessPoint;
+        backendAccessPoint.path = accessPoint->uni();
+        backendAccessPoint.hardwareAddress = accessPoint->hardwareAddress();
+        backendAccessPoint.signal = accessPoint->signalStrength();
+        result.accessPoints << backendAccessPoint;
+    }
+
+    return result;
+}
+
+void NetworkManagerBackend::watchActiveConnection(const NetworkManager::ActiveConnection::Ptr &activeConnection)
+{
+    if (activeConnection->vpn()) {
+        NetworkManager::VpnConnection::Ptr vpnConnection = activeConnection.objectCast<NetworkManager::VpnConnection>();
+        if (vpnConnection) {
+            connect(vpnConnection.data(), &NetworkManager::VpnConnection::stateChanged, this, &NetworkManagerBackend::onVpnConnectionStateChanged, Qt::UniqueConnection);
+            connect(vpnConnection.data(), &NetworkManager::VpnConnection::bannerChanged, this, &NetworkManagerBackend::onVpnConnectionBannerChanged, Qt::UniqueConnection);
+        }
+    } else {
+        connect(activeConnection.data(), &NetworkManager::ActiveConnection::stateChanged, this, &NetworkManagerBackend::onActiveConnectionStateChanged, Qt::UniqueConnection);
+    }
+}
+
+void NetworkManagerBackend::watchDevice(const NetworkManager::Device::Ptr &device)
+{
+    connect(device.data(), &NetworkManager::Device::availableConnectionAppeared, this, &NetworkManagerBackend::onAvailableConnectionAppeared, Qt::UniqueConnection);
+    connect(device.data(), &NetworkManager::Device::availableConnectionDisappeared, this, &NetworkManagerBackend::onAvailableConnectionDisappeared, Qt::UniqueConnection);
+    connect(device.data(), &NetworkManager::Device::ipV4ConfigChanged, this, &NetworkManagerBackend::onDeviceDetailsChanged, Qt::UniqueConnection);
+    connect(device.data(), &NetworkManager::Device::ipV6ConfigChanged, this, &NetworkManagerBackend::onDeviceDetailsChanged, Qt::UniqueConnection);
+    connect(device.data(), &NetworkManager::Device::ipInterfaceChanged, this, &NetworkManagerBackend::onDeviceInterfaceNameChanged, Qt::UniqueConnection);
+    connect(device.data(), &NetworkManager::Device::stateChanged, this, &NetworkManagerBackend::onDeviceStateChanged, Qt::UniqueConnection);
+
+    const QString deviceUni = device->uni();
+    auto deviceStatistics = device->deviceStatistics();
+    auto statisticsChanged = [this, deviceUni, deviceStatistics] () {
+        Q_EMIT deviceStatisticsChanged(deviceUni, deviceStatistics->rxBytes(), deviceStatistics->txBytes());
+    };
+    connect(deviceStatistics.data(), &NetworkManager::DeviceStatistics::rxBytesChanged, this, statisticsChanged);
+    connect(deviceStatistics.data(), &NetworkManager::DeviceStatistics::txBytesChanged, this, statisticsChanged);
+
+    if (device->type() == NetworkManager::Device::Ethernet) {
+        NetworkManager::WiredDevice::Ptr wiredDev = device.objectCast<NetworkManager::WiredDevice>();
+        connect(wiredDev.data(), &NetworkManager::WiredDevice::bitRateChanged, this, &NetworkManagerBackend::onDeviceDetailsChanged, Qt::UniqueConnection);
+    } else if (device->type() == NetworkManager::Device::Wifi) {
+        NetworkManager::WirelessDevice::Ptr wifiDev = device.objectCast<NetworkManager::WirelessDevice>();
+        connect(wifiDev.data(), &NetworkManager::WirelessDevice::bitRateChanged, this, &NetworkManagerBackend::onDeviceDetailsChanged, Qt::UniqueConnection);
+        connect(wifiDev.data(), &NetworkManager::WirelessDevice::networkAppeared, this, &NetworkManagerBackend::onWirelessNetworkAppeared, Qt::UniqueConnection);
+        connect(wifiDev.data(), &NetworkManager::WirelessDevice::networkDisappeared, this, &NetworkManagerBackend::onWirelessNetworkDisappeared, Qt::UniqueConnection);
+
+        for (const NetworkManager::WirelessNetwork::Ptr &network : wifiDev->networks()) {
+            watchWirelessNetwork(network);
+        }
+    }
+
+#if WITH_MODEMMANAGER_SUPPORT
+    else if (device->type() == NetworkManager::Device::Modem) {
+        ModemManager::ModemDevice::Ptr modem = ModemManager::findModemDevice(device->udi());
+        if (modem) {
+            if (modem->hasInterface(ModemManager::ModemDevice::ModemInterface)) {
+                ModemManager::Modem::Ptr modemNetwork = modem->interface(ModemManager::ModemDevice::ModemInterface).objectCast<ModemManager::Modem>();
+                if (modemNetwork) {
+                    connect(modemNetwork.data(), &ModemManager::Modem::signalQualityChanged, this, [this, deviceUni] (const ModemManager::SignalQualityPair &signalQuality) {
+                        Q_EMIT deviceSignalChanged(deviceUni, signalQuality.signal);
+                    });
+                    // TODO store access technology internally?
+                    connect(modemNetwork.data(), &ModemManager::Modem::accessTechnologiesChanged, this, [this, deviceUni] () {
+                        Q_EMIT deviceDetailsChanged(deviceUni);
+                    });
+                    connect(modemNetwork.data(), &ModemManager::Modem::currentModesChanged, this, [this, deviceUni] () {
+                        Q_EMIT deviceDetailsChanged(deviceUni);
+                    });
+                }
+            }
+            if (modem->hasInterface(ModemManager::ModemDevice::GsmInterface)) {
+                ModemManager::Modem3gpp::Ptr gsmNetwork = modem->interface(ModemManager::ModemDevice::GsmInterface).objectCast<ModemManager::Modem3gpp>();
+                if (gsmNetwork) {
+                    connect(gsmNetwork.data(), &ModemManager::Modem3gpp::operatorNameChanged, this, [this, deviceUni] () {
+                        Q_EMIT deviceDetailsChanged(deviceUni);
+                    });
+                }
+            }
+        }
+    }
+#endif
+}
+
+void NetworkManagerBackend::watchWirelessNetwork(const NetworkManager::WirelessNetwork::Ptr &network)
+{
+    connect(network.data(), &NetworkManager::WirelessNetwork::signalStrengthChanged, this, &NetworkManagerBackend::onWirelessNetworkSignalStrengthChanged, Qt::UniqueConnection);
+    connect(network.data(), &NetworkManager::WirelessNetwork::referenceAccessPointChanged, this, &NetworkManagerBackend::onWirelessNetworkReferenceAccessPointChanged, Qt::UniqueConnection);
+}
+
+void NetworkManagerBackend::onAccessPointSignalStrengthChanged(int signal)
+{
+    NetworkManager::AccessPoint *ap = qobject_cast<NetworkManager::AccessPoint*>(sender());
+    if (!ap) {
+        return;
+    }
+
+    const QString devicePath = m_accessPointDevices.value(ap->uni());
+    if (!devicePath.isEmpty()) {
+        Q_EMIT accessPointSignalChanged(devicePath, ap->uni(), signal);
+    }
+}
+
+void NetworkManagerBackend::onActiveConnectionAdded(const QString &path)
+{
+    NetworkManager::ActiveConnection::Ptr activeConnection = NetworkManager::findActiveConnection(path);
+    if (activeConnection) {
+        watchActiveConnection(activeConnection);
+        Q_EMIT activeConnectionAdded(path);
+    }
+}
+
+void NetworkManagerBackend::onActiveConnectionStateChanged(NetworkManager::ActiveConnection::State state)
+{
+    NetworkManager::ActiveConnection *activeConnection = qobject_cast<NetworkManager::ActiveConnection*>(sender());
+    if (activeConnection) {
+        Q_EMIT activeConnectionStateChanged(activeConnection->path(), state);
+    }
+}
+
+void NetworkManagerBackend::onAvailableConnectionAppeared(const QString &connection)
+{
+    NetworkManager::Device *device = qobject_cast<NetworkManager::Device*>(sender());
+    if (device) {
+        Q_EMIT availableConnectionAppeared(device->uni(), connection);
+    }
+}
+
+void NetworkManagerBackend::onAvailableConnectionDisappeared(const QString &connection)
+{
+    NetworkManager::Device *device = qobject_cast<NetworkManager::Device*>(sender());
+    if (device) {
+        Q_EMIT availableConnectionDisappeared(device->uni(), connection);
+    }
+}
+
+void NetworkManagerBackend::onDeviceAdded(const QString &path)
+{
+    NetworkManager::Device::Ptr device = NetworkManager::findNetworkInterface(path);
+    if (device) {
+        watchDevice(device);
+        Q_EMIT deviceAdded(path);
+    }
+}
+
+void NetworkManagerBackend::onDeviceDetailsChanged()
+{
+    NetworkManager::Device *device = qobject_cast<NetworkManager::Device*>(sender());
+    if (device) {
+        Q_EMIT deviceDetailsChanged(device->uni());
+    }
+}
+
+void NetworkManagerBackend::onDeviceInterfaceNameChanged()
+{
+    NetworkManager::Device *device = qobject_cast<NetworkManager::Device*>(sender());
+    if (device) {
+        Q_EMIT deviceInterfaceNameChanged(device->uni());
+    }
+}
+
+void NetworkManagerBackend::onDeviceRemoved(const QString &path)
+{
+    for (auto it = m_accessPointDevices.begin(); it != m_accessPointDevices.end();) {
+        it = it.value() == path ? m_accessPointDevices.erase(it) : it + 1;
+    }
+
+    Q_EMIT deviceRemoved(path);
+}
+
+void NetworkManagerBackend::onDeviceStateChanged(NetworkManager::Device::State state, NetworkManager::Device::State oldState, NetworkManager::Device::StateChangeReason reason)
+{
+    NetworkManager::Device *device = qobject_cast<NetworkManager::Device*>(sender());
+    if (device) {
+        Q_EMIT deviceStateChanged(device->uni(), state, oldState, reason);
+    }
+}
+
+void NetworkManagerBackend::onVpnConnectionBannerChanged(const QString &banner)
+{
+    NetworkManager::ActiveConnection *activeConnection = qobject_cast<NetworkManager::ActiveConnection*>(sender());
+    if (activeConnection) {
+        Q_EMIT vpnConnectionBannerChanged(activeConnection->path(), banner);
+    }
+}
+
+void NetworkManagerBackend::onVpnConnectionStateChanged(NetworkManager::VpnConnection::State state, NetworkManager::VpnConnection::StateChangeReason reason)
+{
+    NetworkManager::ActiveConnection *activeConnection = qobject_cast<NetworkManager::ActiveConnection*>(sender());
+    if (activeConnection) {
+        Q_EMIT vpnConnectionStateChanged(activeConnection->path(), state, reason);
+    }
+}
+
+void NetworkManagerBackend::onWirelessNetworkAppeared(const QString &ssid)
+{
+    NetworkManager::WirelessDevice *device = qobject_cast<NetworkManager::WirelessDevice*>(sender());
+    if (!device) {
+        return;
+    }
+
+    NetworkManager::WirelessNetwork::Ptr network = device->findNetwork(ssid);
+    if (network) {
+        watchWirelessNetwork(network);
+    }
+    Q_EMIT wirelessNetworkAppeared(device->uni(), ssid);
+}
+
+void NetworkManagerBackend::onWirelessNetworkDisappeared(const QString &ssid)
+{
+    NetworkManager::WirelessDevice *device = qobject_cast<NetworkManager::WirelessDevice*>(sender());
+    if (device) {
+        Q_EMIT wirelessNetworkDisappeared(device->uni(), ssid);
+    }
+}
+
+void NetworkManagerBackend::onWirelessNetworkReferenceAccessPointChanged(const QString &accessPoint)
+{
+    NetworkManager::WirelessNetwork *network = qobject_cast<NetworkManager::WirelessNetwork*>(sender());
+    if (network) {
+        Q_EMIT wirelessNetworkReferenceAccessPointChanged(network->device(), network->ssid(), accessPoint);
+    }
+}
+
+void NetworkManagerBackend::onWirelessNetworkSignalStrengthChanged(int signal)
+{
+    NetworkManager::WirelessNetwork *network = qobject_cast<NetworkManager::WirelessNetwork*>(sender());
+    if (!network) {
+        return;
+    }
+
+    NetworkManager::AccessPoint::Ptr referenceAp = network->referenceAccessPoint();
+    Q_EMIT wirelessNetworkSignalChanged(network->device(), network->ssid(), referenceAp ? referenceAp->uni() : QString(), signal);
+}
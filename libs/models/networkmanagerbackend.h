@@ -0,0 +1,98 @@
+/*
+    Copyright 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PLASMA_NM_NETWORK_MANAGER_BACKEND_H
+#define PLASMA_NM_NETWORK_MANAGER_BACKEND_H
+
+#include "networkbackend.h"
+
+#include <QHash>
+
+#include <NetworkManagerQt/WirelessDevice>
+
+#if WITH_MODEMMANAGER_SUPPORT
+#include <ModemManagerQt/modem.h>
+#endif
+
+class QDBusPendingCallWatcher;
+
+/**
+ * NetworkBackend following NetworkManager through NetworkManagerQt
+ */
+class Q_DECL_EXPORT NetworkManagerBackend : public NetworkBackend
+{
+Q_OBJECT
+public:
+    explicit NetworkManagerBackend(QObject *parent = nullptr);
+    ~NetworkManagerBackend() override;
+
+    NetworkManager::Status status() const override;
+    NetworkManager::Connectivity connectivity() const override;
+    QString primaryConnection() const override;
+
+    QStringList devices() const override;
+    BackendDevice device(const QString &path) const override;
+
+    QStringList activeConnections() const override;
+    BackendActiveConnection activeConnection(const QString &path) const override;
+
+    ConnectionSummary connection(const QString &path) const override;
+    void listConnections() override;
+
+    QStringList wirelessNetworks(const QString &devicePath) const override;
+    BackendWirelessNetwork wirelessNetwork(const QString &devicePath, const QString &ssid) const override;
+    BackendWirelessNetwork wirelessNetworkOfAccessPoint(const QString &devicePath, const QString &accessPoint) const override;
+    void watchAccessPoint(const QString &devicePath, const QString &accessPoint) override;
+
+    // Shared with the other consumers in the process through DeviceStatisticsBroker
+    void setDeviceStatisticsRefreshRateMs(QObject *consumer, const QString &devicePath, uint refreshRate) override;
+    void releaseDeviceStatistics(QObject *consumer) override;
+    uint deviceStatisticsRefreshRateMs(const QString &devicePath) const override;
+
+private Q_SLOTS:
+    void onAccessPointSignalStrengthChanged(int signal);
+    void onActiveConnectionAdded(const QString &path);
+    void onActiveConnectionStateChanged(NetworkManager::ActiveConnection::State state);
+    void onAvailableConnectionAppeared(const QString &connection);
+    void onAvailableConnectionDisappeared(const QString &connection);
+    void onDeviceAdded(const QString &path);
+    void onDeviceDetailsChanged();
+    void onDeviceInterfaceNameChanged();
+    void onDeviceRemoved(const QString &path);
+    void onDeviceStateChanged(NetworkManager::Device::State state, NetworkManager::Device::State oldState, NetworkManager::Device::StateChangeReason reason);
+    void onVpnConnectionBannerChanged(const QString &banner);
+    void onVpnConnectionStateChanged(NetworkManager::VpnConnection::State state, NetworkManager::VpnConnection::StateChangeReason reason);
+    void onWirelessNetworkAppeared(const QString &ssid);
+    void onWirelessNetworkDisappeared(const QString &ssid);
+    void onWirelessNetworkReferenceAccessPointChanged(const QString &accessPoint);
+    void onWirelessNetworkSignalStrengthChanged(int signal);
+    void listConnectionsFinished(QDBusPendingCallWatcher *watcher);
+
+private:
+    void watchActiveConnection(const NetworkManager::ActiveConnection::Ptr &activeConnection);
+    void watchDevice(const NetworkManager::Device::Ptr &device);
+    void watchWirelessNetwork(const NetworkManager::WirelessNetwork::Ptr &network);
+    static BackendWirelessNetwork toWirelessNetwork(const NetworkManager::WirelessNetwork::Ptr &network, const NetworkManager::WirelessDevice::Ptr &device);
+
+    // Devices of the watched access points, they don't know it themselves
+    QHash<QString, QString> m_accessPointDevices;
+};
+
+#endif // PLASMA_NM_NETWORK_MANAGER_BACKEND_H
@@ -21,24 +21,74 @@
 #include "networkmodel.h"
 #include "networkmodelitem.h"
 #include "configuration.h"
+#include "connectionsummarycache.h"
+#include "networkmanagerbackend.h"
+#include "perfcounters.h"
+#include "tracespans.h"
 #include "debug.h"
 #include "uiutils.h"
 
-#if WITH_MODEMMANAGER_SUPPORT
-#include <ModemManagerQt/manager.h>
-#endif
-#include <NetworkManagerQt/Settings>
+#include <QCoreApplication>
+#include <QEvent>
+
+#include <algorithm>
+
+// Saved connections which are neither active nor available are added in batches of this size once idle
+#define PENDING_CONNECTIONS_BATCH_SIZE 25
 
 NetworkModel::NetworkModel(QObject *parent)
+    : NetworkModel(static_cast<NetworkBackend*>(nullptr), parent)
+{
+}
+
+NetworkModel::NetworkModel(NetworkBackend *backend, QObject *parent)
     : QAbstractListModel(parent)
+    , m_backend(nullptr)
+    , m_status(NetworkManager::Unknown)
+    , m_updateTimer(new QTimer(this))
+    , m_signalStrengthThreshold(5)
+    , m_trafficRatesTimer(new QTimer(this))
+    , m_pendingConnectionsTotal(0)
+    , m_pendingConnectionsTimer(new QTimer(this))
+    , m_loading(false)
 {
     QLoggingCategory::setFilterRules(QStringLiteral("plasma-nm.debug = false"));
 
-    initialize();
+    m_updateTimer->setSingleShot(true);
+    m_updateTimer->setInterval(0);
+    connect(m_updateTimer, &QTimer::timeout, this, &NetworkModel::flushPendingUpdates);
+
+    m_trafficClock.start();
+    m_trafficRatesTimer->setInterval(1000);
+    connect(m_trafficRatesTimer, &QTimer::timeout, this, &NetworkModel::trafficRatesTimeout);
+    connect(&m_list, &NetworkItemsList::itemUniqueNameChanged, this, &NetworkModel::updateItem);
+
+    m_pendingConnectionsTimer->setInterval(0);
+    connect(m_pendingConnectionsTimer, &QTimer::timeout, this, &NetworkModel::addPendingConnections);
+
+    // Names are sorted in the order of the current locale, which the application is notified about
+    if (QCoreApplication::instance()) {
+        QCoreApplication::instance()->installEventFilter(this);
+    }
+
+    setBackend(backend ? backend : new NetworkManagerBackend(this));
 }
 
 NetworkModel::~NetworkModel()
 {
+    // The backend might be gone already when the caller owns it
+    if (m_backend) {
+        m_backend->releaseDeviceStatistics(this);
+    }
+}
+
+bool NetworkModel::eventFilter(QObject *watched, QEvent *event)
+{
+    if (watched == QCoreApplication::instance() && event->type() == QEvent::LocaleChange && m_list.updateCollator() && m_list.count()) {
+        Q_EMIT dataChanged(createIndex(0, 0), createIndex(m_list.count() - 1, 0), {SortKeyRole});
+    }
+
+    return QAbstractListModel::eventFilter(watched, event);
 }
 
 QVariant NetworkModel::data(const QModelIndex &index, int role) const
@@ -50,6 +100,10 @@ QVariant NetworkModel::data(const QModelIndex &index, int role) const
 
         switch (role) {
             case ConnectionDetailsRole:
+                // Device snapshots are taken only when the details are actually shown
+                if (!item->detailsValid()) {
+                    item->updateDetails(m_backend->device(item->devicePath()));
+                }
                 return item->details();
             case ConnectionIconRole:
                 return item->icon();
@@ -66,11 +120,7 @@ QVariant NetworkModel::data(const QModelIndex &index, int role) const
             case DuplicateRole:
                 return item->duplicate();
             case ItemUniqueNameRole:
-                if (m_list.returnItems(NetworkItemsList::Name, item->name()).count() > 1) {
-                    return item->originalName();
-                } else {
-                    return item->name();
-                }
+                return m_list.uniqueName(item);
             case ItemTypeRole:
                 return item->itemType();
             case LastUsedRole:
@@ -109,6 +159,24 @@ QVariant NetworkModel::data(const QModelIndex &index, int role) const
                 return item->rxBytes();
             case TxBytesRole:
                 return item->txBytes();
+            case RawSignalRole:
+                return item->rawSignal();
+            case RxRateRole:
+            case TxRateRole:
+            case RxRateHistoryRole:
+            case TxRateHistoryRole: {
+                const auto it = m_trafficRates.constFind(item->devicePath());
+                if (it == m_trafficRates.constEnd()) {
+                    return role == RxRateRole || role == TxRateRole ? QVariant(0.0) : QVariant(QVariantList());
+                } else if (role == RxRateRole) {
+                    return it->rxRate();
+                } else if (role == TxRateRole) {
+                    return it->txRate();
+                } else if (role == RxRateHistoryRole) {
+                    return it->rxRateHistory();
+                }
+                return it->txRateHistory();
+            }
             default:
                 break;
         }
@@ -154,220 +222,264 @@ QHash<int, QByteArray> NetworkModel::roleNames() const
     roles[VpnType] = "VpnType";
     roles[RxBytesRole] = "RxBytes";
     roles[TxBytesRole] = "TxBytes";
+    roles[RawSignalRole] = "RawSignal";
+    roles[RxRateRole] = "RxRate";
+    roles[TxRateRole] = "TxRate";
+    roles[RxRateHistoryRole] = "RxRateHistory";
+    roles[TxRateHistoryRole] = "TxRateHistory";
 
     return roles;
 }
 
-void NetworkModel::initialize()
+int NetworkModel::updateInterval() const
 {
-    // Initialize existing connections
-    for (const NetworkManager::Connection::Ptr &connection : NetworkManager::listConnections()) {
-        addConnection(connection);
-    }
+    return m_updateTimer->interval();
+}
 
-    // Initialize existing devices
-    for (const NetworkManager::Device::Ptr &dev : NetworkManager::networkInterfaces()) {
-        if (!dev->managed()) {
-            continue;
-        }
-        addDevice(dev);
-    }
+void NetworkModel::setUpdateInterval(int interval)
+{
+    m_updateTimer->setInterval(qMax(0, interval));
+}
 
-    // Initialize existing active connections
-    for (const NetworkManager::ActiveConnection::Ptr &active : NetworkManager::activeConnections()) {
-        addActiveConnection(active);
-    }
+int NetworkModel::signalStrengthThreshold() const
+{
+    return m_signalStrengthThreshold;
+}
 
-    initializeSignals();
+void NetworkModel::setSignalStrengthThreshold(int threshold)
+{
+    m_signalStrengthThreshold = qMax(0, threshold);
 }
 
-void NetworkModel::initializeSignals()
+bool NetworkModel::loading() const
 {
-    connect(NetworkManager::notifier(), &NetworkManager::Notifier::activeConnectionAdded, this, &NetworkModel::activeConnectionAdded, Qt::UniqueConnection);
-    connect(NetworkManager::notifier(), &NetworkManager::Notifier::activeConnectionRemoved, this, &NetworkModel::activeConnectionRemoved, Qt::UniqueConnection);
-    connect(NetworkManager::settingsNotifier(), &NetworkManager::SettingsNotifier::connectionAdded, this, &NetworkModel::connectionAdded, Qt::UniqueConnection);
-    connect(NetworkManager::settingsNotifier(), &NetworkManager::SettingsNotifier::connectionRemoved, this, &NetworkModel::connectionRemoved, Qt::UniqueConnection);
-    connect(NetworkManager::notifier(), &NetworkManager::Notifier::deviceAdded, this, &NetworkModel::deviceAdded, Qt::UniqueConnection);
-    connect(NetworkManager::notifier(), &NetworkManager::Notifier::deviceRemoved, this, &NetworkModel::deviceRemoved, Qt::UniqueConnection);
-    connect(NetworkManager::notifier(), &NetworkManager::Notifier::statusChanged, this, &NetworkModel::statusChanged, Qt::UniqueConnection);
+    return m_loading;
 }
 
-void NetworkModel::initializeSignals(const NetworkManager::ActiveConnection::Ptr &activeConnection)
+qreal NetworkModel::loadingProgress() const
 {
-    if (activeConnection->vpn()) {
-        NetworkManager::VpnConnection::Ptr vpnConnection = activeConnection.objectCast<NetworkManager::VpnConnection>();
-        if (vpnConnection) {
-            connect(vpnConnection.data(), &NetworkManager::VpnConnection::stateChanged, this, &NetworkModel::activeVpnConnectionStateChanged, Qt::UniqueConnection);
-        }
-    } else {
-        connect(activeConnection.data(), &NetworkManager::ActiveConnection::stateChanged, this, &NetworkModel::activeConnectionStateChanged, Qt::UniqueConnection);
+    if (!m_loading) {
+        return 1.0;
+    }
+
+    // The number of saved connections is not known until NetworkManager lists them
+    if (!m_pendingConnectionsTotal) {
+        return 0.0;
     }
+
+    return 1.0 - static_cast<qreal>(m_pendingConnections.count()) / m_pendingConnectionsTotal;
 }
 
-void NetworkModel::initializeSignals(const NetworkManager::Connection::Ptr &connection)
+void NetworkModel::setBackend(NetworkBackend *backend)
 {
-    connect(connection.data(), &NetworkManager::Connection::updated, this, &NetworkModel::connectionUpdated, Qt::UniqueConnection);
+    m_backend = backend;
+    m_status = backend->status();
+    m_loading = true;
+    initialize();
 }
 
-void NetworkModel::initializeSignals(const NetworkManager::Device::Ptr &device)
+void NetworkModel::initialize()
 {
-    connect(device.data(), &NetworkManager::Device::availableConnectionAppeared, this, &NetworkModel::availableConnectionAppeared, Qt::UniqueConnection);
-    connect(device.data(), &NetworkManager::Device::availableConnectionDisappeared, this, &NetworkModel::availableConnectionDisappeared, Qt::UniqueConnection);
-    connect(device.data(), &NetworkManager::Device::ipV4ConfigChanged, this, &NetworkModel::ipConfigChanged, Qt::UniqueConnection);
-    connect(device.data(), &NetworkManager::Device::ipV6ConfigChanged, this, &NetworkModel::ipConfigChanged, Qt::UniqueConnection);
-    connect(device.data(), &NetworkManager::Device::ipInterfaceChanged, this, &NetworkModel::ipInterfaceChanged);
-    connect(device.data(), &NetworkManager::Device::stateChanged, this, &NetworkModel::deviceStateChanged, Qt::UniqueConnection);
-
-    auto deviceStatistics = device->deviceStatistics();
-    connect(deviceStatistics.data(), &NetworkManager::DeviceStatistics::rxBytesChanged, this, [this, device](qulonglong rxBytes) {
-        for (auto *item : m_list.returnItems(NetworkItemsList::Device, device->uni())) {
-            item->setRxBytes(rxBytes);
-            updateItem(item);
+    TRACE_SPAN("NetworkModel::initialize");
+    // Only connections which are active or available are added right away, loading settings
+    // of all the saved connections takes a while when there are many of them
+    QStringList connections;
+    QSet<QString> connectionPaths;
+    auto appendConnection = [&connections, &connectionPaths] (const QString &connection) {
+        if (!connection.isEmpty() && !connectionPaths.contains(connection)) {
+            connectionPaths.insert(connection);
+            connections << connection;
         }
-    });
-    connect(deviceStatistics.data(), &NetworkManager::DeviceStatistics::txBytesChanged, this, [this, device](qulonglong txBytes) {
-        for (auto *item : m_list.returnItems(NetworkItemsList::Device, device->uni())) {
-            item->setTxBytes(txBytes);
-            updateItem(item);
+    };
+
+    QList<BackendActiveConnection> activeConnections;
+    for (const QString &path : m_backend->activeConnections()) {
+        const BackendActiveConnection activeConnection = m_backend->activeConnection(path);
+        if (activeConnection.isValid()) {
+            activeConnections << activeConnection;
+            appendConnection(activeConnection.connectionPath);
         }
-    });
+    }
 
-    if (device->type() == NetworkManager::Device::Wifi) {
-        NetworkManager::WirelessDevice::Ptr wifiDev = device.objectCast<NetworkManager::WirelessDevice>();
-        connect(wifiDev.data(), &NetworkManager::WirelessDevice::networkAppeared, this, &NetworkModel::wirelessNetworkAppeared, Qt::UniqueConnection);
-        connect(wifiDev.data(), &NetworkManager::WirelessDevice::networkDisappeared, this, &NetworkModel::wirelessNetworkDisappeared, Qt::UniqueConnection);
+    QList<BackendDevice> devices;
+    for (const QString &path : m_backend->devices()) {
+        const BackendDevice device = m_backend->device(path);
+        if (!device.managed) {
+            continue;
+        }
+        devices << device;
+        for (const QString &connection : device.availableConnections) {
+            appendConnection(connection);
+        }
+    }
+
+    addConnections(connections);
 
+    // Initialize existing devices
+    for (const BackendDevice &device : qAsConst(devices)) {
+        addDevice(device);
     }
 
-#if WITH_MODEMMANAGER_SUPPORT
-    else if (device->type() == NetworkManager::Device::Modem) {
-        ModemManager::ModemDevice::Ptr modem = ModemManager::findModemDevice(device->udi());
-        if (modem) {
-            if (modem->hasInterface(ModemManager::ModemDevice::ModemInterface)) {
-                ModemManager::Modem::Ptr modemNetwork = modem->interface(ModemManager::ModemDevice::ModemInterface).objectCast<ModemManager::Modem>();
-                if (modemNetwork) {
-                    connect(modemNetwork.data(), &ModemManager::Modem::signalQualityChanged, this, &NetworkModel::gsmNetworkSignalQualityChanged, Qt::UniqueConnection);
-                    connect(modemNetwork.data(), &ModemManager::Modem::accessTechnologiesChanged, this, &NetworkModel::gsmNetworkAccessTechnologiesChanged, Qt::UniqueConnection);
-                    connect(modemNetwork.data(), &ModemManager::Modem::currentModesChanged, this, &NetworkModel::gsmNetworkCurrentModesChanged, Qt::UniqueConnection);
-                }
-            }
+    // Initialize existing active connections
+    for (const BackendActiveConnection &activeConnection : qAsConst(activeConnections)) {
+        addActiveConnection(activeConnection);
+    }
+
+    initializeSignals();
+
+    // The rest of the saved connections follows once they are listed
+    m_backend->listConnections();
+}
+
+void NetworkModel::connectionsListed(const QStringList &paths)
+{
+    TRACE_SPAN("NetworkModel::connectionsListed");
+    m_pendingConnections << paths;
+    m_pendingConnectionsTotal = m_pendingConnections.count();
+    Q_EMIT loadingProgressChanged(loadingProgress());
+    addPendingConnections();
+    if (m_loading) {
+        m_pendingConnectionsTimer->start();
+    }
+}
+
+void NetworkModel::addPendingConnections()
+{
+    TRACE_SPAN("NetworkModel::addPendingConnections");
+    QStringList connections;
+    while (!m_pendingConnections.isEmpty() && connections.count() < PENDING_CONNECTIONS_BATCH_SIZE) {
+        const QString path = m_pendingConnections.takeFirst();
+        // Connections which appeared or became available in the meantime are already in the model
+        if (!m_list.contains(NetworkItemsList::Connection, path)) {
+            connections << path;
         }
     }
-#endif
+
+    addConnections(connections);
+
+    if (m_pendingConnections.isEmpty()) {
+        m_pendingConnectionsTimer->stop();
+        m_loading = false;
+        qCDebug(PLASMA_NM) << "All" << m_pendingConnectionsTotal << "connections loaded";
+        Q_EMIT loadingChanged(false);
+    }
+    Q_EMIT loadingProgressChanged(loadingProgress());
 }
 
-void NetworkModel::initializeSignals(const NetworkManager::WirelessNetwork::Ptr &network)
+void NetworkModel::initializeSignals()
 {
-    connect(network.data(), &NetworkManager::WirelessNetwork::signalStrengthChanged, this, &NetworkModel::wirelessNetworkSignalChanged, Qt::UniqueConnection);
-    connect(network.data(), &NetworkManager::WirelessNetwork::referenceAccessPointChanged, this, &NetworkModel::wirelessNetworkReferenceApChanged, Qt::UniqueConnection);
+    connect(m_backend, &NetworkBackend::activeConnectionAdded, this, &NetworkModel::activeConnectionAdded, Qt::UniqueConnection);
+    connect(m_backend, &NetworkBackend::activeConnectionRemoved, this, &NetworkModel::activeConnectionRemoved, Qt::UniqueConnection);
+    connect(m_backend, &NetworkBackend::activeConnectionStateChanged, this, &NetworkModel::activeConnectionStateChanged, Qt::UniqueConnection);
+    connect(m_backend, &NetworkBackend::vpnConnectionStateChanged, this, &NetworkModel::activeVpnConnectionStateChanged, Qt::UniqueConnection);
+    connect(m_backend, &NetworkBackend::vpnConnectionBannerChanged, this, &NetworkModel::activeVpnConnectionBannerChanged, Qt::UniqueConnection);
+    connect(m_backend, &NetworkBackend::connectionAdded, this, &NetworkModel::connectionAdded, Qt::UniqueConnection);
+    connect(m_backend, &NetworkBackend::connectionRemoved, this, &NetworkModel::connectionRemoved, Qt::UniqueConnection);
+    connect(m_backend, &NetworkBackend::connectionUpdated, this, &NetworkModel::connectionUpdated, Qt::UniqueConnection);
+    connect(m_backend, &NetworkBackend::connectionsListed, this, &NetworkModel::connectionsListed, Qt::UniqueConnection);
+    connect(m_backend, &NetworkBackend::deviceAdded, this, &NetworkModel::deviceAdded, Qt::UniqueConnection);
+    connect(m_backend, &NetworkBackend::deviceRemoved, this, &NetworkModel::deviceRemoved, Qt::UniqueConnection);
+    connect(m_backend, &NetworkBackend::deviceStateChanged, this, &NetworkModel::deviceStateChanged, Qt::UniqueConnection);
+    connect(m_backend, &NetworkBackend::deviceInterfaceNameChanged, this, &NetworkModel::deviceInterfaceNameChanged, Qt::UniqueConnection);
+    connect(m_backend, &NetworkBackend::deviceDetailsChanged, this, &NetworkModel::updateDeviceDetails, Qt::UniqueConnection);
+    connect(m_backend, &NetworkBackend::deviceStatisticsChanged, this, &NetworkModel::deviceStatisticsChanged, Qt::UniqueConnection);
+    connect(m_backend, &NetworkBackend::deviceSignalChanged, this, &NetworkModel::deviceSignalChanged, Qt::UniqueConnection);
+    connect(m_backend, &NetworkBackend::availableConnectionAppeared, this, &NetworkModel::availableConnectionAppeared, Qt::UniqueConnection);
+    connect(m_backend, &NetworkBackend::availableConnectionDisappeared, this, &NetworkModel::availableConnectionDisappeared, Qt::UniqueConnection);
+    connect(m_backend, &NetworkBackend::statusChanged, this, &NetworkModel::statusChanged, Qt::UniqueConnection);
+    connect(m_backend, &NetworkBackend::wirelessNetworkAppeared, this, &NetworkModel::wirelessNetworkAppeared, Qt::UniqueConnection);
+    connect(m_backend, &NetworkBackend::wirelessNetworkDisappeared, this, &NetworkModel::wirelessNetworkDisappeared, Qt::UniqueConnection);
+    connect(m_backend, &NetworkBackend::wirelessNetworkSignalChanged, this, &NetworkModel::wirelessNetworkSignalChanged, Qt::UniqueConnection);
+    connect(m_backend, &NetworkBackend::wirelessNetworkReferenceAccessPointChanged, this, &NetworkModel::wirelessNetworkReferenceApChanged, Qt::UniqueConnection);
+    connect(m_backend, &NetworkBackend::accessPointSignalChanged, this, &NetworkModel::accessPointSignalStrengthChanged, Qt::UniqueConnection);
 }
 
-void NetworkModel::addActiveConnection(const NetworkManager::ActiveConnection::Ptr &activeConnection)
+static NetworkManager::ActiveConnection::State connectionStateFromVpnState(NetworkManager::VpnConnection::State state)
 {
-    initializeSignals(activeConnection);
+    if (state == NetworkManager::VpnConnection::Prepare ||
+        state == NetworkManager::VpnConnection::NeedAuth ||
+        state == NetworkManager::VpnConnection::Connecting ||
+        state == NetworkManager::VpnConnection::GettingIpConfig) {
+        return NetworkManager::ActiveConnection::Activating;
+    } else if (state == NetworkManager::VpnConnection::Activated) {
+        return NetworkManager::ActiveConnection::Activated;
+    }
 
-    NetworkManager::Device::Ptr device;
-    NetworkManager::Connection::Ptr connection = activeConnection->connection();
+    return NetworkManager::ActiveConnection::Deactivated;
+}
+
+void NetworkModel::addActiveConnection(const BackendActiveConnection &activeConnection)
+{
+    BackendDevice device;
 
     // Not necessary to have device for VPN connections
-    if (activeConnection && !activeConnection->vpn() && !activeConnection->devices().isEmpty()) {
-        device = NetworkManager::findNetworkInterface(activeConnection->devices().first());
+    if (!activeConnection.vpn && !activeConnection.devicePath.isEmpty()) {
+        device = m_backend->device(activeConnection.devicePath);
     }
 
     // Check whether we have a base connection
-    if (!m_list.contains(NetworkItemsList::Uuid, connection->uuid())) {
+    if (!m_list.contains(NetworkItemsList::Uuid, activeConnection.uuid)) {
         // Active connection appeared before a base connection, so we have to add its base connection first
-        addConnection(connection);
-    }
-
-    for (NetworkModelItem *item : m_list.returnItems(NetworkItemsList::NetworkItemsList::Uuid, connection->uuid())) {
-        if (((device && device->uni() == item->devicePath()) || item->devicePath().isEmpty()) || item->type() == NetworkManager::ConnectionSettings::Vpn) {
-            item->setActiveConnectionPath(activeConnection->path());
-            item->setConnectionState(activeConnection->state());
-            if (activeConnection->vpn()) {
-                NetworkManager::VpnConnection::Ptr vpnConnection = activeConnection.objectCast<NetworkManager::VpnConnection>();
-                NetworkManager::VpnConnection::State state = vpnConnection->state();
-                if (state == NetworkManager::VpnConnection::Prepare ||
-                    state == NetworkManager::VpnConnection::NeedAuth ||
-                    state == NetworkManager::VpnConnection::Connecting ||
-                    state == NetworkManager::VpnConnection::GettingIpConfig) {
-                    item->setConnectionState(NetworkManager::ActiveConnection::Activating);
-                } else if (state == NetworkManager::VpnConnection::Activated) {
-                    item->setConnectionState(NetworkManager::ActiveConnection::Activated);
-                } else {
-                    item->setConnectionState(NetworkManager::ActiveConnection::Deactivated);
-                }
-                item->setVpnState(state);
+        addConnections({activeConnection.connectionPath});
+    }
+
+    for (NetworkModelItem *item : m_list.returnItems(NetworkItemsList::NetworkItemsList::Uuid, activeConnection.uuid)) {
+        if (((device.isValid() && device.path == item->devicePath()) || item->devicePath().isEmpty()) || item->type() == NetworkManager::ConnectionSettings::Vpn) {
+            item->setActiveConnectionPath(activeConnection.path);
+            item->setConnectionState(activeConnection.state);
+            if (activeConnection.vpn) {
+                item->setConnectionState(connectionStateFromVpnState(activeConnection.vpnState));
+                item->setVpnState(activeConnection.vpnState);
+                item->setVpnBanner(activeConnection.vpnBanner);
             }
-            item->invalidateDetails();
             qCDebug(PLASMA_NM) << "Item " << item->name() << ": active connection state changed to " << item->connectionState();
 
-            if (device && device->uni() == item->devicePath()) {
-                auto deviceStatistics = device->deviceStatistics();
-                item->setRxBytes(deviceStatistics->rxBytes());
-                item->setTxBytes(deviceStatistics->txBytes());
+            if (device.isValid() && device.path == item->devicePath()) {
+                item->setRxBytes(device.rxBytes);
+                item->setTxBytes(device.txBytes);
             }
         }
         updateItem(item);
     }
 }
 
-void NetworkModel::addAvailableConnection(const QString &connection, const NetworkManager::Device::Ptr &device)
+void NetworkModel::addAvailableConnection(const QString &connection, const BackendDevice &device)
 {
-    if (!device) {
+    if (!device.isValid()) {
         return;
     }
 
-    checkAndCreateDuplicate(connection, device->uni());
+    checkAndCreateDuplicate(connection, device.path);
 
     for (NetworkModelItem *item : m_list.returnItems(NetworkItemsList::Connection, connection)) {
         // The item is already associated with another device
-        if (!device || !item->devicePath().isEmpty()) {
+        if (!item->devicePath().isEmpty()) {
             continue;
         }
 
-        if (device->ipInterfaceName().isEmpty()) {
-            item->setDeviceName(device->interfaceName());
-        } else {
-            item->setDeviceName(device->ipInterfaceName());
-        }
-
-        item->setDevicePath(device->uni());
-        item->setDeviceState(device->state());
+        item->setDeviceName(device.interfaceName);
+        item->setDevicePath(device.path);
+        item->setDeviceState(device.state);
         qCDebug(PLASMA_NM) << "Item " << item->name() << ": device changed to " << item->devicePath();
-#if WITH_MODEMMANAGER_SUPPORT
-        if (device->type() == NetworkManager::Device::Modem) {
-            ModemManager::ModemDevice::Ptr modemDevice = ModemManager::findModemDevice(device->udi());
-            if (modemDevice) {
-                ModemManager::Modem::Ptr modemInterface = modemDevice->interface(ModemManager::ModemDevice::ModemInterface).objectCast<ModemManager::Modem>();
-                if (modemInterface) {
-                    item->setSignal(modemInterface->signalQuality().signal);
-                    qCDebug(PLASMA_NM) << "Item " << item->name() << ": signal changed to " << item->signal();
-                }
-            }
+        if (device.type == NetworkManager::Device::Modem) {
+            item->setSignal(device.signal);
+            qCDebug(PLASMA_NM) << "Item " << item->name() << ": signal changed to " << item->signal();
         }
-#endif
+
         if (item->type() == NetworkManager::ConnectionSettings::Wireless && item->mode() == NetworkManager::WirelessSetting::Infrastructure) {
             // Find an accesspoint which could be removed, because it will be merged with a connection
             for (NetworkModelItem *secondItem : m_list.returnItems(NetworkItemsList::Ssid, item->ssid())) {
-                if (secondItem->itemType() == NetworkModelItem::AvailableAccessPoint && secondItem->devicePath() == item->devicePath()) {
-                    const int row = m_list.indexOf(secondItem);
+                if (secondItem->itemType() == NetworkModelItem::AvailableAccessPoint && secondItem->devicePathHandle() == item->devicePathHandle()) {
                     qCDebug(PLASMA_NM) << "Access point " << secondItem->name() << ": merged to " << item->name() << " connection";
-                    if (row >= 0) {
-                        beginRemoveRows(QModelIndex(), row, row);
-                        m_list.removeItem(secondItem);
-                        secondItem->deleteLater();
-                        endRemoveRows();
-                    }
+                    removeItem(secondItem);
                     break;
                 }
             }
 
-            NetworkManager::WirelessDevice::Ptr wifiDevice = device.objectCast<NetworkManager::WirelessDevice>();
-            if (wifiDevice) {
-                NetworkManager::WirelessNetwork::Ptr wifiNetwork = wifiDevice->findNetwork(item->ssid());
-                if (wifiNetwork) {
-                    updateFromWirelessNetwork(item, wifiNetwork, wifiDevice);
+            if (device.type == NetworkManager::Device::Wifi) {
+                const BackendWirelessNetwork network = m_backend->wirelessNetwork(device.path, item->ssid());
+                if (network.isValid()) {
+                    updateFromWirelessNetwork(item, network);
                 }
             }
         }
@@ -377,82 +489,117 @@ void NetworkModel::addAvailableConnection(const QString &connection, const Netwo
     }
 }
 
-void NetworkModel::addConnection(const NetworkManager::Connection::Ptr &connection)
+void NetworkModel::addConnections(const QStringList &connections)
 {
-    // Can't add a connection without name or uuid
-    if (connection->name().isEmpty() || connection->uuid().isEmpty()) {
-        return;
+    QList<NetworkModelItem*> items;
+    for (const QString &connection : connections) {
+        NetworkModelItem *item = createConnectionItem(connection);
+        if (item) {
+            items << item;
+        }
     }
 
-    initializeSignals(connection);
+    insertItems(items);
+    for (NetworkModelItem *item : qAsConst(items)) {
+        qCDebug(PLASMA_NM) << "New connection " << item->name() << " added";
+    }
+}
 
-    NetworkManager::ConnectionSettings::Ptr settings = connection->settings();
-    NetworkManager::VpnSetting::Ptr vpnSetting;
-    NetworkManager::WirelessSetting::Ptr wirelessSetting;
+NetworkModelItem *NetworkModel::createConnectionItem(const QString &connection)
+{
+    const ConnectionSummary summary = m_backend->connection(connection);
 
-    if (settings->connectionType() == NetworkManager::ConnectionSettings::Vpn) {
-        vpnSetting = settings->setting(NetworkManager::Setting::Vpn).dynamicCast<NetworkManager::VpnSetting>();
-    } else if (settings->connectionType() == NetworkManager::ConnectionSettings::Wireless) {
-        wirelessSetting = settings->setting(NetworkManager::Setting::Wireless).dynamicCast<NetworkManager::WirelessSetting>();
+    // Can't add a connection without name or uuid
+    if (summary.id.isEmpty() || summary.uuid.isEmpty()) {
+        return nullptr;
     }
 
     // Check whether the connection is already in the model to avoid duplicates, but this shouldn't happen
-    if (m_list.contains(NetworkItemsList::Connection, connection->path())) {
-        return;
+    if (m_list.contains(NetworkItemsList::Connection, connection)) {
+        return nullptr;
     }
 
     NetworkModelItem *item = new NetworkModelItem();
-    item->setConnectionPath(connection->path());
-    item->setName(settings->id());
-    item->setTimestamp(settings->timestamp());
-    item->setType(settings->connectionType());
-    item->setUuid(settings->uuid());
-    item->setSlave(settings->isSlave());
+    item->setConnectionPath(connection);
+    item->setName(summary.id);
+    item->setTimestamp(summary.timestamp);
+    item->setType(summary.type);
+    item->setUuid(summary.uuid);
+    item->setSlave(summary.slave);
 
     if (item->type() == NetworkManager::ConnectionSettings::Vpn) {
-        item->setVpnType(vpnSetting->serviceType().section('.', -1));
+        item->setVpnType(summary.vpnServiceType.section('.', -1));
     } else if (item->type() == NetworkManager::ConnectionSettings::Wireless) {
-        item->setMode(wirelessSetting->mode());
-        item->setSecurityType(NetworkManager::securityTypeFromConnectionSetting(settings));
-        item->setSsid(QString::fromUtf8(wirelessSetting->ssid()));
+        item->setMode(summary.mode);
+        item->setSecurityType(summary.securityType);
+        item->setSsid(summary.ssid);
     }
 
-    item->invalidateDetails();
-
-    const int index = m_list.count();
-    beginInsertRows(QModelIndex(), index, index);
-    m_list.insertItem(item);
-    endInsertRows();
-    qCDebug(PLASMA_NM) << "New connection " << item->name() << " added";
+    return item;
 }
 
-void NetworkModel::addDevice(const NetworkManager::Device::Ptr &device)
+void NetworkModel::addDevice(const BackendDevice &device)
 {
-    initializeSignals(device);
-
-    if (device->type() == NetworkManager::Device::Wifi) {
-        NetworkManager::WirelessDevice::Ptr wifiDev = device.objectCast<NetworkManager::WirelessDevice>();
-        for (const NetworkManager::WirelessNetwork::Ptr &wifiNetwork : wifiDev->networks()) {
-            addWirelessNetwork(wifiNetwork, wifiDev);
+    if (device.type == NetworkManager::Device::Wifi) {
+        QList<NetworkModelItem*> items;
+        for (const QString &ssid : m_backend->wirelessNetworks(device.path)) {
+            const BackendWirelessNetwork network = m_backend->wirelessNetwork(device.path, ssid);
+            NetworkModelItem *item = network.isValid() ? createWirelessNetworkItem(network, device) : nullptr;
+            if (item) {
+                items << item;
+            }
         }
+        insertItems(items);
     }
 
-    for (const NetworkManager::Connection::Ptr &connection : device->availableConnections()) {
-        addAvailableConnection(connection->path(), device);
+    for (const QString &connection : device.availableConnections) {
+        addAvailableConnection(connection, device);
     }
 }
 
-void NetworkModel::addWirelessNetwork(const NetworkManager::WirelessNetwork::Ptr &network, const NetworkManager::WirelessDevice::Ptr &device)
+void NetworkModel::addWirelessNetwork(const BackendWirelessNetwork &network, const BackendDevice &device)
 {
-    initializeSignals(network);
+    NetworkModelItem *item = createWirelessNetworkItem(network, device);
+    if (item) {
+        insertItems({item});
+    }
+}
+
+void NetworkModel::addPendingNetworks()
+{
+    QList<NetworkModelItem*> items;
+    // Snapshots of devices are expensive, most of the networks were queued by the same few devices
+    QHash<QString, BackendDevice> devices;
+    for (const QPair<QString, QString> &pendingNetwork : qAsConst(m_pendingNetworks)) {
+        auto deviceIt = devices.find(pendingNetwork.first);
+        if (deviceIt == devices.end()) {
+            deviceIt = devices.insert(pendingNetwork.first, m_backend->device(pendingNetwork.first));
+        }
+        const BackendDevice &device = *deviceIt;
+        const BackendWirelessNetwork network = m_backend->wirelessNetwork(pendingNetwork.first, pendingNetwork.second);
+        if (!device.isValid() || !network.isValid()) {
+            continue;
+        }
+
+        NetworkModelItem *item = createWirelessNetworkItem(network, device);
+        if (item) {
+            items << item;
+        }
+    }
+    m_pendingNetworks.clear();
 
+    insertItems(items);
+}
+
+NetworkModelItem *NetworkModel::createWirelessNetworkItem(const BackendWirelessNetwork &network, const BackendDevice &device)
+{
     // Avoid duplicating entries in the model
     if (!Configuration::hotspotConnectionPath().isEmpty()) {
-        NetworkManager::ActiveConnection::Ptr activeConnection = NetworkManager::findActiveConnection(Configuration::hotspotConnectionPath());
+        const BackendActiveConnection activeConnection = m_backend->activeConnection(Configuration::hotspotConnectionPath());
 
         // If we are trying to add an AP which is the one created by our hotspot, then we can skip this and don't add it twice
-        if (activeConnection && activeConnection->specificObject() == network->referenceAccessPoint()->uni()) {
-            return;
+        if (activeConnection.isValid() && activeConnection.specificObject == network.referenceAccessPoint.path) {
+            return nullptr;
         }
     }
 
@@ -466,58 +613,31 @@ void NetworkModel::addWirelessNetwork(const NetworkManager::WirelessNetwork::Ptr
         if (item->itemType() != NetworkModelItem::AvailableConnection)
             continue;
 
-        NetworkManager::ConnectionSettings::Ptr connectionSettings = NetworkManager::findConnection(item->connectionPath())->settings();
-        if (connectionSettings && connectionSettings->connectionType() == NetworkManager::ConnectionSettings::Wireless) {
-            NetworkManager::WirelessSetting::Ptr wirelessSetting = connectionSettings->setting(NetworkManager::Setting::Wireless).dynamicCast<NetworkManager::WirelessSetting>();
-            if (QString::fromUtf8(wirelessSetting->ssid()) == network->ssid()) {
-                const QString bssid =  NetworkManager::macAddressAsString(wirelessSetting->bssid());
-                const QString restrictedHw = NetworkManager::macAddressAsString(wirelessSetting->macAddress());
-                if ((bssid.isEmpty() || bssid == network->referenceAccessPoint()->hardwareAddress()) &&
-                    (restrictedHw.isEmpty() || restrictedHw == device->hardwareAddress())) {
-                    updateFromWirelessNetwork(item, network, device);
-                    return;
+        const ConnectionSummary summary = m_backend->connection(item->connectionPath());
+        if (summary.type == NetworkManager::ConnectionSettings::Wireless) {
+            if (summary.ssid == network.ssid) {
+                if ((summary.bssid.isEmpty() || summary.bssid == network.referenceAccessPoint.hardwareAddress) &&
+                    (summary.restrictedMacAddress.isEmpty() || summary.restrictedMacAddress == device.hardwareAddress)) {
+                    updateFromWirelessNetwork(item, network);
+                    return nullptr;
                 }
             }
         }
     }
 
-    NetworkManager::WirelessSetting::NetworkMode mode = NetworkManager::WirelessSetting::Infrastructure;
-    NetworkManager::WirelessSecurityType securityType = NetworkManager::UnknownSecurity;
-
-    NetworkManager::AccessPoint::Ptr ap = network->referenceAccessPoint();
-    if (ap && (ap->capabilities().testFlag(NetworkManager::AccessPoint::Privacy) || ap->wpaFlags() || ap->rsnFlags())) {
-        securityType = NetworkManager::findBestWirelessSecurity(device->wirelessCapabilities(), true, (device->mode() == NetworkManager::WirelessDevice::Adhoc),
-                                                                ap->capabilities(), ap->wpaFlags(), ap->rsnFlags());
-        if (network->referenceAccessPoint()->mode() == NetworkManager::AccessPoint::Infra) {
-            mode = NetworkManager::WirelessSetting::Infrastructure;
-        } else if (network->referenceAccessPoint()->mode() == NetworkManager::AccessPoint::Adhoc) {
-            mode = NetworkManager::WirelessSetting::Adhoc;
-        } else if (network->referenceAccessPoint()->mode() == NetworkManager::AccessPoint::ApMode) {
-            mode = NetworkManager::WirelessSetting::Ap;
-        }
-    }
-
     NetworkModelItem *item = new NetworkModelItem();
-    if (device->ipInterfaceName().isEmpty()) {
-        item->setDeviceName(device->interfaceName());
-    } else {
-        item->setDeviceName(device->ipInterfaceName());
-    }
-    item->setDevicePath(device->uni());
-    item->setMode(mode);
-    item->setName(network->ssid());
-    item->setSignal(network->signalStrength());
-    item->setSpecificPath(network->referenceAccessPoint()->uni());
-    item->setSsid(network->ssid());
+    item->setDeviceName(device.interfaceName);
+    item->setDevicePath(device.path);
+    item->setMode(network.mode);
+    item->setName(network.ssid);
+    item->setSignal(network.signal);
+    item->setSpecificPath(network.referenceAccessPoint.path);
+    item->setSsid(network.ssid);
     item->setType(NetworkManager::ConnectionSettings::Wireless);
-    item->setSecurityType(securityType);
-    item->invalidateDetails();
+    item->setSecurityType(network.securityType);
 
-    const int index = m_list.count();
-    beginInsertRows(QModelIndex(), index, index);
-    m_list.insertItem(item);
-    endInsertRows();
     qCDebug(PLASMA_NM) << "New wireless network " << item->name() << " added";
+    return item;
 }
 
 void NetworkModel::checkAndCreateDuplicate(const QString &connection, const QString &deviceUni)
@@ -537,54 +657,230 @@ void NetworkModel::checkAndCreateDuplicate(const QString &connection, const QStr
 
     if (createDuplicate) {
         NetworkModelItem *duplicatedItem = new NetworkModelItem(originalItem);
-        duplicatedItem->invalidateDetails();
+        insertItems({duplicatedItem});
+    }
+}
 
-        const int index = m_list.count();
-        beginInsertRows(QModelIndex(), index, index);
-        m_list.insertItem(duplicatedItem);
-        endInsertRows();
+void NetworkModel::deviceStatisticsChanged(const QString &devicePath, qulonglong rxBytes, qulonglong txBytes)
+{
+    TRACE_SPAN("NetworkModel::deviceStatisticsChanged");
+    m_trafficRates[devicePath].addSample(m_trafficClock.elapsed(), rxBytes, txBytes);
+
+    for (NetworkModelItem *item : m_list.returnItems(NetworkItemsList::Device, devicePath)) {
+        item->setRxBytes(rxBytes);
+        item->setTxBytes(txBytes);
+        item->fieldsChanged(NetworkModelItem::TrafficField);
+        updateItem(item);
+    }
+
+    if (!m_trafficRatesTimer->isActive()) {
+        m_trafficRatesTimer->start();
+    }
+}
+
+void NetworkModel::trafficRatesTimeout()
+{
+    TRACE_SPAN("NetworkModel::trafficRatesTimeout");
+    const qint64 now = m_trafficClock.elapsed();
+    bool active = false;
+
+    for (auto it = m_trafficRates.begin(); it != m_trafficRates.end(); ++it) {
+        const qint64 refreshRate = m_backend->deviceStatisticsRefreshRateMs(it.key());
+        if (!refreshRate || it->isEmpty()) {
+            continue;
+        }
+        active = true;
+
+        // NetworkManager doesn't report counters which haven't changed, account the idle interval here
+        if (now - it->lastTimestamp() >= refreshRate * 3 / 2) {
+            it->addSample(it->lastTimestamp() + refreshRate, it->lastRxBytes(), it->lastTxBytes());
+            for (NetworkModelItem *item : m_list.returnItems(NetworkItemsList::Device, it.key())) {
+                item->fieldsChanged(NetworkModelItem::TrafficField);
+                updateItem(item);
+            }
+        }
+    }
+
+    if (!active) {
+        m_trafficRatesTimer->stop();
     }
 }
 
 void NetworkModel::onItemUpdated()
 {
+    TRACE_SPAN("NetworkModel::onItemUpdated");
     NetworkModelItem *item = static_cast<NetworkModelItem*>(sender());
     if (item) {
         updateItem(item);
     }
 }
 
-void NetworkModel::setDeviceStatisticsRefreshRateMs(const QString &devicePath, uint refreshRate)
+void NetworkModel::setDeviceStatisticsRefreshRateMs(const QString &devicePath, uint refreshRate, QObject *consumer)
+{
+    m_backend->setDeviceStatisticsRefreshRateMs(consumer ? consumer : this, devicePath, refreshRate);
+}
+
+void NetworkModel::insertItems(const QList<NetworkModelItem*> &items)
+{
+    if (items.isEmpty()) {
+        return;
+    }
+
+    for (NetworkModelItem *item : items) {
+        item->setNetworkStatus(m_status);
+    }
+
+    const int row = m_list.count();
+    beginInsertRows(QModelIndex(), row, row + items.count() - 1);
+    m_list.insertItems(items);
+    endInsertRows();
+}
+
+void NetworkModel::removeItem(NetworkModelItem *item)
+{
+    removeItems({item});
+}
+
+void NetworkModel::removeItems(const QList<NetworkModelItem*> &items)
+{
+    QVector<int> rows;
+    rows.reserve(items.count());
+    for (NetworkModelItem *item : items) {
+        const int row = m_list.indexOf(item);
+        if (row >= 0) {
+            rows << row;
+        }
+    }
+    std::sort(rows.begin(), rows.end());
+    rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+
+    // One beginRemoveRows() per range of adjacent rows, from the bottom so that the rows of the other ranges stay valid
+    int last = rows.count() - 1;
+    while (last >= 0) {
+        int first = last;
+        while (first > 0 && rows.at(first - 1) == rows.at(first) - 1) {
+            --first;
+        }
+
+        const int firstRow = rows.at(first);
+        const int lastRow = rows.at(last);
+        beginRemoveRows(QModelIndex(), firstRow, lastRow);
+        for (int row = firstRow; row <= lastRow; ++row) {
+            NetworkModelItem *item = m_list.itemAt(row);
+            m_pendingUpdates.remove(item);
+            item->deleteLater();
+        }
+        m_list.removeItems(firstRow, lastRow - firstRow + 1);
+        endRemoveRows();
+
+        last = first - 1;
+    }
+}
+
+// Same steps as the icons in NetworkModelItem::computeIcon()
+static int signalStrengthBucket(int signal)
 {
-    NetworkManager::Device::Ptr device = NetworkManager::findNetworkInterface(devicePath);
+    return signal <= 0 ? 0 : qMin(signal / 20, 4) + 1;
+}
 
-    if (device) {
-        device->deviceStatistics()->setRefreshRateMs(refreshRate);
+bool NetworkModel::updateSignal(NetworkModelItem *item, int signal)
+{
+    item->setRawSignal(signal);
+
+    // Don't publish small fluctuations, every published change means re-sorting and repainting
+    if (signalStrengthBucket(signal) == signalStrengthBucket(item->signal()) && qAbs(signal - item->signal()) < m_signalStrengthThreshold) {
+        return false;
+    }
+
+    item->setSignal(signal);
+    return true;
+}
+
+void NetworkModel::updateDeviceDetails(const QString &devicePath)
+{
+    TRACE_SPAN("NetworkModel::updateDeviceDetails");
+    for (NetworkModelItem *item : m_list.returnItems(NetworkItemsList::Device, devicePath)) {
+        item->invalidateDetails();
+        updateItem(item);
     }
 }
 
 void NetworkModel::updateItem(NetworkModelItem*item)
 {
+    PerfCounters::instance()->increment(PerfCounters::ItemUpdates);
     const int row = m_list.indexOf(item);
 
-    if (row >= 0) {
-        item->invalidateDetails();
-        QModelIndex index = createIndex(row, 0);
-        Q_EMIT dataChanged(index, index, item->changedRoles());
-        item->clearChangedRoles();
+    // Nothing to publish when none of the values has actually changed
+    if (row >= 0 && item->changedRolesMask()) {
+        if (m_pendingUpdates.isEmpty()) {
+            m_pendingUpdatesClock.start();
+        }
+        // Updates are coalesced, a signal strength change or a scan result usually touches many items at once
+        m_pendingUpdates.insert(item);
+        if (!m_updateTimer->isActive()) {
+            m_updateTimer->start();
+        }
+    }
+}
+
+void NetworkModel::flushPendingUpdates()
+{
+    TRACE_SPAN("NetworkModel::flushPendingUpdates");
+    addPendingNetworks();
+
+    if (m_pendingUpdates.isEmpty()) {
+        return;
+    }
+
+    PerfCounters *counters = PerfCounters::instance();
+    counters->recordElapsed(PerfCounters::ItemUpdateLatency, m_pendingUpdatesClock);
+
+    QVector<int> rows;
+    rows.reserve(m_pendingUpdates.count());
+    for (NetworkModelItem *item : qAsConst(m_pendingUpdates)) {
+        const int row = m_list.indexOf(item);
+        if (row >= 0) {
+            rows << row;
+        }
+    }
+    m_pendingUpdates.clear();
+    std::sort(rows.begin(), rows.end());
+
+    // Emit one dataChanged() per range of adjacent rows with all the roles changed within the range
+    int first = 0;
+    while (first < rows.count()) {
+        int last = first;
+        while (last + 1 < rows.count() && rows.at(last + 1) == rows.at(last) + 1) {
+            ++last;
+        }
+
+        quint64 roles = 0;
+        for (int i = first; i <= last; ++i) {
+            NetworkModelItem *item = m_list.itemAt(rows.at(i));
+            roles |= item->changedRolesMask();
+            // The columns are refreshed only for the changed roles
+            m_list.updateColumns(rows.at(i));
+            item->clearChangedRoles();
+        }
+
+        counters->increment(PerfCounters::DataChangedSignals);
+        counters->recordRoles(roles);
+        Q_EMIT dataChanged(createIndex(rows.at(first), 0), createIndex(rows.at(last), 0), NetworkModelItem::rolesFromMask(roles));
+        first = last + 1;
     }
 }
 
-void NetworkModel::accessPointSignalStrengthChanged(int signal)
+void NetworkModel::accessPointSignalStrengthChanged(const QString &devicePath, const QString &accessPoint, int signal)
 {
-    NetworkManager::AccessPoint *apPtr = qobject_cast<NetworkManager::AccessPoint*>(sender());
-    if (!apPtr) {
+    TRACE_SPAN("NetworkModel::accessPointSignalStrengthChanged");
+    // Items refer to the access point only when its path is interned
+    const DBusPathTable::Handle apPath = DBusPathTable::instance()->find(accessPoint);
+    if (!apPath) {
         return;
     }
 
-    for (NetworkModelItem *item : m_list.returnItems(NetworkItemsList::Ssid, apPtr->ssid())) {
-        if (item->specificPath() == apPtr->uni()) {
-            item->setSignal(signal);
+    for (NetworkModelItem *item : m_list.returnItems(NetworkItemsList::Device, devicePath)) {
+        if (item->specificPathHandle() == apPath && updateSignal(item, signal)) {
             updateItem(item);
             qCDebug(PLASMA_NM) << "AccessPoint " << item->name() << ": signal changed to " << item->signal();
         }
@@ -593,148 +889,135 @@ void NetworkModel::accessPointSignalStrengthChanged(int signal)
 
 void NetworkModel::activeConnectionAdded(const QString &activeConnection)
 {
-    NetworkManager::ActiveConnection::Ptr activeCon = NetworkManager::findActiveConnection(activeConnection);
+    TRACE_SPAN("NetworkModel::activeConnectionAdded");
+    const BackendActiveConnection activeCon = m_backend->activeConnection(activeConnection);
 
-    if (activeCon) {
+    if (activeCon.isValid()) {
         addActiveConnection(activeCon);
     }
 }
 
 void NetworkModel::activeConnectionRemoved(const QString &activeConnection)
 {
+    TRACE_SPAN("NetworkModel::activeConnectionRemoved");
     for (NetworkModelItem *item : m_list.returnItems(NetworkItemsList::ActiveConnection, activeConnection)) {
         item->setActiveConnectionPath(QString());
         item->setConnectionState(NetworkManager::ActiveConnection::Deactivated);
         item->setVpnState(NetworkManager::VpnConnection::Disconnected);
+        item->setVpnBanner(QString());
         updateItem(item);
         qCDebug(PLASMA_NM) << "Item " << item->name() << ": active connection removed";
     }
 }
 
-void NetworkModel::activeConnectionStateChanged(NetworkManager::ActiveConnection::State state)
+void NetworkModel::activeConnectionStateChanged(const QString &activeConnection, NetworkManager::ActiveConnection::State state)
 {
-    NetworkManager::ActiveConnection *activePtr = qobject_cast<NetworkManager::ActiveConnection*>(sender());
-
-    if (!activePtr) {
-        return;
-    }
-
-    for (NetworkModelItem *item : m_list.returnItems(NetworkItemsList::ActiveConnection, activePtr->path())) {
+    TRACE_SPAN("NetworkModel::activeConnectionStateChanged");
+    for (NetworkModelItem *item : m_list.returnItems(NetworkItemsList::ActiveConnection, activeConnection)) {
         item->setConnectionState(state);
         updateItem(item);
         qCDebug(PLASMA_NM) << "Item " << item->name() << ": active connection changed to " << item->connectionState();
     }
 }
 
-void NetworkModel::activeVpnConnectionStateChanged(NetworkManager::VpnConnection::State state, NetworkManager::VpnConnection::StateChangeReason reason)
+void NetworkModel::activeVpnConnectionStateChanged(const QString &activeConnection, NetworkManager::VpnConnection::State state)
 {
-    Q_UNUSED(reason)
-    NetworkManager::ActiveConnection *activePtr = qobject_cast<NetworkManager::ActiveConnection*>(sender());
-
-    if (!activePtr) {
-        return;
-    }
-
-    for (NetworkModelItem *item : m_list.returnItems(NetworkItemsList::ActiveConnection, activePtr->path())) {
-        if (state == NetworkManager::VpnConnection::Prepare ||
-            state == NetworkManager::VpnConnection::NeedAuth ||
-            state == NetworkManager::VpnConnection::Connecting ||
-            state == NetworkManager::VpnConnection::GettingIpConfig) {
-            item->setConnectionState(NetworkManager::ActiveConnection::Activating);
-        } else if (state == NetworkManager::VpnConnection::Activated) {
-            item->setConnectionState(NetworkManager::ActiveConnection::Activated);
-        } else {
-            item->setConnectionState(NetworkManager::ActiveConnection::Deactivated);
-        }
+    TRACE_SPAN("NetworkModel::activeVpnConnectionStateChanged");
+    for (NetworkModelItem *item : m_list.returnItems(NetworkItemsList::ActiveConnection, activeConnection)) {
+        item->setConnectionState(connectionStateFromVpnState(state));
         item->setVpnState(state);
         updateItem(item);
         qCDebug(PLASMA_NM) << "Item " << item->name() << ": active connection changed to " << item->connectionState();
     }
 }
 
-void NetworkModel::availableConnectionAppeared(const QString &connection)
+void NetworkModel::activeVpnConnectionBannerChanged(const QString &activeConnection, const QString &banner)
 {
-    NetworkManager::Device::Ptr device = NetworkManager::findNetworkInterface(qobject_cast<NetworkManager::Device*>(sender())->uni());
-    if (!device) {
+    TRACE_SPAN("NetworkModel::activeVpnConnectionBannerChanged");
+    for (NetworkModelItem *item : m_list.returnItems(NetworkItemsList::ActiveConnection, activeConnection)) {
+        item->setVpnBanner(banner);
+        updateItem(item);
+    }
+}
+
+void NetworkModel::availableConnectionAppeared(const QString &devicePath, const QString &connection)
+{
+    TRACE_SPAN("NetworkModel::availableConnectionAppeared");
+    const BackendDevice device = m_backend->device(devicePath);
+    if (!device.isValid()) {
         return;
     }
 
+    // The connection might not be loaded yet
+    if (m_pendingConnections.removeOne(connection)) {
+        connectionAdded(connection);
+    }
+
     addAvailableConnection(connection, device);
 }
 
-void NetworkModel::availableConnectionDisappeared(const QString &connection)
+void NetworkModel::availableConnectionDisappeared(const QString &devicePath, const QString &connection)
 {
+    TRACE_SPAN("NetworkModel::availableConnectionDisappeared");
+    // The items are checked for all the devices they are presented for, not only for the one reporting the change
+    Q_UNUSED(devicePath);
+
+    // Snapshots of devices are expensive, the items are usually presented for the same few devices
+    QHash<QString, BackendDevice> devices;
     for (NetworkModelItem *item : m_list.returnItems(NetworkItemsList::Connection, connection)) {
-        bool available = false;
-        const QString devicePath = item->devicePath();
+        const QString itemDevicePath = item->devicePath();
         const QString specificPath = item->specificPath();
 
         // We have to check whether the connection is still available, because it might be
         // presented in the model for more devices and we don't want to remove it for all of them.
 
-        // Check whether the device is still available
-        NetworkManager::Device::Ptr device = NetworkManager::findNetworkInterface(devicePath);
-        if (device) {
-            // Check whether the connection is still listed as available
-            for (const NetworkManager::Connection::Ptr &connection : device->availableConnections()) {
-                if (connection->path() == item->connectionPath()) {
-                    available = true;
-                    break;
-                }
-            }
+        // Check whether the device is still available and the connection is still listed as available
+        auto deviceIt = devices.find(itemDevicePath);
+        if (deviceIt == devices.end()) {
+            deviceIt = devices.insert(itemDevicePath, m_backend->device(itemDevicePath));
+        }
+        const BackendDevice &device = *deviceIt;
+        if (device.isValid() && device.availableConnections.contains(item->connectionPath())) {
+            continue;
         }
 
-        if (!available) {
-            item->setDeviceName(QString());
-            item->setDevicePath(QString());
-            item->setDeviceState(NetworkManager::Device::UnknownState);
-            item->setSignal(0);
-            item->setSpecificPath(QString());
-            qCDebug(PLASMA_NM) << "Item " << item->name() << " removed as available connection";
-            // Check whether the connection is still available as an access point, this happens
-            // when we change its properties, like ssid, bssid, security etc.
-            if (item->type() == NetworkManager::ConnectionSettings::Wireless && !specificPath.isEmpty()) {
-                if (device && device->type() == NetworkManager::Device::Wifi) {
-                    NetworkManager::WirelessDevice::Ptr wifiDevice = device.objectCast<NetworkManager::WirelessDevice>();
-                    if (wifiDevice) {
-                        NetworkManager::AccessPoint::Ptr ap = wifiDevice->findAccessPoint(specificPath);
-                        if (ap) {
-                            NetworkManager::WirelessNetwork::Ptr network = wifiDevice->findNetwork(ap->ssid());
-                            if (network) {
-                                addWirelessNetwork(network, wifiDevice);
-                            }
-                        }
-                    }
+        item->setDeviceName(QString());
+        item->setDevicePath(QString());
+        item->setDeviceState(NetworkManager::Device::UnknownState);
+        item->setSignal(0);
+        item->setSpecificPath(QString());
+        qCDebug(PLASMA_NM) << "Item " << item->name() << " removed as available connection";
+        // Check whether the connection is still available as an access point, this happens
+        // when we change its properties, like ssid, bssid, security etc.
+        if (item->type() == NetworkManager::ConnectionSettings::Wireless && !specificPath.isEmpty()) {
+            if (device.isValid() && device.type == NetworkManager::Device::Wifi) {
+                const BackendWirelessNetwork network = m_backend->wirelessNetworkOfAccessPoint(device.path, specificPath);
+                if (network.isValid()) {
+                    addWirelessNetwork(network, device);
                 }
             }
+        }
 
-            if (item->duplicate()) {
-                const int row = m_list.indexOf(item);
-                if (row >= 0) {
-                    qCDebug(PLASMA_NM) << "Duplicate item " << item->name() << " removed completely";
-                    beginRemoveRows(QModelIndex(), row, row);
-                    m_list.removeItem(item);
-                    item->deleteLater();
-                    endRemoveRows();
-                }
-            } else {
-                updateItem(item);
-            }
+        if (item->duplicate()) {
+            qCDebug(PLASMA_NM) << "Duplicate item " << item->name() << " removed completely";
+            removeItem(item);
+        } else {
+            updateItem(item);
         }
-        available = false;
     }
 }
 
 void NetworkModel::connectionAdded(const QString &connection)
 {
-    NetworkManager::Connection::Ptr newConnection = NetworkManager::findConnection(connection);
-    if (newConnection) {
-        addConnection(newConnection);
-    }
+    TRACE_SPAN("NetworkModel::connectionAdded");
+    addConnections({connection});
 }
 
 void NetworkModel::connectionRemoved(const QString &connection)
 {
+    TRACE_SPAN("NetworkModel::connectionRemoved");
+    m_pendingConnections.removeOne(connection);
+
     bool remove = false;
     for (NetworkModelItem *item : m_list.returnItems(NetworkItemsList::Connection, connection)) {
         // When the item type is wireless, we can remove only the connection and leave it as an available access point
@@ -743,8 +1026,8 @@ void NetworkModel::connectionRemoved(const QString &connection)
                 // Remove it entirely when there is another connection with the same configuration and for the same device
                 // or it's a shared connection
                 if ((item->mode() != NetworkManager::WirelessSetting::Infrastructure) ||
-                    (item->connectionPath() != secondItem->connectionPath() &&
-                     item->devicePath() == secondItem->devicePath() &&
+                    (item->connectionPathHandle() != secondItem->connectionPathHandle() &&
+                     item->devicePathHandle() == secondItem->devicePathHandle() &&
                      item->mode() == secondItem->mode() &&
                      item->securityType() == secondItem->securityType() &&
                      item->ssid() == secondItem->ssid())) {
@@ -767,40 +1050,32 @@ void NetworkModel::connectionRemoved(const QString &connection)
         }
 
         if (remove) {
-            const int row = m_list.indexOf(item);
-            if (row >= 0) {
-                qCDebug(PLASMA_NM) << "Item " << item->name() << " removed completely";
-                beginRemoveRows(QModelIndex(), row, row);
-                m_list.removeItem(item);
-                item->deleteLater();
-                endRemoveRows();
-            }
+            qCDebug(PLASMA_NM) << "Item " << item->name() << " removed completely";
+            removeItem(item);
         }
         remove = false;
     }
 }
 
-void NetworkModel::connectionUpdated()
+void NetworkModel::connectionUpdated(const QString &connection)
 {
-    NetworkManager::Connection *connectionPtr = qobject_cast<NetworkManager::Connection*>(sender());
-    if (!connectionPtr) {
+    TRACE_SPAN("NetworkModel::connectionUpdated");
+    const ConnectionSummary summary = m_backend->connection(connection);
+    if (!summary.isValid()) {
         return;
     }
 
-    NetworkManager::ConnectionSettings::Ptr settings = connectionPtr->settings();
-    for (NetworkModelItem *item : m_list.returnItems(NetworkItemsList::Connection, connectionPtr->path())) {
-        item->setConnectionPath(connectionPtr->path());
-        item->setName(settings->id());
-        item->setTimestamp(settings->timestamp());
-        item->setType(settings->connectionType());
-        item->setUuid(settings->uuid());
+    for (NetworkModelItem *item : m_list.returnItems(NetworkItemsList::Connection, connection)) {
+        item->setConnectionPath(connection);
+        item->setName(summary.id);
+        item->setTimestamp(summary.timestamp);
+        item->setType(summary.type);
+        item->setUuid(summary.uuid);
 
         if (item->type() == NetworkManager::ConnectionSettings::Wireless) {
-            NetworkManager::WirelessSetting::Ptr wirelessSetting;
-            wirelessSetting = settings->setting(NetworkManager::Setting::Wireless).dynamicCast<NetworkManager::WirelessSetting>();
-            item->setMode(wirelessSetting->mode());
-            item->setSecurityType(NetworkManager::securityTypeFromConnectionSetting(settings));
-            item->setSsid(QString::fromUtf8(wirelessSetting->ssid()));
+            item->setMode(summary.mode);
+            item->setSecurityType(summary.securityType);
+            item->setSsid(summary.ssid);
             // TODO check whether BSSID has changed and update the wireless info
         }
 
@@ -811,207 +1086,111 @@ void NetworkModel::connectionUpdated()
 
 void NetworkModel::deviceAdded(const QString &device)
 {
-    NetworkManager::Device::Ptr dev = NetworkManager::findNetworkInterface(device);
-    if (dev) {
+    TRACE_SPAN("NetworkModel::deviceAdded");
+    const BackendDevice dev = m_backend->device(device);
+    if (dev.isValid()) {
         addDevice(dev);
     }
 }
 
 void NetworkModel::deviceRemoved(const QString &device)
 {
-    // Make all items unavailable
-    for (NetworkModelItem *item : m_list.returnItems(NetworkItemsList::Device, device)) {
-        availableConnectionDisappeared(item->connectionPath());
-    }
-}
-
-void NetworkModel::deviceStateChanged(NetworkManager::Device::State state, NetworkManager::Device::State oldState, NetworkManager::Device::StateChangeReason reason)
-{
-    Q_UNUSED(oldState);
-    Q_UNUSED(reason);
-
-    NetworkManager::Device::Ptr device = NetworkManager::findNetworkInterface(qobject_cast<NetworkManager::Device*>(sender())->uni());
-
-    if (!device) {
-        return;
-    }
-
-    for (NetworkModelItem *item : m_list.returnItems(NetworkItemsList::Device, device->uni())) {
-        item->setDeviceState(state);
-        updateItem(item);
-//             qCDebug(PLASMA_NM) << "Item " << item->name() << ": device state changed to " << item->deviceState();
+    TRACE_SPAN("NetworkModel::deviceRemoved");
+    m_trafficRates.remove(device);
+    for (auto it = m_pendingNetworks.begin(); it != m_pendingNetworks.end();) {
+        it = it->first == device ? m_pendingNetworks.erase(it) : it + 1;
     }
-}
-
-#if WITH_MODEMMANAGER_SUPPORT
-void NetworkModel::gsmNetworkAccessTechnologiesChanged(QFlags<MMModemAccessTechnology> accessTechnologies)
-{
-    Q_UNUSED(accessTechnologies);
-    ModemManager::Modem *gsmNetwork = qobject_cast<ModemManager::Modem*>(sender());
-    if (!gsmNetwork)
-        return;
-
-    for (const NetworkManager::Device::Ptr &dev : NetworkManager::networkInterfaces()) {
-        if (dev->type() != NetworkManager::Device::Modem) {
-            continue;
-        }
-
-        ModemManager::ModemDevice::Ptr modem = ModemManager::findModemDevice(dev->udi());
-        if (!modem) {
-            continue;
-        }
-
-        if (!modem->hasInterface(ModemManager::ModemDevice::ModemInterface)) {
-            continue;
-        }
-
-        ModemManager::Modem::Ptr modemNetwork = modem->interface(ModemManager::ModemDevice::ModemInterface).objectCast<ModemManager::Modem>();
-        if (!modemNetwork || modemNetwork->device() != gsmNetwork->device()) {
-            continue;
-        }
 
-        // TODO store access technology internally?
-        for (NetworkModelItem *item : m_list.returnItems(NetworkItemsList::Device, dev->uni())) {
-            updateItem(item);
+    // Access points and duplicates of the device go away at once, connections become unavailable
+    QList<NetworkModelItem*> removedItems;
+    QStringList connections;
+    for (NetworkModelItem *item : m_list.returnItems(NetworkItemsList::Device, device)) {
+        if (item->itemType() == NetworkModelItem::AvailableAccessPoint || item->duplicate()) {
+            removedItems << item;
+        } else if (!connections.contains(item->connectionPath())) {
+            connections << item->connectionPath();
         }
     }
-}
-
-void NetworkModel::gsmNetworkCurrentModesChanged()
-{
-    ModemManager::Modem *gsmNetwork = qobject_cast<ModemManager::Modem*>(sender());
-    if (!gsmNetwork) {
-        return;
-    }
-
-    for (const NetworkManager::Device::Ptr &dev : NetworkManager::networkInterfaces()) {
-        if (dev->type() != NetworkManager::Device::Modem)
-            continue;
+    removeItems(removedItems);
 
-        ModemManager::ModemDevice::Ptr modem = ModemManager::findModemDevice(dev->udi());
-        if (!modem) {
-            continue;
-        }
-
-        if (!modem->hasInterface(ModemManager::ModemDevice::ModemInterface)) {
-            continue;
-        }
-
-        ModemManager::Modem::Ptr modemNetwork = modem->interface(ModemManager::ModemDevice::ModemInterface).objectCast<ModemManager::Modem>();
-        if (!modemNetwork || modemNetwork->device() != gsmNetwork->device()) {
-            continue;
-        }
-
-        for (NetworkModelItem *item : m_list.returnItems(NetworkItemsList::Device, dev->uni())) {
-            updateItem(item);
-        }
+    for (const QString &connection : qAsConst(connections)) {
+        availableConnectionDisappeared(device, connection);
     }
 }
 
-void NetworkModel::gsmNetworkSignalQualityChanged(const ModemManager::SignalQualityPair &signalQuality)
+void NetworkModel::deviceStateChanged(const QString &device, NetworkManager::Device::State state)
 {
-    ModemManager::Modem *gsmNetwork = qobject_cast<ModemManager::Modem*>(sender());
-    if (!gsmNetwork) {
-        return;
-    }
-
-    for (const NetworkManager::Device::Ptr &dev : NetworkManager::networkInterfaces()) {
-        if (dev->type() != NetworkManager::Device::Modem) {
-            continue;
-        }
-
-        ModemManager::ModemDevice::Ptr modem = ModemManager::findModemDevice(dev->udi());
-        if (!modem) {
-            continue;
-        }
-
-        if (!modem->hasInterface(ModemManager::ModemDevice::ModemInterface)) {
-            continue;
-        }
-
-        ModemManager::Modem::Ptr modemNetwork = modem->interface(ModemManager::ModemDevice::ModemInterface).objectCast<ModemManager::Modem>();
-        if (!modemNetwork || modemNetwork->device() != gsmNetwork->device()) {
-            continue;
-        }
-
-        for (NetworkModelItem *item : m_list.returnItems(NetworkItemsList::Device, dev->uni())) {
-            item->setSignal(signalQuality.signal);
-            updateItem(item);
-        }
+    TRACE_SPAN("NetworkModel::deviceStateChanged");
+    for (NetworkModelItem *item : m_list.returnItems(NetworkItemsList::Device, device)) {
+        item->setDeviceState(state);
+        updateItem(item);
+//             qCDebug(PLASMA_NM) << "Item " << item->name() << ": device state changed to " << item->deviceState();
     }
 }
 
-#endif
-
-void NetworkModel::ipConfigChanged()
+void NetworkModel::deviceInterfaceNameChanged(const QString &device)
 {
-   NetworkManager::Device::Ptr device = NetworkManager::findNetworkInterface(qobject_cast<NetworkManager::Device*>(sender())->uni());
-
-    if (!device) {
+    TRACE_SPAN("NetworkModel::deviceInterfaceNameChanged");
+    const BackendDevice dev = m_backend->device(device);
+    if (!dev.isValid()) {
         return;
     }
 
-    for (NetworkModelItem *item : m_list.returnItems(NetworkItemsList::Device, device->uni())) {
+    for (NetworkModelItem *item : m_list.returnItems(NetworkItemsList::Device, device)) {
+        item->setDeviceName(dev.interfaceName);
         updateItem(item);
-//            qCDebug(PLASMA_NM) << "Item " << item->name() << ": device ipconfig changed";
     }
 }
 
-void NetworkModel::ipInterfaceChanged()
+void NetworkModel::deviceSignalChanged(const QString &device, int signal)
 {
-    NetworkManager::Device *device = qobject_cast<NetworkManager::Device*>(sender());
-    if (!device) {
-        return;
-    }
-
-    for (NetworkModelItem *item : m_list.returnItems(NetworkItemsList::Device, device->uni())) {
-        if (device->ipInterfaceName().isEmpty()) {
-            item->setDeviceName(device->interfaceName());
-        } else {
-            item->setDeviceName(device->ipInterfaceName());
+    TRACE_SPAN("NetworkModel::deviceSignalChanged");
+    for (NetworkModelItem *item : m_list.returnItems(NetworkItemsList::Device, device)) {
+        // The details list the signal quality too, they follow the published value
+        if (updateSignal(item, signal)) {
+            item->invalidateDetails();
+            updateItem(item);
         }
     }
 }
 
 void NetworkModel::statusChanged(NetworkManager::Status status)
 {
-    Q_UNUSED(status);
+    TRACE_SPAN("NetworkModel::statusChanged");
+    m_status = status;
 
     qCDebug(PLASMA_NM) << "NetworkManager state changed to " << status;
-    // This has probably effect only for VPN connections
-    for (NetworkModelItem *item : m_list.returnItems(NetworkItemsList::Type, NetworkManager::ConnectionSettings::Vpn)) {
+    // Every item keeps the status, only VPN connections publish a change of their availability
+    for (NetworkModelItem *item : m_list.items()) {
+        item->setNetworkStatus(status);
         updateItem(item);
     }
 }
 
-void NetworkModel::wirelessNetworkAppeared(const QString &ssid)
+void NetworkModel::wirelessNetworkAppeared(const QString &device, const QString &ssid)
 {
-    NetworkManager::Device::Ptr device = NetworkManager::findNetworkInterface(qobject_cast<NetworkManager::Device*>(sender())->uni());
-    if (device && device->type() == NetworkManager::Device::Wifi) {
-        NetworkManager::WirelessDevice::Ptr wirelessDevice = device.objectCast<NetworkManager::WirelessDevice>();
-        NetworkManager::WirelessNetwork::Ptr network = wirelessDevice->findNetwork(ssid);
-        addWirelessNetwork(network, wirelessDevice);
+    TRACE_SPAN("NetworkModel::wirelessNetworkAppeared");
+    // Networks found by one scan are inserted together once the pending updates are flushed
+    const QPair<QString, QString> network(device, ssid);
+    if (!m_pendingNetworks.contains(network)) {
+        m_pendingNetworks << network;
+    }
+    if (!m_updateTimer->isActive()) {
+        m_updateTimer->start();
     }
 }
 
-void NetworkModel::wirelessNetworkDisappeared(const QString &ssid)
+void NetworkModel::wirelessNetworkDisappeared(const QString &device, const QString &ssid)
 {
-    NetworkManager::Device::Ptr device = NetworkManager::findNetworkInterface(qobject_cast<NetworkManager::Device*>(sender())->uni());
-    if (!device) {
-        return;
-    }
+    TRACE_SPAN("NetworkModel::wirelessNetworkDisappeared");
+    m_pendingNetworks.removeAll(qMakePair(device, ssid));
 
-    for (NetworkModelItem *item : m_list.returnItems(NetworkItemsList::Ssid, ssid, device->uni())) {
+    QList<NetworkModelItem*> removedItems;
+    for (NetworkModelItem *item : m_list.returnItems(NetworkItemsList::Ssid, ssid, device)) {
         // Remove the entire item, because it's only AP or it's a duplicated available connection
         if (item->itemType() == NetworkModelItem::AvailableAccessPoint || item->duplicate()) {
-            const int row = m_list.indexOf(item);
-            if (row >= 0) {
-                qCDebug(PLASMA_NM) << "Wireless network " << item->name() << " removed completely";
-                beginRemoveRows(QModelIndex(), row, row);
-                m_list.removeItem(item);
-                item->deleteLater();
-                endRemoveRows();
-            }
+            qCDebug(PLASMA_NM) << "Wireless network " << item->name() << " removed completely";
+            removedItems << item;
         // Remove only AP and device from the item and leave it as an unavailable connection
         } else {
             if (item->mode() == NetworkManager::WirelessSetting::Infrastructure) {
@@ -1024,50 +1203,64 @@ void NetworkModel::wirelessNetworkDisappeared(const QString &ssid)
             qCDebug(PLASMA_NM) << "Item " << item->name() << ": wireless network removed";
         }
     }
+    removeItems(removedItems);
 }
 
-void NetworkModel::wirelessNetworkReferenceApChanged(const QString &accessPoint)
+void NetworkModel::wirelessNetworkReferenceApChanged(const QString &device, const QString &ssid, const QString &accessPoint)
 {
-    NetworkManager::WirelessNetwork *networkPtr = qobject_cast<NetworkManager::WirelessNetwork*>(sender());
-
-    if (!networkPtr) {
-        return;
-    }
-
-    for (NetworkModelItem *item : m_list.returnItems(NetworkItemsList::Ssid, networkPtr->ssid(), networkPtr->device())) {
-        NetworkManager::Connection::Ptr connection = NetworkManager::findConnection(item->connectionPath());
-        if (!connection) {
-            continue;
-        }
-
-        NetworkManager::WirelessSetting::Ptr wirelessSetting = connection->settings()->setting(NetworkManager::Setting::Wireless).staticCast<NetworkManager::WirelessSetting>();
-        if (!wirelessSetting) {
+    TRACE_SPAN("NetworkModel::wirelessNetworkReferenceApChanged");
+    for (NetworkModelItem *item : m_list.returnItems(NetworkItemsList::Ssid, ssid, device)) {
+        const ConnectionSummary summary = m_backend->connection(item->connectionPath());
+        if (summary.type != NetworkManager::ConnectionSettings::Wireless) {
             continue;
         }
 
-        if (wirelessSetting->bssid().isEmpty()) {
+        if (summary.bssid.isEmpty()) {
             item->setSpecificPath(accessPoint);
             updateItem(item);
         }
     }
 }
 
-void NetworkModel::wirelessNetworkSignalChanged(int signal)
+void NetworkModel::wirelessNetworkSignalChanged(const QString &device, const QString &ssid, const QString &referenceAccessPoint, int signal)
 {
-    NetworkManager::WirelessNetwork *networkPtr = qobject_cast<NetworkManager::WirelessNetwork*>(sender());
-    if (!networkPtr) {
+    TRACE_SPAN("NetworkModel::wirelessNetworkSignalChanged");
+    const DBusPathTable::Handle apPath = DBusPathTable::instance()->find(referenceAccessPoint);
+    if (!apPath) {
         return;
     }
 
-    for (NetworkModelItem *item : m_list.returnItems(NetworkItemsList::Ssid, networkPtr->ssid(), networkPtr->device())) {
-        if (item->specificPath() == networkPtr->referenceAccessPoint()->uni()) {
-            item->setSignal(signal);
+    for (NetworkModelItem *item : m_list.returnItems(NetworkItemsList::Ssid, ssid, device)) {
+        if (item->specificPathHandle() == apPath && updateSignal(item, signal)) {
             updateItem(item);
 //              qCDebug(PLASMA_NM) << "Wireless network " << item->name() << ": signal changed to " << item->signal();
         }
     }
 }
 
+void NetworkModel::updateFromWirelessNetwork(NetworkModelItem *item, const BackendWirelessNetwork &network)
+{
+    // Check whether the connection is associated with some concrete AP
+    const ConnectionSummary summary = m_backend->connection(item->connectionPath());
+    if (summary.type == NetworkManager::ConnectionSettings::Wireless) {
+        if (!summary.bssid.isEmpty()) {
+            for (const BackendAccessPoint &ap : network.accessPoints) {
+                if (ap.hardwareAddress == summary.bssid) {
+                    item->setSignal(ap.signal);
+                    item->setSpecificPath(ap.path);
+                    // We need to watch this AP for signal changes
+                    m_backend->watchAccessPoint(network.devicePath, ap.path);
+                }
+            }
+        } else {
+            item->setSignal(network.signal);
+            item->setSpecificPath(network.referenceAccessPoint.path);
+        }
+    }
+    item->setSecurityType(network.securityType);
+    updateItem(item);
+}
+
 NetworkManager::WirelessSecurityType NetworkModel::alternativeWirelessSecurity(const NetworkManager::WirelessSecurityType type)
 {
     if (type == NetworkManager::WpaPsk) {
@@ -1081,36 +1274,3 @@ NetworkManager::WirelessSecurityType NetworkModel::alternativeWirelessSecurity(c
     }
     return type;
 }
-
-void NetworkModel::updateFromWirelessNetwork(NetworkModelItem *item, const NetworkManager::WirelessNetwork::Ptr &network, const NetworkManager::WirelessDevice::Ptr &device)
-{
-    NetworkManager::WirelessSecurityType securityType = NetworkManager::UnknownSecurity;
-    NetworkManager::AccessPoint::Ptr ap = network->referenceAccessPoint();
-    if (ap && ap->capabilities().testFlag(NetworkManager::AccessPoint::Privacy)) {
-        securityType = NetworkManager::findBestWirelessSecurity(device->wirelessCapabilities(), true, (device->mode() == NetworkManager::WirelessDevice::Adhoc),
-                                                                ap->capabilities(), ap->wpaFlags(), ap->rsnFlags());
-    }
-
-    // Check whether the connection is associated with some concrete AP
-    NetworkManager::Connection::Ptr connection = NetworkManager::findConnection(item->connectionPath());
-    if (connection) {
-        NetworkManager::WirelessSetting::Ptr wirelessSetting = connection->settings()->setting(NetworkManager::Setting::Wireless).staticCast<NetworkManager::WirelessSetting>();
-        if (wirelessSetting) {
-            if (!wirelessSetting->bssid().isEmpty()) {
-                for (const NetworkManager::AccessPoint::Ptr ap : network->accessPoints()) {
-                    if (ap->hardwareAddress() == NetworkManager::macAddressAsString(wirelessSetting->bssid())) {
-                        item->setSignal(ap->signalStrength());
-                        item->setSpecificPath(ap->uni());
-                        // We need to watch this AP for signal changes
-                        connect(ap.data(), &NetworkManager::AccessPoint::signalStrengthChanged, this, &NetworkModel::accessPointSignalStrengthChanged, Qt::UniqueConnection);
-                    }
-                }
-            } else {
-                item->setSignal(network->signalStrength());
-                item->setSpecificPath(network->referenceAccessPoint()->uni());
-            }
-        }
-    }
-    item->setSecurityType(securityType);
-    updateItem(item);
-}
@@ -22,23 +22,49 @@
 #define PLASMA_NM_NETWORK_MODEL_H
 
 #include <QAbstractListModel>
+#include <QElapsedTimer>
+#include <QPointer>
+#include <QSet>
+#include <QTimer>
 
+#include "networkbackend.h"
 #include "networkitemslist.h"
+#include "trafficrates.h"
 
 #include <NetworkManagerQt/Manager>
 #include <NetworkManagerQt/VpnConnection>
 #include <NetworkManagerQt/WirelessDevice>
 #include <NetworkManagerQt/Utils>
 
-#if WITH_MODEMMANAGER_SUPPORT
-#include <ModemManagerQt/modem.h>
-#endif
-
 class Q_DECL_EXPORT NetworkModel : public QAbstractListModel
 {
 Q_OBJECT
+    /**
+     * Time in milliseconds for which item updates are collected before dataChanged() is emitted for them,
+     * 0 means that they are emitted once the control returns to the event loop
+     */
+    Q_PROPERTY(int updateInterval READ updateInterval WRITE setUpdateInterval)
+    /**
+     * Minimal change of signal strength in percent which is published when the icon of the item doesn't change,
+     * the current strength can always be read through RawSignalRole, its changes are published with the next update of the item
+     */
+    Q_PROPERTY(int signalStrengthThreshold READ signalStrengthThreshold WRITE setSignalStrengthThreshold)
+    /**
+     * Whether saved connections which are neither active nor available are still being added,
+     * the others are in the model right after it's created
+     */
+    Q_PROPERTY(bool loading READ loading NOTIFY loadingChanged)
+    /**
+     * Progress of adding the saved connections from 0 to 1
+     */
+    Q_PROPERTY(qreal loadingProgress READ loadingProgress NOTIFY loadingProgressChanged)
 public:
     explicit NetworkModel(QObject *parent = nullptr);
+    /**
+     * Creates a model following @p backend instead of NetworkManager, the caller keeps the ownership.
+     * Without a backend the model follows NetworkManager.
+     */
+    explicit NetworkModel(NetworkBackend *backend, QObject *parent = nullptr);
     ~NetworkModel() override;
 
     enum ItemRole {
@@ -69,7 +95,15 @@ public:
         VpnState,
         VpnType,
         RxBytesRole,
-        TxBytesRole
+        TxBytesRole,
+        // Published when the sort keys of the row changed, the keys are read through columns(), not exposed to QML
+        SortKeyRole,
+        RawSignalRole,
+        // Transfer rates of the device in bytes per second and their history, the newest first
+        RxRateRole,
+        TxRateRole,
+        RxRateHistoryRole,
+        TxRateHistoryRole
     };
     Q_ENUMS(ItemRole)
 
@@ -77,54 +111,119 @@ public:
     QVariant data(const QModelIndex &index, int role) const override;
     QHash<int, QByteArray> roleNames() const override;
 
+    int updateInterval() const;
+    void setUpdateInterval(int interval);
+
+    int signalStrengthThreshold() const;
+    void setSignalStrengthThreshold(int threshold);
+
+    bool loading() const;
+    qreal loadingProgress() const;
+
+    /**
+     * Values the proxy models filter and sort by for all the rows, see NetworkItemsList::Columns
+     */
+    const NetworkItemsList::Columns &columns() const { return m_list.columns(); }
+    const NetworkModelItem *itemAt(int row) const { return m_list.itemAt(row); }
+    QString internedString(quint32 id) const { return m_list.internedString(id); }
+    /**
+     * Compare the names and the VPN plugin names of two rows in the order of the current locale
+     */
+    int compareNames(int leftRow, int rightRow) const { return m_list.compareNames(leftRow, rightRow); }
+    int compareVpnTypes(int leftRow, int rightRow) const { return m_list.compareVpnTypes(leftRow, rightRow); }
+
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+Q_SIGNALS:
+    void loadingChanged(bool loading);
+    void loadingProgressChanged(qreal progress);
+
 public Q_SLOTS:
     void onItemUpdated();
-    void setDeviceStatisticsRefreshRateMs(const QString &devicePath, uint refreshRate);
+    /**
+     * Requests statistics of the device to be refreshed every @p refreshRate milliseconds, 0 withdraws the request.
+     * Requests of different consumers are combined, the request of @p consumer is dropped once it's destroyed,
+     * when no consumer is given the model itself is used.
+     */
+    void setDeviceStatisticsRefreshRateMs(const QString &devicePath, uint refreshRate, QObject *consumer = nullptr);
 
 private Q_SLOTS:
-    void accessPointSignalStrengthChanged(int signal);
+    void accessPointSignalStrengthChanged(const QString &device, const QString &accessPoint, int signal);
     void activeConnectionAdded(const QString &activeConnection);
     void activeConnectionRemoved(const QString &activeConnection);
-    void activeConnectionStateChanged(NetworkManager::ActiveConnection::State state);
-    void activeVpnConnectionStateChanged(NetworkManager::VpnConnection::State state,NetworkManager::VpnConnection::StateChangeReason reason);
-    void availableConnectionAppeared(const QString &connection);
-    void availableConnectionDisappeared(const QString &connection);
+    void activeConnectionStateChanged(const QString &activeConnection, NetworkManager::ActiveConnection::State state);
+    void activeVpnConnectionStateChanged(const QString &activeConnection, NetworkManager::VpnConnection::State state);
+    void activeVpnConnectionBannerChanged(const QString &activeConnection, const QString &banner);
+    void availableConnectionAppeared(const QString &device, const QString &connection);
+    void availableConnectionDisappeared(const QString &device, const QString &connection);
     void connectionAdded(const QString &connection);
     void connectionRemoved(const QString &connection);
-    void connectionUpdated();
+    void connectionUpdated(const QString &connection);
+    void connectionsListed(const QStringList &connections);
     void deviceAdded(const QString &device);
     void deviceRemoved(const QString &device);
-    void deviceStateChanged(NetworkManager::Device::State state, NetworkManager::Device::State oldState, NetworkManager::Device::StateChangeReason reason);
-#if WITH_MODEMMANAGER_SUPPORT
-    void gsmNetworkAccessTechnologiesChanged(QFlags<MMModemAccessTechnology> accessTechnologies);
-    void gsmNetworkCurrentModesChanged();
-    void gsmNetworkSignalQualityChanged(const ModemManager::SignalQualityPair &signalQuality);
-#endif
-    void ipConfigChanged();
-    void ipInterfaceChanged();
+    void deviceStateChanged(const QString &device, NetworkManager::Device::State state);
+    void deviceInterfaceNameChanged(const QString &device);
+    void deviceSignalChanged(const QString &device, int signal);
+    void deviceStatisticsChanged(const QString &device, qulonglong rxBytes, qulonglong txBytes);
     void statusChanged(NetworkManager::Status status);
-    void wirelessNetworkAppeared(const QString &ssid);
-    void wirelessNetworkDisappeared(const QString &ssid);
-    void wirelessNetworkSignalChanged(int signal);
-    void wirelessNetworkReferenceApChanged(const QString &accessPoint);
+    void wirelessNetworkAppeared(const QString &device, const QString &ssid);
+    void wirelessNetworkDisappeared(const QString &device, const QString &ssid);
+    void wirelessNetworkSignalChanged(const QString &device, const QString &ssid, const QString &referenceAccessPoint, int signal);
+    void wirelessNetworkReferenceApChanged(const QString &device, const QString &ssid, const QString &accessPoint);
 
     void initialize();
+    void addPendingConnections();
+    void flushPendingUpdates();
+    void trafficRatesTimeout();
+
 private:
+    QPointer<NetworkBackend> m_backend;
+    NetworkManager::Status m_status;
     NetworkItemsList m_list;
-
-    void addActiveConnection(const NetworkManager::ActiveConnection::Ptr &activeConnection);
-    void addAvailableConnection(const QString &connection, const NetworkManager::Device::Ptr &device);
-    void addConnection(const NetworkManager::Connection::Ptr &connection);
-    void addDevice(const NetworkManager::Device::Ptr &device);
-    void addWirelessNetwork(const NetworkManager::WirelessNetwork::Ptr &network, const NetworkManager::WirelessDevice::Ptr &device);
+    QSet<NetworkModelItem*> m_pendingUpdates;
+    // Started when the first of the pending updates was queued
+    QElapsedTimer m_pendingUpdatesClock;
+    QTimer *m_updateTimer;
+    int m_signalStrengthThreshold;
+    QHash<QString, TrafficRates> m_trafficRates;
+    QElapsedTimer m_trafficClock;
+    QTimer *m_trafficRatesTimer;
+    // Paths of saved connections still to be added
+    QStringList m_pendingConnections;
+    int m_pendingConnectionsTotal;
+    QTimer *m_pendingConnectionsTimer;
+    bool m_loading;
+    // Device paths and SSIDs of wireless networks which appeared since the last flush
+    QList<QPair<QString, QString>> m_pendingNetworks;
+
+    void addActiveConnection(const BackendActiveConnection &activeConnection);
+    void addAvailableConnection(const QString &connection, const BackendDevice &device);
+    void addConnections(const QStringList &connections);
+    void addPendingNetworks();
+    void addDevice(const BackendDevice &device);
+    void addWirelessNetwork(const BackendWirelessNetwork &network, const BackendDevice &device);
     void checkAndCreateDuplicate(const QString &connection, const QString &deviceUni);
+    NetworkModelItem *createConnectionItem(const QString &connection);
+    NetworkModelItem *createWirelessNetworkItem(const BackendWirelessNetwork &network, const BackendDevice &device);
     void initializeSignals();
-    void initializeSignals(const NetworkManager::ActiveConnection::Ptr &activeConnection);
-    void initializeSignals(const NetworkManager::Connection::Ptr &connection);
-    void initializeSignals(const NetworkManager::Device::Ptr &device);
-    void initializeSignals(const NetworkManager::WirelessNetwork::Ptr &network);
+    /**
+     * Appends the items with one row insertion
+     */
+    void insertItems(const QList<NetworkModelItem*> &items);
+    void removeItem(NetworkModelItem *item);
+    /**
+     * Removes the items with one row removal per range of adjacent rows
+     */
+    void removeItems(const QList<NetworkModelItem*> &items);
+    void setBackend(NetworkBackend *backend);
+    bool updateSignal(NetworkModelItem *item, int signal);
+    void updateDeviceDetails(const QString &devicePath);
+    /**
+     * Queues the changed roles of the item to be published by flushPendingUpdates()
+     */
     void updateItem(NetworkModelItem *item);
-    void updateFromWirelessNetwork(NetworkModelItem *item, const NetworkManager::WirelessNetwork::Ptr &network, const NetworkManager::WirelessDevice::Ptr &device);
+    void updateFromWirelessNetwork(NetworkModelItem *item, const BackendWirelessNetwork &network);
 
     NetworkManager::WirelessSecurityType alternativeWirelessSecurity(const NetworkManager::WirelessSecurityType type);
 };
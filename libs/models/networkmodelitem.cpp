@@ -18,61 +18,62 @@
     License along with this library.  If not, see <http://www.gnu.org/licenses/>.
 */
 #include "networkmodelitem.h"
+#include "perfcounters.h"
 #include "uiutils.h"
 
-#include <NetworkManagerQt/AdslDevice>
-#include <NetworkManagerQt/BluetoothDevice>
-#include <NetworkManagerQt/BondDevice>
-#include <NetworkManagerQt/BridgeDevice>
-#include <NetworkManagerQt/InfinibandDevice>
-#include <NetworkManagerQt/Manager>
-#include <NetworkManagerQt/ModemDevice>
-#include <NetworkManagerQt/Settings>
-#include <NetworkManagerQt/TeamDevice>
-#include <NetworkManagerQt/VlanDevice>
 #include <NetworkManagerQt/VpnConnection>
-#include <NetworkManagerQt/VpnSetting>
-#include <NetworkManagerQt/WiredDevice>
-#include <NetworkManagerQt/WirelessDevice>
 #include <NetworkManagerQt/WirelessSetting>
 
 #include <KLocalizedString>
 
+#include <QtAlgorithms>
+
 #if WITH_MODEMMANAGER_SUPPORT
-#include <ModemManagerQt/manager.h>
 #include <ModemManagerQt/modem.h>
-#include <ModemManagerQt/modemdevice.h>
-#include <ModemManagerQt/modem3gpp.h>
-#include <ModemManagerQt/modemcdma.h>
 #endif
 
 NetworkModelItem::NetworkModelItem(QObject *parent)
     : QObject(parent)
+    , m_activeConnectionPath(0)
+    , m_connectionPath(0)
     , m_connectionState(NetworkManager::ActiveConnection::Deactivated)
+    , m_devicePath(0)
     , m_deviceState(NetworkManager::Device::UnknownState)
     , m_detailsValid(false)
     , m_duplicate(false)
     , m_mode(NetworkManager::WirelessSetting::Infrastructure)
+    , m_networkStatus(NetworkManager::Unknown)
     , m_securityType(NetworkManager::NoneSecurity)
     , m_signal(0)
+    , m_rawSignal(0)
     , m_slave(false)
+    , m_specificPath(0)
     , m_type(NetworkManager::ConnectionSettings::Unknown)
     , m_vpnState(NetworkManager::VpnConnection::Unknown)
     , m_rxBytes(0)
     , m_txBytes(0)
+    , m_changedRoles(0)
+    , m_itemsList(nullptr)
+    , m_row(-1)
 {
 }
 
 NetworkModelItem::NetworkModelItem(const NetworkModelItem *item, QObject *parent)
     : QObject(parent)
-    , m_connectionPath(item->connectionPath())
+    , m_activeConnectionPath(0)
+    , m_connectionPath(item->m_connectionPath)
     , m_connectionState(NetworkManager::ActiveConnection::Deactivated)
+    , m_devicePath(0)
     , m_detailsValid(false)
     , m_duplicate(true)
     , m_mode(item->mode())
     , m_name(item->name())
+    , m_networkStatus(item->networkStatus())
     , m_securityType(item->securityType())
+    , m_signal(0)
+    , m_rawSignal(0)
     , m_slave(item->slave())
+    , m_specificPath(0)
     , m_ssid(item->ssid())
     , m_timestamp(item->timestamp())
     , m_type(item->type())
@@ -80,33 +81,75 @@ NetworkModelItem::NetworkModelItem(const NetworkModelItem *item, QObject *parent
     , m_vpnState(NetworkManager::VpnConnection::Unknown)
     , m_rxBytes(0)
     , m_txBytes(0)
+    , m_changedRoles(0)
+    , m_itemsList(nullptr)
+    , m_row(-1)
 {
+    DBusPathTable::instance()->ref(m_connectionPath);
 }
 
 NetworkModelItem::~NetworkModelItem()
 {
+    DBusPathTable *table = DBusPathTable::instance();
+    table->release(m_activeConnectionPath);
+    table->release(m_connectionPath);
+    table->release(m_devicePath);
+    table->release(m_specificPath);
+}
+
+QVector<int> NetworkModelItem::changedRoles() const
+{
+    return rolesFromMask(m_changedRoles);
+}
+
+QVector<int> NetworkModelItem::rolesFromMask(quint64 mask)
+{
+    QVector<int> roles;
+    for (; mask; mask &= mask - 1) {
+        roles << NetworkModel::ConnectionDetailsRole + qCountTrailingZeroBits(mask);
+    }
+    return roles;
 }
 
 QString NetworkModelItem::activeConnectionPath() const
 {
-    return m_activeConnectionPath;
+    return DBusPathTable::instance()->path(m_activeConnectionPath);
 }
 
 void NetworkModelItem::setActiveConnectionPath(const QString &path)
 {
-    m_activeConnectionPath = path;
+    DBusPathTable *table = DBusPathTable::instance();
+    const DBusPathTable::Handle handle = table->acquire(path);
+    if (m_activeConnectionPath != handle) {
+        if (m_itemsList) {
+            m_itemsList->updatePathIndex(this, NetworkItemsList::ActiveConnection, m_activeConnectionPath, handle);
+        }
+        table->release(m_activeConnectionPath);
+        m_activeConnectionPath = handle;
+    } else {
+        table->release(handle);
+    }
 }
 
 QString NetworkModelItem::connectionPath() const
 {
-    return m_connectionPath;
+    return DBusPathTable::instance()->path(m_connectionPath);
 }
 
 void NetworkModelItem::setConnectionPath(const QString &path)
 {
-    if (m_connectionPath != path) {
-        m_connectionPath = path;
-        m_changedRoles << NetworkModel::ConnectionPathRole << NetworkModel::UniRole;
+    DBusPathTable *table = DBusPathTable::instance();
+    const DBusPathTable::Handle handle = table->acquire(path);
+    if (m_connectionPath != handle) {
+        if (m_itemsList) {
+            m_itemsList->updatePathIndex(this, NetworkItemsList::Connection, m_connectionPath, handle);
+        }
+        table->release(m_connectionPath);
+        m_connectionPath = handle;
+        markRoleChanged(NetworkModel::ConnectionPathRole);
+        fieldsChanged(ConnectionPathField);
+    } else {
+        table->release(handle);
     }
 }
 
@@ -119,22 +162,19 @@ void NetworkModelItem::setConnectionState(NetworkManager::ActiveConnection::Stat
 {
     if (m_connectionState != state) {
         m_connectionState = state;
-        m_changedRoles << NetworkModel::ConnectionStateRole << NetworkModel::SectionRole;
-        refreshIcon();
+        markRoleChanged(NetworkModel::ConnectionStateRole);
+        fieldsChanged(ConnectionStateField);
     }
 }
 
 QStringList NetworkModelItem::details() const
 {
-    if (!m_detailsValid) {
-        updateDetails();
-    }
     return m_details;
 }
 
 QString NetworkModelItem::devicePath() const
 {
-    return m_devicePath;
+    return DBusPathTable::instance()->path(m_devicePath);
 }
 
 QString NetworkModelItem::deviceName() const
@@ -146,15 +186,25 @@ void NetworkModelItem::setDeviceName(const QString &name)
 {
     if (m_deviceName != name) {
         m_deviceName = name;
-        m_changedRoles << NetworkModel::DeviceName;
+        markRoleChanged(NetworkModel::DeviceName);
+        fieldsChanged(DeviceNameField);
     }
 }
 
 void NetworkModelItem::setDevicePath(const QString &path)
 {
-    if (m_devicePath != path) {
-        m_devicePath = path;
-        m_changedRoles << NetworkModel::DevicePathRole << NetworkModel::ItemTypeRole << NetworkModel::UniRole;
+    DBusPathTable *table = DBusPathTable::instance();
+    const DBusPathTable::Handle handle = table->acquire(path);
+    if (m_devicePath != handle) {
+        if (m_itemsList) {
+            m_itemsList->updatePathIndex(this, NetworkItemsList::Device, m_devicePath, handle);
+        }
+        table->release(m_devicePath);
+        m_devicePath = handle;
+        markRoleChanged(NetworkModel::DevicePathRole);
+        fieldsChanged(DevicePathField);
+    } else {
+        table->release(handle);
     }
 }
 
@@ -167,7 +217,7 @@ void NetworkModelItem::setDeviceState(const NetworkManager::Device::State state)
 {
     if (m_deviceState != state) {
         m_deviceState = state;
-        m_changedRoles << NetworkModel::DeviceStateRole;
+        markRoleChanged(NetworkModel::DeviceStateRole);
     }
 }
 
@@ -180,15 +230,10 @@ void NetworkModelItem::setIcon(const QString& icon)
 {
     if (icon != m_icon) {
         m_icon = icon;
-        m_changedRoles << NetworkModel::ConnectionIconRole;
+        markRoleChanged(NetworkModel::ConnectionIconRole);
     }
 }
 
-void NetworkModelItem::refreshIcon()
-{
-    setIcon(computeIcon());
-}
-
 QString NetworkModelItem::computeIcon() const
 {
     switch (m_type) {
@@ -273,15 +318,15 @@ QString NetworkModelItem::computeIcon() const
 
 NetworkModelItem::ItemType NetworkModelItem::itemType() const
 {
-    if (!m_devicePath.isEmpty() ||
+    if (m_devicePath ||
         m_type == NetworkManager::ConnectionSettings::Bond ||
         m_type == NetworkManager::ConnectionSettings::Bridge ||
         m_type == NetworkManager::ConnectionSettings::Vlan ||
         m_type == NetworkManager::ConnectionSettings::Team ||
-        ((NetworkManager::status() == NetworkManager::Connected ||
-          NetworkManager::status() == NetworkManager::ConnectedLinkLocal ||
-          NetworkManager::status() == NetworkManager::ConnectedSiteOnly) && (m_type == NetworkManager::ConnectionSettings::Vpn || m_type == NetworkManager::ConnectionSettings::WireGuard))) {
-        if (m_connectionPath.isEmpty() && m_type == NetworkManager::ConnectionSettings::Wireless) {
+        ((m_networkStatus == NetworkManager::Connected ||
+          m_networkStatus == NetworkManager::ConnectedLinkLocal ||
+          m_networkStatus == NetworkManager::ConnectedSiteOnly) && (m_type == NetworkManager::ConnectionSettings::Vpn || m_type == NetworkManager::ConnectionSettings::WireGuard))) {
+        if (!m_connectionPath && m_type == NetworkManager::ConnectionSettings::Wireless) {
             return NetworkModelItem::AvailableAccessPoint;
         } else {
             return NetworkModelItem::AvailableConnection;
@@ -299,7 +344,7 @@ void NetworkModelItem::setMode(const NetworkManager::WirelessSetting::NetworkMod
 {
     if (m_mode != mode) {
         m_mode = mode;
-        refreshIcon();
+        fieldsChanged(ModeField);
     }
 }
 
@@ -311,8 +356,28 @@ QString NetworkModelItem::name() const
 void NetworkModelItem::setName(const QString &name)
 {
     if (m_name != name) {
+        if (m_itemsList) {
+            m_itemsList->updateIndex(this, NetworkItemsList::Name, m_name, name);
+        }
         m_name = name;
-        m_changedRoles << NetworkModel::ItemUniqueNameRole << NetworkModel::NameRole;
+        markRoleChanged(NetworkModel::NameRole);
+        fieldsChanged(NameField);
+    }
+}
+
+NetworkManager::Status NetworkModelItem::networkStatus() const
+{
+    return m_networkStatus;
+}
+
+void NetworkModelItem::setNetworkStatus(NetworkManager::Status status)
+{
+    if (m_networkStatus != status) {
+        m_networkStatus = status;
+        // Availability of the other connections doesn't depend on it
+        if (m_type == NetworkManager::ConnectionSettings::Vpn || m_type == NetworkManager::ConnectionSettings::WireGuard) {
+            fieldsChanged(NetworkStatusField);
+        }
     }
 }
 
@@ -342,8 +407,9 @@ void NetworkModelItem::setSecurityType(NetworkManager::WirelessSecurityType type
 {
     if (m_securityType != type) {
         m_securityType = type;
-        m_changedRoles << NetworkModel::SecurityTypeStringRole << NetworkModel::SecurityTypeRole;
-        refreshIcon();
+        markRoleChanged(NetworkModel::SecurityTypeStringRole);
+        markRoleChanged(NetworkModel::SecurityTypeRole);
+        fieldsChanged(SecurityTypeField);
     }
 }
 
@@ -354,10 +420,26 @@ int NetworkModelItem::signal() const
 
 void NetworkModelItem::setSignal(int signal)
 {
+    setRawSignal(signal);
+
     if (m_signal != signal) {
         m_signal = signal;
-        m_changedRoles << NetworkModel::SignalRole;
-        refreshIcon();
+        markRoleChanged(NetworkModel::SignalRole);
+        fieldsChanged(SignalField);
+    }
+}
+
+int NetworkModelItem::rawSignal() const
+{
+    return m_rawSignal;
+}
+
+void NetworkModelItem::setRawSignal(int signal)
+{
+    // Neither sorted nor filtered by, so it's only forwarded by the proxies
+    if (m_rawSignal != signal) {
+        m_rawSignal = signal;
+        markRoleChanged(NetworkModel::RawSignalRole);
     }
 }
 
@@ -370,20 +452,25 @@ void NetworkModelItem::setSlave(bool slave)
 {
     if (m_slave != slave) {
         m_slave = slave;
-        m_changedRoles << NetworkModel::SlaveRole;
+        markRoleChanged(NetworkModel::SlaveRole);
     }
 }
 
 QString NetworkModelItem::specificPath() const
 {
-    return m_specificPath;
+    return DBusPathTable::instance()->path(m_specificPath);
 }
 
 void NetworkModelItem::setSpecificPath(const QString &path)
 {
-    if (m_specificPath != path) {
-        m_specificPath = path;
-        m_changedRoles << NetworkModel::SpecificPathRole;
+    DBusPathTable *table = DBusPathTable::instance();
+    const DBusPathTable::Handle handle = table->acquire(path);
+    if (m_specificPath != handle) {
+        table->release(m_specificPath);
+        m_specificPath = handle;
+        markRoleChanged(NetworkModel::SpecificPathRole);
+    } else {
+        table->release(handle);
     }
 }
 
@@ -395,8 +482,12 @@ QString NetworkModelItem::ssid() const
 void NetworkModelItem::setSsid(const QString &ssid)
 {
     if (m_ssid != ssid) {
+        if (m_itemsList) {
+            m_itemsList->updateIndex(this, NetworkItemsList::Ssid, m_ssid, ssid);
+        }
         m_ssid = ssid;
-        m_changedRoles << NetworkModel::SsidRole << NetworkModel::UniRole;
+        markRoleChanged(NetworkModel::SsidRole);
+        fieldsChanged(SsidField);
     }
 }
 
@@ -414,26 +505,29 @@ void NetworkModelItem::setTimestamp(const QDateTime &date)
 {
     if (m_timestamp != date) {
         m_timestamp = date;
-        m_changedRoles << NetworkModel::TimeStampRole;
+        markRoleChanged(NetworkModel::TimeStampRole);
+        fieldsChanged(TimestampField);
     }
 }
 
 void NetworkModelItem::setType(NetworkManager::ConnectionSettings::ConnectionType type)
 {
     if (m_type != type) {
+        if (m_itemsList) {
+            m_itemsList->updateTypeIndex(this, m_type, type);
+        }
         m_type = type;
-        m_changedRoles << NetworkModel::TypeRole << NetworkModel::ItemTypeRole << NetworkModel::UniRole;
-
-        refreshIcon();
+        markRoleChanged(NetworkModel::TypeRole);
+        fieldsChanged(TypeField);
     }
 }
 
 QString NetworkModelItem::uni() const
 {
     if (m_type == NetworkManager::ConnectionSettings::Wireless && m_uuid.isEmpty()) {
-        return m_ssid + '%' + m_devicePath;
+        return m_ssid + '%' + devicePath();
     } else {
-        return m_connectionPath + '%' + m_devicePath;
+        return connectionPath() + '%' + devicePath();
     }
 }
 
@@ -445,8 +539,25 @@ QString NetworkModelItem::uuid() const
 void NetworkModelItem::setUuid(const QString &uuid)
 {
     if (m_uuid != uuid) {
+        if (m_itemsList) {
+            m_itemsList->updateIndex(this, NetworkItemsList::Uuid, m_uuid, uuid);
+        }
         m_uuid = uuid;
-        m_changedRoles << NetworkModel::UuidRole;
+        markRoleChanged(NetworkModel::UuidRole);
+        fieldsChanged(UuidField);
+    }
+}
+
+QString NetworkModelItem::vpnBanner() const
+{
+    return m_vpnBanner;
+}
+
+void NetworkModelItem::setVpnBanner(const QString &banner)
+{
+    if (m_vpnBanner != banner) {
+        m_vpnBanner = banner;
+        fieldsChanged(VpnBannerField);
     }
 }
 
@@ -459,7 +570,7 @@ void NetworkModelItem::setVpnState(NetworkManager::VpnConnection::State state)
 {
     if (m_vpnState != state) {
         m_vpnState = state;
-        m_changedRoles << NetworkModel::VpnState;
+        markRoleChanged(NetworkModel::VpnState);
     }
 }
 
@@ -472,7 +583,8 @@ void NetworkModelItem::setVpnType(const QString &type)
 {
     if (m_vpnType != type) {
         m_vpnType = type;
-        m_changedRoles << NetworkModel::VpnType;
+        markRoleChanged(NetworkModel::VpnType);
+        fieldsChanged(VpnTypeField);
     }
 }
 
@@ -485,7 +597,7 @@ void NetworkModelItem::setRxBytes(qulonglong bytes)
 {
     if (m_rxBytes != bytes) {
         m_rxBytes = bytes;
-        m_changedRoles << NetworkModel::RxBytesRole;
+        markRoleChanged(NetworkModel::RxBytesRole);
     }
 }
 
@@ -498,18 +610,18 @@ void NetworkModelItem::setTxBytes(qulonglong bytes)
 {
     if (m_txBytes != bytes) {
         m_txBytes = bytes;
-        m_changedRoles << NetworkModel::TxBytesRole;
+        markRoleChanged(NetworkModel::TxBytesRole);
     }
 }
 
 bool NetworkModelItem::operator==(const NetworkModelItem *item) const
 {
     if (!item->uuid().isEmpty() && !uuid().isEmpty()) {
-        if (item->devicePath() == devicePath() && item->uuid() == uuid()) {
+        if (item->m_devicePath == m_devicePath && item->uuid() == uuid()) {
             return true;
         }
     } else if (item->type() == NetworkManager::ConnectionSettings::Wireless && type() == NetworkManager::ConnectionSettings::Wireless) {
-        if (item->ssid() == ssid() && item->devicePath() == devicePath()) {
+        if (item->ssid() == ssid() && item->m_devicePath == m_devicePath) {
             return true;
         }
     }
@@ -517,14 +629,71 @@ bool NetworkModelItem::operator==(const NetworkModelItem *item) const
     return false;
 }
 
+// Inputs of each derived value, keep in sync with the functions computing them
+static const NetworkModelItem::Fields detailsDependencies = NetworkModelItem::ConnectionPathField | NetworkModelItem::ConnectionStateField
+    | NetworkModelItem::DevicePathField | NetworkModelItem::ModeField | NetworkModelItem::SecurityTypeField | NetworkModelItem::SignalField
+    | NetworkModelItem::SsidField | NetworkModelItem::TypeField | NetworkModelItem::VpnBannerField | NetworkModelItem::VpnTypeField
+    | NetworkModelItem::DevicePropertiesField | NetworkModelItem::NetworkStatusField;
+static const NetworkModelItem::Fields iconDependencies = NetworkModelItem::ConnectionStateField | NetworkModelItem::ModeField
+    | NetworkModelItem::SecurityTypeField | NetworkModelItem::SignalField | NetworkModelItem::TypeField;
+static const NetworkModelItem::Fields itemTypeDependencies = NetworkModelItem::ConnectionPathField | NetworkModelItem::DevicePathField
+    | NetworkModelItem::TypeField | NetworkModelItem::NetworkStatusField;
+static const NetworkModelItem::Fields sectionDependencies = NetworkModelItem::ConnectionStateField;
+static const NetworkModelItem::Fields sortKeyDependencies = itemTypeDependencies | NetworkModelItem::ConnectionStateField
+    | NetworkModelItem::NameField | NetworkModelItem::SignalField | NetworkModelItem::TimestampField | NetworkModelItem::UuidField
+    | NetworkModelItem::VpnTypeField;
+static const NetworkModelItem::Fields uniDependencies = NetworkModelItem::ConnectionPathField | NetworkModelItem::DevicePathField
+    | NetworkModelItem::SsidField | NetworkModelItem::TypeField | NetworkModelItem::UuidField;
+static const NetworkModelItem::Fields uniqueNameDependencies = NetworkModelItem::DeviceNameField | NetworkModelItem::NameField;
+static const NetworkModelItem::Fields trafficRatesDependencies = NetworkModelItem::DevicePathField | NetworkModelItem::TrafficField;
+
+void NetworkModelItem::fieldsChanged(NetworkModelItem::Fields fields)
+{
+    if (fields & detailsDependencies) {
+        m_detailsValid = false;
+        markRoleChanged(NetworkModel::ConnectionDetailsRole);
+    }
+
+    if (fields & iconDependencies) {
+        setIcon(computeIcon());
+    }
+
+    if (fields & itemTypeDependencies) {
+        markRoleChanged(NetworkModel::ItemTypeRole);
+    }
+
+    if (fields & sectionDependencies) {
+        markRoleChanged(NetworkModel::SectionRole);
+    }
+
+    if (fields & sortKeyDependencies) {
+        markRoleChanged(NetworkModel::SortKeyRole);
+    }
+
+    if (fields & uniDependencies) {
+        markRoleChanged(NetworkModel::UniRole);
+    }
+
+    if (fields & uniqueNameDependencies) {
+        markRoleChanged(NetworkModel::ItemUniqueNameRole);
+    }
+
+    if (fields & trafficRatesDependencies) {
+        markRoleChanged(NetworkModel::RxRateRole);
+        markRoleChanged(NetworkModel::TxRateRole);
+        markRoleChanged(NetworkModel::RxRateHistoryRole);
+        markRoleChanged(NetworkModel::TxRateHistoryRole);
+    }
+}
+
 void NetworkModelItem::invalidateDetails()
 {
-    m_detailsValid = false;
-    m_changedRoles << NetworkModel::ConnectionDetailsRole;
+    fieldsChanged(DevicePropertiesField);
 }
 
-void NetworkModelItem::updateDetails() const
+void NetworkModelItem::updateDetails(const BackendDevice &device)
 {
+    PerfCounters::instance()->increment(PerfCounters::DetailsUpdates);
     m_detailsValid = true;
     m_details.clear();
 
@@ -532,154 +701,107 @@ void NetworkModelItem::updateDetails() const
         return;
     }
 
-    NetworkManager::Device::Ptr device = NetworkManager::findNetworkInterface(m_devicePath);
+    const bool activated = device.isValid() && m_connectionState == NetworkManager::ActiveConnection::Activated;
 
     // Get IPv[46]Address and related nameservers + IPv4 default gateway
-    if (device && device->ipV4Config().isValid() && m_connectionState == NetworkManager::ActiveConnection::Activated) {
-        if (!device->ipV4Config().addresses().isEmpty()) {
-            QHostAddress addr = device->ipV4Config().addresses().first().ip();
-            if (!addr.isNull()) {
-                m_details << i18n("IPv4 Address") << addr.toString();
-            }
+    if (activated) {
+        if (!device.ipV4Address.isEmpty()) {
+            m_details << i18n("IPv4 Address") << device.ipV4Address;
         }
-        if (!device->ipV4Config().gateway().isEmpty()) {
-            QString addr = device->ipV4Config().gateway();
-            if (!addr.isNull()) {
-                m_details << i18n("IPv4 Default Gateway") << addr;
-            }
+        if (!device.ipV4Gateway.isEmpty()) {
+            m_details << i18n("IPv4 Default Gateway") << device.ipV4Gateway;
         }
-        if (!device->ipV4Config().nameservers().isEmpty()) {
-            QHostAddress addr = device->ipV4Config().nameservers().first();
-            if (!addr.isNull()) {
-                m_details << i18n("IPv4 Nameserver") << addr.toString();
-            }
+        if (!device.ipV4Nameserver.isEmpty()) {
+            m_details << i18n("IPv4 Nameserver") << device.ipV4Nameserver;
         }
-    }
-
-    if (device && device->ipV6Config().isValid() && m_connectionState == NetworkManager::ActiveConnection::Activated) {
-        if (!device->ipV6Config().addresses().isEmpty()) {
-            QHostAddress addr = device->ipV6Config().addresses().first().ip();
-            if (!addr.isNull()) {
-                m_details << i18n("IPv6 Address") << addr.toString();
-            }
+        if (!device.ipV6Address.isEmpty()) {
+            m_details << i18n("IPv6 Address") << device.ipV6Address;
         }
-        if (!device->ipV6Config().nameservers().isEmpty()) {
-            QHostAddress addr = device->ipV6Config().nameservers().first();
-            if (!addr.isNull()) {
-                m_details << i18n("IPv6 Nameserver") << addr.toString();
-            }
+        if (!device.ipV6Nameserver.isEmpty()) {
+            m_details << i18n("IPv6 Nameserver") << device.ipV6Nameserver;
         }
     }
+
     if (m_type == NetworkManager::ConnectionSettings::Wired) {
-        NetworkManager::WiredDevice::Ptr wiredDevice = device.objectCast<NetworkManager::WiredDevice>();
-        if (wiredDevice) {
-            if (m_connectionState == NetworkManager::ActiveConnection::Activated) {
-                m_details << i18n("Connection speed") << UiUtils::connectionSpeed(wiredDevice->bitRate());
+        if (device.type == NetworkManager::Device::Ethernet) {
+            if (activated) {
+                m_details << i18n("Connection speed") << UiUtils::connectionSpeed(device.bitRate);
             }
-            m_details << i18n("MAC Address") << wiredDevice->permanentHardwareAddress();
+            m_details << i18n("MAC Address") << device.permanentHardwareAddress;
         }
     } else if (m_type == NetworkManager::ConnectionSettings::Wireless) {
-        NetworkManager::WirelessDevice::Ptr wirelessDevice = device.objectCast<NetworkManager::WirelessDevice>();
         m_details << i18n("Access point (SSID)") << m_ssid;
         if (m_mode == NetworkManager::WirelessSetting::Infrastructure) {
             m_details << i18n("Signal strength") << QStringLiteral("%1%").arg(m_signal);
         }
         m_details << i18n("Security type") << UiUtils::labelFromWirelessSecurity(m_securityType);
-        if (wirelessDevice) {
-            if (m_connectionState == NetworkManager::ActiveConnection::Activated) {
-                m_details << i18n("Connection speed") << UiUtils::connectionSpeed(wirelessDevice->bitRate());
+        if (device.type == NetworkManager::Device::Wifi) {
+            if (activated) {
+                m_details << i18n("Connection speed") << UiUtils::connectionSpeed(device.bitRate);
             }
-            m_details << i18n("MAC Address") << wirelessDevice->permanentHardwareAddress();
+            m_details << i18n("MAC Address") << device.permanentHardwareAddress;
         }
     } else if (m_type == NetworkManager::ConnectionSettings::Gsm || m_type == NetworkManager::ConnectionSettings::Cdma) {
 #if WITH_MODEMMANAGER_SUPPORT
-        NetworkManager::ModemDevice::Ptr modemDevice = device.objectCast<NetworkManager::ModemDevice>();
-        if (modemDevice) {
-            ModemManager::ModemDevice::Ptr modem = ModemManager::findModemDevice(modemDevice->udi());
-            if (modem) {
-                ModemManager::Modem::Ptr modemNetwork = modem->interface(ModemManager::ModemDevice::ModemInterface).objectCast<ModemManager::Modem>();
-
-                if (m_type == NetworkManager::ConnectionSettings::Gsm) {
-                    ModemManager::Modem3gpp::Ptr gsmNet = modem->interface(ModemManager::ModemDevice::GsmInterface).objectCast<ModemManager::Modem3gpp>();
-                    if (gsmNet) {
-                        m_details << i18n("Operator") << gsmNet->operatorName();
-                    }
-                } else {
-                    ModemManager::ModemCdma::Ptr cdmaNet = modem->interface(ModemManager::ModemDevice::CdmaInterface).objectCast<ModemManager::ModemCdma>();
-                    m_details << i18n("Network ID") << QString("%1").arg(cdmaNet->nid());
-                }
-
-                if (modemNetwork) {
-                    m_details << i18n("Signal Quality") << QString("%1%").arg(modemNetwork->signalQuality().signal);
-                    m_details << i18n("Access Technology") << UiUtils::convertAccessTechnologyToString(modemNetwork->accessTechnologies());
-                }
+        if (device.type == NetworkManager::Device::Modem) {
+            if (m_type == NetworkManager::ConnectionSettings::Gsm) {
+                m_details << i18n("Operator") << device.modemOperator;
+            } else {
+                m_details << i18n("Network ID") << device.modemOperator;
             }
+            m_details << i18n("Signal Quality") << QStringLiteral("%1%").arg(m_signal);
+            m_details << i18n("Access Technology") << UiUtils::convertAccessTechnologyToString(ModemManager::Modem::AccessTechnologies(device.modemAccessTechnologies));
         }
 #endif
     } else if (m_type == NetworkManager::ConnectionSettings::Vpn) {
         m_details << i18n("VPN plugin") << m_vpnType;
 
-        if (m_connectionState == NetworkManager::ActiveConnection::Activated) {
-            NetworkManager::ActiveConnection::Ptr active = NetworkManager::findActiveConnection(m_activeConnectionPath);
-            NetworkManager::VpnConnection::Ptr vpnConnection;
-
-            if (active) {
-                vpnConnection = NetworkManager::VpnConnection::Ptr(new NetworkManager::VpnConnection(active->path()), &QObject::deleteLater);
-            }
-
-            if (vpnConnection && !vpnConnection->banner().isEmpty()) {
-                m_details << i18n("Banner") << vpnConnection->banner().simplified();
-            }
+        if (m_connectionState == NetworkManager::ActiveConnection::Activated && !m_vpnBanner.isEmpty()) {
+            m_details << i18n("Banner") << m_vpnBanner.simplified();
         }
     } else if (m_type == NetworkManager::ConnectionSettings::Bluetooth) {
-        NetworkManager::BluetoothDevice::Ptr bluetoothDevice = device.objectCast<NetworkManager::BluetoothDevice>();
-        if (bluetoothDevice) {
-            m_details << i18n("Name") << bluetoothDevice->name();
-            if (bluetoothDevice->bluetoothCapabilities() == NetworkManager::BluetoothDevice::Pan) {
+        if (device.type == NetworkManager::Device::Bluetooth) {
+            m_details << i18n("Name") << device.bluetoothName;
+            if (device.bluetoothCapabilities == NetworkManager::BluetoothDevice::Pan) {
                 m_details << i18n("Capabilities") << QStringLiteral("PAN");
-            } else if (bluetoothDevice->bluetoothCapabilities() == NetworkManager::BluetoothDevice::Dun) {
+            } else if (device.bluetoothCapabilities == NetworkManager::BluetoothDevice::Dun) {
                 m_details << i18n("Capabilities") << QStringLiteral("DUN");
             }
-            m_details << i18n("MAC Address") << bluetoothDevice->hardwareAddress();
+            m_details << i18n("MAC Address") << device.hardwareAddress;
 
         }
     } else if (m_type == NetworkManager::ConnectionSettings::Infiniband) {
-        NetworkManager::InfinibandDevice::Ptr infinibandDevice = device.objectCast<NetworkManager::InfinibandDevice>();
         m_details << i18n("Type") << i18n("Infiniband");
-        if (infinibandDevice) {
-            m_details << i18n("MAC Address") << infinibandDevice->hwAddress();
+        if (device.type == NetworkManager::Device::InfiniBand) {
+            m_details << i18n("MAC Address") << device.hardwareAddress;
         }
     } else if (m_type == NetworkManager::ConnectionSettings::Bond) {
-        NetworkManager::BondDevice::Ptr bondDevice = device.objectCast<NetworkManager::BondDevice>();
         m_details << i18n("Type") << i18n("Bond");
-        if (bondDevice) {
-            m_details << i18n("MAC Address") << bondDevice->hwAddress();
+        if (device.type == NetworkManager::Device::Bond) {
+            m_details << i18n("MAC Address") << device.hardwareAddress;
         }
     } else if (m_type == NetworkManager::ConnectionSettings::Bridge) {
-        NetworkManager::BridgeDevice::Ptr bridgeDevice = device.objectCast<NetworkManager::BridgeDevice>();
         m_details << i18n("Type") << i18n("Bridge");
-        if (bridgeDevice) {
-            m_details << i18n("MAC Address") << bridgeDevice->hwAddress();
+        if (device.type == NetworkManager::Device::Bridge) {
+            m_details << i18n("MAC Address") << device.hardwareAddress;
         }
     } else if (m_type == NetworkManager::ConnectionSettings::Vlan) {
-        NetworkManager::VlanDevice::Ptr vlanDevice = device.objectCast<NetworkManager::VlanDevice>();
         m_details << i18n("Type") << i18n("Vlan");
-        if (vlanDevice) {
-            m_details << i18n("Vlan ID") << QString("%1").arg(vlanDevice->vlanId());
-            m_details << i18n("MAC Address") << vlanDevice->hwAddress();
+        if (device.type == NetworkManager::Device::Vlan) {
+            m_details << i18n("Vlan ID") << QString("%1").arg(device.vlanId);
+            m_details << i18n("MAC Address") << device.hardwareAddress;
         }
     } else if (m_type == NetworkManager::ConnectionSettings::Adsl) {
         m_details << i18n("Type") << i18n("Adsl");
     }
       else if (m_type == NetworkManager::ConnectionSettings::Team) {
-        NetworkManager::TeamDevice::Ptr teamDevice = device.objectCast<NetworkManager::TeamDevice>();
         m_details << i18n("Type") << i18n("Team");
-        if (teamDevice) {
-            m_details << i18n("MAC Address") << teamDevice->hwAddress();
+        if (device.type == NetworkManager::Device::Team) {
+            m_details << i18n("MAC Address") << device.hardwareAddress;
         }
     }
 
-    if (device && m_connectionState == NetworkManager::ActiveConnection::Activated) {
-        m_details << i18n("Device") << device->interfaceName();
+    if (activated) {
+        m_details << i18n("Device") << device.interfaceName;
     }
 }
@@ -27,6 +27,7 @@
 #include <NetworkManagerQt/Device>
 #include <NetworkManagerQt/Utils>
 
+#include "dbuspathtable.h"
 #include "networkmodel.h"
 
 class Q_DECL_EXPORT NetworkModelItem : public QObject
@@ -36,25 +37,63 @@ public:
 
     enum ItemType { UnavailableConnection, AvailableConnection, AvailableAccessPoint };
 
+    /**
+     * Inputs of the derived values (details, icon, item type, section, sort key and unique name),
+     * when one of them changes only the values depending on it are recomputed
+     */
+    enum Field {
+        ConnectionPathField = 1 << 0,
+        ConnectionStateField = 1 << 1,
+        DeviceNameField = 1 << 2,
+        DevicePathField = 1 << 3,
+        ModeField = 1 << 4,
+        NameField = 1 << 5,
+        SecurityTypeField = 1 << 6,
+        SignalField = 1 << 7,
+        SsidField = 1 << 8,
+        TimestampField = 1 << 9,
+        TypeField = 1 << 10,
+        UuidField = 1 << 11,
+        VpnBannerField = 1 << 12,
+        VpnTypeField = 1 << 13,
+        // Properties of the device which are not stored in the item, like IP configuration or bit rate
+        DevicePropertiesField = 1 << 14,
+        // Global NetworkManager status
+        NetworkStatusField = 1 << 15,
+        // Samples of the device traffic counters
+        TrafficField = 1 << 16
+    };
+    Q_DECLARE_FLAGS(Fields, Field)
+
     explicit NetworkModelItem(QObject *parent = nullptr);
     explicit NetworkModelItem(const NetworkModelItem *item, QObject *parent = nullptr);
     ~NetworkModelItem() override;
 
+    // The D-Bus paths are interned, the handles identify them within the process
     QString activeConnectionPath() const;
+    DBusPathTable::Handle activeConnectionPathHandle() const { return m_activeConnectionPath; }
     void setActiveConnectionPath(const QString &path);
 
     QString connectionPath() const;
+    DBusPathTable::Handle connectionPathHandle() const { return m_connectionPath; }
     void setConnectionPath(const QString &path);
 
     NetworkManager::ActiveConnection::State connectionState() const;
     void setConnectionState(NetworkManager::ActiveConnection::State state);
 
+    /**
+     * Details are computed from the snapshot of the device of the item, the caller
+     * provides it through updateDetails() whenever detailsValid() returns false
+     */
     QStringList details() const;
+    bool detailsValid() const { return m_detailsValid; }
+    void updateDetails(const BackendDevice &device);
 
     QString deviceName() const;
     void setDeviceName(const QString &name);
 
     QString devicePath() const;
+    DBusPathTable::Handle devicePathHandle() const { return m_devicePath; }
     void setDevicePath(const QString &path);
 
     QString deviceState() const;
@@ -73,6 +112,10 @@ public:
     QString name() const;
     void setName(const QString &name);
 
+    // Global NetworkManager status, VPN connections are available only when connected
+    NetworkManager::Status networkStatus() const;
+    void setNetworkStatus(NetworkManager::Status status);
+
     QString originalName() const;
 
     QString sectionType() const;
@@ -83,10 +126,15 @@ public:
     int signal() const;
     void setSignal(int signal);
 
+    // Current signal strength, signal() is updated only when the change is significant
+    int rawSignal() const;
+    void setRawSignal(int signal);
+
     bool slave() const;
     void setSlave(bool slave);
 
     QString specificPath() const;
+    DBusPathTable::Handle specificPathHandle() const { return m_specificPath; }
     void setSpecificPath(const QString &path);
 
     QString ssid() const;
@@ -103,6 +151,10 @@ public:
     QString uuid() const;
     void setUuid(const QString &uuid);
 
+    // Banner of the active VPN connection, kept here so the details don't need to query it
+    QString vpnBanner() const;
+    void setVpnBanner(const QString &banner);
+
     QString vpnState() const;
     void setVpnState(NetworkManager::VpnConnection::State state);
 
@@ -117,42 +169,63 @@ public:
 
     bool operator==(const NetworkModelItem *item) const;
 
-    QVector<int> changedRoles() const { return m_changedRoles; }
-    void clearChangedRoles() { m_changedRoles.clear(); }
+    QVector<int> changedRoles() const;
+    /**
+     * Changed roles as one bit per NetworkModel::ItemRole, counted from ConnectionDetailsRole
+     */
+    quint64 changedRolesMask() const { return m_changedRoles; }
+    void clearChangedRoles() { m_changedRoles = 0; }
+    static QVector<int> rolesFromMask(quint64 mask);
+    static quint64 roleBit(int role) { return Q_UINT64_C(1) << (role - NetworkModel::ConnectionDetailsRole); }
+
+    /**
+     * Marks the given inputs as changed and invalidates everything derived from them
+     */
+    void fieldsChanged(Fields fields);
 
 public Q_SLOTS:
     void invalidateDetails();
 
 private:
+    friend class NetworkItemsList;
+
     QString computeIcon() const;
-    void refreshIcon();
-    void updateDetails() const;
+    void markRoleChanged(int role) { m_changedRoles |= roleBit(role); }
 
-    QString m_activeConnectionPath;
-    QString m_connectionPath;
+    DBusPathTable::Handle m_activeConnectionPath;
+    DBusPathTable::Handle m_connectionPath;
     NetworkManager::ActiveConnection::State m_connectionState;
-    QString m_devicePath;
+    DBusPathTable::Handle m_devicePath;
     QString m_deviceName;
     NetworkManager::Device::State m_deviceState;
-    mutable QStringList m_details;
-    mutable bool m_detailsValid;
+    QStringList m_details;
+    bool m_detailsValid;
     bool m_duplicate;
     NetworkManager::WirelessSetting::NetworkMode m_mode;
     QString m_name;
+    NetworkManager::Status m_networkStatus;
     NetworkManager::WirelessSecurityType m_securityType;
     int m_signal;
+    int m_rawSignal;
     bool m_slave;
-    QString m_specificPath;
+    DBusPathTable::Handle m_specificPath;
     QString m_ssid;
     QDateTime m_timestamp;
     NetworkManager::ConnectionSettings::ConnectionType m_type;
     QString m_uuid;
+    QString m_vpnBanner;
     QString m_vpnType;
     NetworkManager::VpnConnection::State m_vpnState;
     qulonglong m_rxBytes;
     qulonglong m_txBytes;
     QString m_icon;
-    QVector<int> m_changedRoles;
+    quint64 m_changedRoles;
+    NetworkItemsList *m_itemsList;
+    int m_row;
 };
 
+Q_STATIC_ASSERT(NetworkModel::TxRateHistoryRole - NetworkModel::ConnectionDetailsRole < 64);
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(NetworkModelItem::Fields)
+
 #endif // PLASMA_NM_MODEL_NETWORK_MODEL_ITEM_H
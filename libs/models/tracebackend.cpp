@@ -0,0 +1,616 @@
+/*
+    Copyright 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "tracebackend.h"
+#include "debug.h"
+
+#include <QFile>
+#include <QTimer>
+
+// "PNMT"
+#define TRACE_MAGIC 0x504e4d54
+#define TRACE_VERSION 3
+
+QDataStream &operator<<(QDataStream &stream, const TraceEvent &event)
+{
+    stream << qint64(event.time) << quint8(event.type);
+
+    switch (event.type) {
+        case TraceEvent::Status:
+            stream << qint32(event.status);
+            break;
+        case TraceEvent::ConnectivityChanged:
+            stream << qint32(event.connectivity);
+            break;
+        case TraceEvent::DeviceRemoved:
+        case TraceEvent::ActiveConnectionRemoved:
+        case TraceEvent::ConnectionRemoved:
+        case TraceEvent::PrimaryConnectionChanged:
+            stream << event.path;
+            break;
+        case TraceEvent::DeviceStateChanged:
+            stream << event.device << qint32(event.oldDeviceState) << qint32(event.deviceStateReason);
+            break;
+        case TraceEvent::DeviceAdded:
+        case TraceEvent::DeviceInterfaceNameChanged:
+        case TraceEvent::DeviceDetailsChanged:
+        case TraceEvent::DeviceStatisticsChanged:
+        case TraceEvent::DeviceSignalChanged:
+            stream << event.device;
+            break;
+        case TraceEvent::AvailableConnectionAppeared:
+        case TraceEvent::AvailableConnectionDisappeared:
+            stream << event.device << event.path;
+            break;
+        case TraceEvent::VpnConnectionStateChanged:
+            stream << event.activeConnection << qint32(event.vpnStateReason);
+            break;
+        case TraceEvent::ActiveConnectionAdded:
+        case TraceEvent::ActiveConnectionStateChanged:
+        case TraceEvent::VpnConnectionBannerChanged:
+            stream << event.activeConnection;
+            break;
+        case TraceEvent::ConnectionAdded:
+        case TraceEvent::ConnectionUpdated:
+            stream << event.connection;
+            break;
+        case TraceEvent::WirelessNetworkAppeared:
+        case TraceEvent::WirelessNetworkDisappeared:
+        case TraceEvent::WirelessNetworkSignalChanged:
+        case TraceEvent::WirelessNetworkReferenceAccessPointChanged:
+            stream << event.network;
+            break;
+        case TraceEvent::AccessPointSignalChanged:
+            stream << event.network << event.path;
+            break;
+        case TraceEvent::SnapshotEnd:
+            break;
+    }
+
+    return stream;
+}
+
+QDataStream &operator>>(QDataStream &stream, TraceEvent &event)
+{
+    qint64 time;
+    quint8 type;
+    stream >> time >> type;
+    event.time = time;
+    event.type = static_cast<TraceEvent::Type>(type);
+
+    switch (event.type) {
+        case TraceEvent::Status: {
+            qint32 status;
+            stream >> status;
+            event.status = static_cast<NetworkManager::Status>(status);
+            break;
+        }
+        case TraceEvent::ConnectivityChanged: {
+            qint32 connectivity;
+            stream >> connectivity;
+            event.connectivity = static_cast<NetworkManager::Connectivity>(connectivity);
+            break;
+        }
+        case TraceEvent::DeviceRemoved:
+        case TraceEvent::ActiveConnectionRemoved:
+        case TraceEvent::ConnectionRemoved:
+        case TraceEvent::PrimaryConnectionChanged:
+            stream >> event.path;
+            break;
+        case TraceEvent::DeviceStateChanged: {
+            qint32 oldState, reason;
+            stream >> event.device >> oldState >> reason;
+            event.oldDeviceState = static_cast<NetworkManager::Device::State>(oldState);
+            event.deviceStateReason = static_cast<NetworkManager::Device::StateChangeReason>(reason);
+            break;
+        }
+        case TraceEvent::DeviceAdded:
+        case TraceEvent::DeviceInterfaceNameChanged:
+        case TraceEvent::DeviceDetailsChanged:
+        case TraceEvent::DeviceStatisticsChanged:
+        case TraceEvent::DeviceSignalChanged:
+            stream >> event.device;
+            break;
+        case TraceEvent::AvailableConnectionAppeared:
+        case TraceEvent::AvailableConnectionDisappeared:
+            stream >> event.device >> event.path;
+            break;
+        case TraceEvent::VpnConnectionStateChanged: {
+            qint32 reason;
+            stream >> event.activeConnection >> reason;
+            event.vpnStateReason = static_cast<NetworkManager::VpnConnection::StateChangeReason>(reason);
+            break;
+        }
+        case TraceEvent::ActiveConnectionAdded:
+        case TraceEvent::ActiveConnectionStateChanged:
+        case TraceEvent::VpnConnectionBannerChanged:
+            stream >> event.activeConnection;
+            break;
+        case TraceEvent::ConnectionAdded:
+        case TraceEvent::ConnectionUpdated:
+            stream >> event.connection;
+            break;
+        case TraceEvent::WirelessNetworkAppeared:
+        case TraceEvent::WirelessNetworkDisappeared:
+        case TraceEvent::WirelessNetworkSignalChanged:
+        case TraceEvent::WirelessNetworkReferenceAccessPointChanged:
+            stream >> event.network;
+            break;
+        case TraceEvent::AccessPointSignalChanged:
+            stream >> event.network >> event.path;
+            break;
+        case TraceEvent::SnapshotEnd:
+            break;
+        default:
+            stream.setStatus(QDataStream::ReadCorruptData);
+            break;
+    }
+
+    return stream;
+}
+
+TraceBackend::TraceBackend(QObject *parent)
+    : NetworkBackend(parent)
+    , m_position(0)
+    , m_speed(0)
+    , m_replayTimer(new QTimer(this))
+    , m_startTime(0)
+    , m_status(NetworkManager::Unknown)
+    , m_connectivity(NetworkManager::UnknownConnectivity)
+{
+    m_replayTimer->setSingleShot(true);
+    connect(m_replayTimer, &QTimer::timeout, this, &TraceBackend::replayNext);
+}
+
+TraceBackend::~TraceBackend()
+{
+}
+
+void TraceBackend::writeHeader(QDataStream &stream)
+{
+    stream.setVersion(QDataStream::Qt_5_15);
+    stream << quint32(TRACE_MAGIC) << quint32(TRACE_VERSION);
+}
+
+bool TraceBackend::load(QIODevice *device)
+{
+    QDataStream stream(device);
+    stream.setVersion(QDataStream::Qt_5_15);
+
+    quint32 magic, version;
+    stream >> magic >> version;
+    if (stream.status() != QDataStream::Ok || magic != TRACE_MAGIC) {
+        qCWarning(PLASMA_NM) << "Not a plasma-nm trace";
+        return false;
+    }
+    if (version != TRACE_VERSION) {
+        qCWarning(PLASMA_NM) << "Unsupported trace version" << version;
+        return false;
+    }
+
+    stop();
+    m_events.clear();
+    m_position = 0;
+    m_status = NetworkManager::Unknown;
+    m_connectivity = NetworkManager::UnknownConnectivity;
+    m_primaryConnection.clear();
+    m_devices.clear();
+    m_activeConnections.clear();
+    m_connections.clear();
+    m_networks.clear();
+
+    bool snapshot = true;
+    while (!stream.atEnd()) {
+        TraceEvent event;
+        stream >> event;
+        if (stream.status() != QDataStream::Ok) {
+            // The recording might have been interrupted, what we have so far can still be replayed
+            qCWarning(PLASMA_NM) << "Trace is truncated after" << m_events.count() << "events";
+            break;
+        }
+
+        if (snapshot) {
+            if (event.type == TraceEvent::SnapshotEnd) {
+                snapshot = false;
+            } else {
+                apply(event, true);
+            }
+        } else {
+            m_events << event;
+        }
+    }
+
+    return true;
+}
+
+bool TraceBackend::load(const QString &fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCWarning(PLASMA_NM) << "Failed to open trace" << fileName << ":" << file.errorString();
+        return false;
+    }
+
+    return load(&file);
+}
+
+qreal TraceBackend::speed() const
+{
+    return m_speed;
+}
+
+void TraceBackend::setSpeed(qreal speed)
+{
+    m_speed = qMax<qreal>(0, speed);
+}
+
+void TraceBackend::start()
+{
+    if (!atEnd()) {
+        m_startTime = m_events.at(m_position).time;
+    }
+    m_clock.start();
+    scheduleNext();
+}
+
+void TraceBackend::stop()
+{
+    m_replayTimer->stop();
+}
+
+bool TraceBackend::step()
+{
+    if (atEnd()) {
+        return false;
+    }
+
+    apply(m_events.at(m_position++), false);
+    return true;
+}
+
+void TraceBackend::rewind()
+{
+    stop();
+    m_position = 0;
+}
+
+bool TraceBackend::atEnd() const
+{
+    return m_position >= m_events.count();
+}
+
+int TraceBackend::eventCount() const
+{
+    return m_events.count();
+}
+
+int TraceBackend::position() const
+{
+    return m_position;
+}
+
+void TraceBackend::replayNext()
+{
+    // Events recorded at the same time arrived together, they are replayed without returning to the event loop
+    const qint64 time = m_events.at(m_position).time;
+    do {
+        step();
+    } while (!atEnd() && m_events.at(m_position).time == time);
+
+    scheduleNext();
+}
+
+void TraceBackend::scheduleNext()
+{
+    if (atEnd()) {
+        Q_EMIT finished();
+        return;
+    }
+
+    qint64 delay = 0;
+    if (m_speed > 0) {
+        delay = qMax<qint64>(0, qint64((m_events.at(m_position).time - m_startTime) / m_speed) - m_clock.elapsed());
+    }
+    m_replayTimer->start(delay);
+}
+
+void TraceBackend::apply(const TraceEvent &event, bool silent)
+{
+    switch (event.type) {
+        case TraceEvent::Status:
+            m_status = event.status;
+            if (!silent) {
+                Q_EMIT statusChanged(event.status);
+            }
+            break;
+        case TraceEvent::ConnectivityChanged:
+            m_connectivity = event.connectivity;
+            if (!silent) {
+                Q_EMIT connectivityChanged(event.connectivity);
+            }
+            break;
+        case TraceEvent::PrimaryConnectionChanged:
+            m_primaryConnection = event.path;
+            if (!silent) {
+                Q_EMIT primaryConnectionChanged(event.path);
+            }
+            break;
+        case TraceEvent::DeviceAdded:
+            m_devices.insert(event.device.path, event.device);
+            if (!silent) {
+                Q_EMIT deviceAdded(event.device.path);
+            }
+            break;
+        case TraceEvent::DeviceRemoved:
+            m_devices.remove(event.path);
+            m_networks.remove(event.path);
+            if (!silent) {
+                Q_EMIT deviceRemoved(event.path);
+            }
+            break;
+        case TraceEvent::DeviceStateChanged:
+            m_devices.insert(event.device.path, event.device);
+            if (!silent) {
+                Q_EMIT deviceStateChanged(event.device.path, event.device.state, event.oldDeviceState, event.deviceStateReason);
+            }
+            break;
+        case TraceEvent::DeviceInterfaceNameChanged:
+            m_devices.insert(event.device.path, event.device);
+            if (!silent) {
+                Q_EMIT deviceInterfaceNameChanged(event.device.path);
+            }
+            break;
+        case TraceEvent::DeviceDetailsChanged:
+            m_devices.insert(event.device.path, event.device);
+            if (!silent) {
+                Q_EMIT deviceDetailsChanged(event.device.path);
+            }
+            break;
+        case TraceEvent::DeviceStatisticsChanged:
+            m_devices.insert(event.device.path, event.device);
+            if (!silent) {
+                Q_EMIT deviceStatisticsChanged(event.device.path, event.device.rxBytes, event.device.txBytes);
+            }
+            break;
+        case TraceEvent::DeviceSignalChanged:
+            m_devices.insert(event.device.path, event.device);
+            if (!silent) {
+                Q_EMIT deviceSignalChanged(event.device.path, event.device.signal);
+            }
+            break;
+        case TraceEvent::AvailableConnectionAppeared:
+            m_devices.insert(event.device.path, event.device);
+            if (!silent) {
+                Q_EMIT availableConnectionAppeared(event.device.path, event.path);
+            }
+            break;
+        case TraceEvent::AvailableConnectionDisappeared:
+            m_devices.insert(event.device.path, event.device);
+            if (!silent) {
+                Q_EMIT availableConnectionDisappeared(event.device.path, event.path);
+            }
+            break;
+        case TraceEvent::ActiveConnectionAdded:
+            m_activeConnections.insert(event.activeConnection.path, event.activeConnection);
+            if (!silent) {
+                Q_EMIT activeConnectionAdded(event.activeConnection.path);
+            }
+            break;
+        case TraceEvent::ActiveConnectionRemoved:
+            m_activeConnections.remove(event.path);
+            if (!silent) {
+                Q_EMIT activeConnectionRemoved(event.path);
+            }
+            break;
+        case TraceEvent::ActiveConnectionStateChanged:
+            m_activeConnections.insert(event.activeConnection.path, event.activeConnection);
+            if (!silent) {
+                Q_EMIT activeConnectionStateChanged(event.activeConnection.path, event.activeConnection.state);
+            }
+            break;
+        case TraceEvent::VpnConnectionStateChanged:
+            m_activeConnections.insert(event.activeConnection.path, event.activeConnection);
+            if (!silent) {
+                Q_EMIT vpnConnectionStateChanged(event.activeConnection.path, event.activeConnection.vpnState, event.vpnStateReason);
+            }
+            break;
+        case TraceEvent::VpnConnectionBannerChanged:
+            m_activeConnections.insert(event.activeConnection.path, event.activeConnection);
+            if (!silent) {
+                Q_EMIT vpnConnectionBannerChanged(event.activeConnection.path, event.activeConnection.vpnBanner);
+            }
+            break;
+        case TraceEvent::ConnectionAdded:
+            m_connections.insert(event.connection.path, event.connection);
+            if (!silent) {
+                Q_EMIT connectionAdded(event.connection.path);
+            }
+            break;
+        case TraceEvent::ConnectionRemoved:
+            m_connections.remove(event.path);
+            if (!silent) {
+                Q_EMIT connectionRemoved(event.path);
+            }
+            break;
+        case TraceEvent::ConnectionUpdated:
+            m_connections.insert(event.connection.path, event.connection);
+            if (!silent) {
+                Q_EMIT connectionUpdated(event.connection.path);
+            }
+            break;
+        case TraceEvent::WirelessNetworkAppeared:
+            m_networks[event.network.devicePath].insert(event.network.ssid, event.network);
+            if (!silent) {
+                Q_EMIT wirelessNetworkAppeared(event.network.devicePath, event.network.ssid);
+            }
+            break;
+        case TraceEvent::WirelessNetworkDisappeared:
+            m_networks[event.network.devicePath].remove(event.network.ssid);
+            if (!silent) {
+                Q_EMIT wirelessNetworkDisappeared(event.network.devicePath, event.network.ssid);
+            }
+            break;
+        case TraceEvent::WirelessNetworkSignalChanged:
+            m_networks[event.network.devicePath].insert(event.network.ssid, event.network);
+            if (!silent) {
+                Q_EMIT wirelessNetworkSignalChanged(event.network.devicePath, event.network.ssid, event.network.referenceAccessPoint.path, event.network.signal);
+            }
+            break;
+        case TraceEvent::WirelessNetworkReferenceAccessPointChanged:
+            m_networks[event.network.devicePath].insert(event.network.ssid, event.network);
+            if (!silent) {
+                Q_EMIT wirelessNetworkReferenceAccessPointChanged(event.network.devicePath, event.network.ssid, event.network.referenceAccessPoint.path);
+            }
+            break;
+        case TraceEvent::AccessPointSignalChanged:
+            m_networks[event.network.devicePath].insert(event.network.ssid, event.network);
+            if (!silent) {
+                for (const BackendAccessPoint &accessPoint : event.network.accessPoints) {
+                    if (accessPoint.path == event.path) {
+                        Q_EMIT accessPointSignalChanged(event.network.devicePath, event.path, accessPoint.signal);
+                        break;
+                    }
+                }
+            }
+            break;
+        case TraceEvent::SnapshotEnd:
+            break;
+    }
+}
+
+NetworkManager::Status TraceBackend::status() const
+{
+    return m_status;
+}
+
+NetworkManager::Connectivity TraceBackend::connectivity() const
+{
+    return m_connectivity;
+}
+
+QString TraceBackend::primaryConnection() const
+{
+    return m_primaryConnection;
+}
+
+QStringList TraceBackend::devices() const
+{
+    return m_devices.keys();
+}
+
+BackendDevice TraceBackend::device(const QString &path) const
+{
+    return m_devices.value(path);
+}
+
+QStringList TraceBackend::activeConnections() const
+{
+    return m_activeConnections.keys();
+}
+
+BackendActiveConnection TraceBackend::activeConnection(const QString &path) const
+{
+    return m_activeConnections.value(path);
+}
+
+ConnectionSummary TraceBackend::connection(const QString &path) const
+{
+    return m_connections.value(path);
+}
+
+void TraceBackend::listConnections()
+{
+    // Delivered asynchronously like the reply of NetworkManager
+    QTimer::singleShot(0, this, [this] () {
+        Q_EMIT connectionsListed(m_connections.keys());
+    });
+}
+
+QStringList TraceBackend::wirelessNetworks(const QString &devicePath) const
+{
+    return m_networks.value(devicePath).keys();
+}
+
+BackendWirelessNetwork TraceBackend::wirelessNetwork(const QString &devicePath, const QString &ssid) const
+{
+    return m_networks.value(devicePath).value(ssid);
+}
+
+BackendWirelessNetwork TraceBackend::wirelessNetworkOfAccessPoint(const QString &devicePath, const QString &accessPoint) const
+{
+    const QMap<QString, BackendWirelessNetwork> networks = m_networks.value(devicePath);
+    for (const BackendWirelessNetwork &network : networks) {
+        for (const BackendAccessPoint &ap : network.accessPoints) {
+            if (ap.path == accessPoint) {
+                return network;
+            }
+        }
+    }
+
+    return BackendWirelessNetwork();
+}
+
+void TraceBackend::watchAccessPoint(const QString &devicePath, const QString &accessPoint)
+{
+    // The trace contains the signal changes of every access point watched while recording
+    Q_UNUSED(devicePath);
+    Q_UNUSED(accessPoint);
+}
+
+void TraceBackend::setDeviceStatisticsRefreshRateMs(QObject *consumer, const QString &devicePath, uint refreshRate)
+{
+    // The trace carries the statistics sampled while recording, the requests only decide which refresh rate is reported
+    if (!consumer || devicePath.isEmpty()) {
+        return;
+    }
+
+    if (refreshRate) {
+        m_statisticsRequests[devicePath].insert(consumer, refreshRate);
+        connect(consumer, &QObject::destroyed, this, &TraceBackend::releaseDeviceStatistics, Qt::UniqueConnection);
+        return;
+    }
+
+    auto it = m_statisticsRequests.find(devicePath);
+    if (it != m_statisticsRequests.end()) {
+        it->remove(consumer);
+        if (it->isEmpty()) {
+            m_statisticsRequests.erase(it);
+        }
+    }
+}
+
+void TraceBackend::releaseDeviceStatistics(QObject *consumer)
+{
+    for (auto it = m_statisticsRequests.begin(); it != m_statisticsRequests.end();) {
+        it->remove(consumer);
+        it = it->isEmpty() ? m_statisticsRequests.erase(it) : it + 1;
+    }
+}
+
+uint TraceBackend::deviceStatisticsRefreshRateMs(const QString &devicePath) const
+{
+    uint refreshRate = 0;
+    for (uint requested : m_statisticsRequests.value(devicePath)) {
+        if (!refreshRate || requested < refreshRate) {
+            refreshRate = requested;
+        }
+    }
+    return refreshRate;
+}
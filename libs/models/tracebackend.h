@@ -0,0 +1,191 @@
+/*
+    Copyright 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PLASMA_NM_TRACE_BACKEND_H
+#define PLASMA_NM_TRACE_BACKEND_H
+
+#include "networkbackend.h"
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMap>
+#include <QVector>
+
+class QIODevice;
+class QTimer;
+
+/**
+ * One entry of a trace, the state changes carry the complete new state of the object
+ */
+class Q_DECL_EXPORT TraceEvent
+{
+public:
+    enum Type {
+        Status,                         // status
+        DeviceAdded,                    // device
+        DeviceRemoved,                  // path of the device
+        DeviceStateChanged,             // device, old state and reason
+        DeviceInterfaceNameChanged,     // device
+        DeviceDetailsChanged,           // device
+        DeviceStatisticsChanged,        // device
+        DeviceSignalChanged,            // device
+        AvailableConnectionAppeared,    // device, path of the connection
+        AvailableConnectionDisappeared, // device, path of the connection
+        ActiveConnectionAdded,          // activeConnection
+        ActiveConnectionRemoved,        // path of the active connection
+        ActiveConnectionStateChanged,   // activeConnection
+        VpnConnectionStateChanged,      // activeConnection, reason
+        VpnConnectionBannerChanged,     // activeConnection
+        ConnectionAdded,                // connection
+        ConnectionRemoved,              // path of the connection
+        ConnectionUpdated,              // connection
+        WirelessNetworkAppeared,        // network
+        WirelessNetworkDisappeared,     // network, only its device path and SSID are used
+        WirelessNetworkSignalChanged,   // network
+        WirelessNetworkReferenceAccessPointChanged, // network
+        AccessPointSignalChanged,       // network the access point belongs to, path of the access point
+        // Separates the initial state from the events recorded afterwards
+        SnapshotEnd,
+        ConnectivityChanged,            // connectivity
+        PrimaryConnectionChanged        // path of the active connection, empty when there is none
+    };
+
+    // Milliseconds since the start of the recording
+    qint64 time = 0;
+    Type type = Status;
+    QString path;
+    NetworkManager::Status status = NetworkManager::Unknown;
+    NetworkManager::Connectivity connectivity = NetworkManager::UnknownConnectivity;
+    BackendDevice device;
+    NetworkManager::Device::State oldDeviceState = NetworkManager::Device::UnknownState;
+    NetworkManager::Device::StateChangeReason deviceStateReason = NetworkManager::Device::UnknownReason;
+    NetworkManager::VpnConnection::StateChangeReason vpnStateReason = NetworkManager::VpnConnection::UnknownReason;
+    BackendActiveConnection activeConnection;
+    ConnectionSummary connection;
+    BackendWirelessNetwork network;
+};
+
+Q_DECL_EXPORT QDataStream &operator<<(QDataStream &stream, const TraceEvent &event);
+Q_DECL_EXPORT QDataStream &operator>>(QDataStream &stream, TraceEvent &event);
+
+/**
+ * NetworkBackend replaying a recorded trace, without any D-Bus traffic. The trace starts with
+ * the state at the time the recording started, which is available right after load(), followed
+ * by the recorded events. Events are replayed either by the event loop, as fast as possible or
+ * scaled to the recorded timing, or synchronously one by one through step().
+ */
+class Q_DECL_EXPORT TraceBackend : public NetworkBackend
+{
+Q_OBJECT
+public:
+    explicit TraceBackend(QObject *parent = nullptr);
+    ~TraceBackend() override;
+
+    /**
+     * Writes the header every trace starts with
+     */
+    static void writeHeader(QDataStream &stream);
+
+    /**
+     * Reads a trace written by writeHeader() and the TraceEvent operators and applies its initial state
+     */
+    bool load(QIODevice *device);
+    bool load(const QString &fileName);
+
+    /**
+     * Replay speed relative to the recording, 0 (the default) replays the events as fast as possible
+     */
+    qreal speed() const;
+    void setSpeed(qreal speed);
+
+    /**
+     * Starts replaying the remaining events from the event loop, finished() is emitted after the last one
+     */
+    void start();
+    void stop();
+    /**
+     * Replays the next event synchronously, returns false when there is none
+     */
+    bool step();
+    /**
+     * Continues with the first recorded event. The state isn't reset, so this is meant for traces
+     * whose events can be applied over and over, like the scripted sequences of the benchmarks.
+     */
+    void rewind();
+    bool atEnd() const;
+    int eventCount() const;
+    int position() const;
+
+    NetworkManager::Status status() const override;
+    NetworkManager::Connectivity connectivity() const override;
+    QString primaryConnection() const override;
+
+    QStringList devices() const override;
+    BackendDevice device(const QString &path) const override;
+
+    QStringList activeConnections() const override;
+    BackendActiveConnection activeConnection(const QString &path) const override;
+
+    ConnectionSummary connection(const QString &path) const override;
+    void listConnections() override;
+
+    QStringList wirelessNetworks(const QString &devicePath) const override;
+    BackendWirelessNetwork wirelessNetwork(const QString &devicePath, const QString &ssid) const override;
+    BackendWirelessNetwork wirelessNetworkOfAccessPoint(const QString &devicePath, const QString &accessPoint) const override;
+    void watchAccessPoint(const QString &devicePath, const QString &accessPoint) override;
+
+    void setDeviceStatisticsRefreshRateMs(QObject *consumer, const QString &devicePath, uint refreshRate) override;
+    void releaseDeviceStatistics(QObject *consumer) override;
+    uint deviceStatisticsRefreshRateMs(const QString &devicePath) const override;
+
+Q_SIGNALS:
+    void finished();
+
+private Q_SLOTS:
+    void replayNext();
+
+private:
+    /**
+     * Updates the state from the event and emits the corresponding signal unless @p silent
+     */
+    void apply(const TraceEvent &event, bool silent);
+    void scheduleNext();
+
+    QVector<TraceEvent> m_events;
+    int m_position;
+    qreal m_speed;
+    QTimer *m_replayTimer;
+    // Recording time of the event replayed first after start() and the time since then
+    qint64 m_startTime;
+    QElapsedTimer m_clock;
+
+    NetworkManager::Status m_status;
+    NetworkManager::Connectivity m_connectivity;
+    QString m_primaryConnection;
+    QMap<QString, BackendDevice> m_devices;
+    QMap<QString, BackendActiveConnection> m_activeConnections;
+    QMap<QString, ConnectionSummary> m_connections;
+    // Wireless networks per device path and SSID
+    QMap<QString, QMap<QString, BackendWirelessNetwork>> m_networks;
+    // Requested statistics refresh rates per device and consumer
+    QHash<QString, QHash<QObject*, uint>> m_statisticsRequests;
+};
+
+#endif // PLASMA_NM_TRACE_BACKEND_H
@@ -0,0 +1,351 @@
+/*
+    Copyright 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "tracerecorder.h"
+#include "debug.h"
+
+#include <QFile>
+
+TraceRecorder::TraceRecorder(NetworkBackend *backend, QObject *parent)
+    : QObject(parent)
+    , m_backend(backend)
+    , m_file(nullptr)
+    , m_listing(false)
+    , m_eventCount(0)
+{
+}
+
+TraceRecorder::~TraceRecorder()
+{
+    stop();
+}
+
+void TraceRecorder::start(QIODevice *device)
+{
+    stop();
+
+    m_stream.setDevice(device);
+    TraceBackend::writeHeader(m_stream);
+    m_eventCount = 0;
+
+    // The initial state is complete only with all the saved connections
+    m_listing = true;
+    connect(m_backend, &NetworkBackend::connectionsListed, this, &TraceRecorder::connectionsListed, Qt::UniqueConnection);
+    m_backend->listConnections();
+}
+
+bool TraceRecorder::start(const QString &fileName)
+{
+    QFile *file = new QFile(fileName, this);
+    if (!file->open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qCWarning(PLASMA_NM) << "Failed to open trace" << fileName << ":" << file->errorString();
+        delete file;
+        return false;
+    }
+
+    start(file);
+    m_file = file;
+    return true;
+}
+
+void TraceRecorder::stop()
+{
+    disconnect(m_backend, nullptr, this, nullptr);
+    m_listing = false;
+
+    if (!m_stream.device()) {
+        return;
+    }
+
+    m_stream.setDevice(nullptr);
+    if (m_file) {
+        m_file->close();
+        m_file->deleteLater();
+        m_file = nullptr;
+    }
+    qCDebug(PLASMA_NM) << "Trace recording stopped after" << m_eventCount << "events";
+}
+
+bool TraceRecorder::isRecording() const
+{
+    return m_stream.device() && !m_listing;
+}
+
+int TraceRecorder::eventCount() const
+{
+    return m_eventCount;
+}
+
+void TraceRecorder::connectionsListed(const QStringList &connections)
+{
+    // Listings requested by someone else sharing the backend are of no interest once recording
+    if (!m_listing) {
+        return;
+    }
+    m_listing = false;
+
+    writeSnapshot(connections);
+    m_clock.start();
+    initializeSignals();
+    Q_EMIT started();
+}
+
+void TraceRecorder::writeSnapshot(const QStringList &connections)
+{
+    TraceEvent status;
+    status.type = TraceEvent::Status;
+    status.status = m_backend->status();
+    m_stream << status;
+
+    for (const QString &connection : connections) {
+        TraceEvent event = connectionEvent(TraceEvent::ConnectionAdded, connection);
+        if (event.connection.isValid()) {
+            m_stream << event;
+        }
+    }
+
+    for (const QString &device : m_backend->devices()) {
+        m_stream << deviceEvent(TraceEvent::DeviceAdded, device);
+        for (const QString &ssid : m_backend->wirelessNetworks(device)) {
+            m_stream << wirelessNetworkEvent(TraceEvent::WirelessNetworkAppeared, device, ssid);
+        }
+    }
+
+    for (const QString &activeConnection : m_backend->activeConnections()) {
+        m_stream << activeConnectionEvent(TraceEvent::ActiveConnectionAdded, activeConnection);
+    }
+
+    // Both refer to the active connections above
+    TraceEvent connectivity;
+    connectivity.type = TraceEvent::ConnectivityChanged;
+    connectivity.connectivity = m_backend->connectivity();
+    m_stream << connectivity;
+    m_stream << pathEvent(TraceEvent::PrimaryConnectionChanged, m_backend->primaryConnection());
+
+    TraceEvent end;
+    end.type = TraceEvent::SnapshotEnd;
+    m_stream << end;
+}
+
+void TraceRecorder::initializeSignals()
+{
+    connect(m_backend, &NetworkBackend::statusChanged, this, [this] (NetworkManager::Status status) {
+        TraceEvent event;
+        event.type = TraceEvent::Status;
+        event.status = status;
+        record(event);
+    });
+    connect(m_backend, &NetworkBackend::connectivityChanged, this, [this] (NetworkManager::Connectivity connectivity) {
+        TraceEvent event;
+        event.type = TraceEvent::ConnectivityChanged;
+        event.connectivity = connectivity;
+        record(event);
+    });
+    connect(m_backend, &NetworkBackend::primaryConnectionChanged, this, [this] (const QString &path) {
+        TraceEvent event = pathEvent(TraceEvent::PrimaryConnectionChanged, path);
+        record(event);
+    });
+
+    connect(m_backend, &NetworkBackend::deviceAdded, this, [this] (const QString &path) {
+        TraceEvent event = deviceEvent(TraceEvent::DeviceAdded, path);
+        record(event);
+    });
+    connect(m_backend, &NetworkBackend::deviceRemoved, this, [this] (const QString &path) {
+        TraceEvent event = pathEvent(TraceEvent::DeviceRemoved, path);
+        record(event);
+    });
+    connect(m_backend, &NetworkBackend::deviceStateChanged, this, [this] (const QString &path, NetworkManager::Device::State state,
+                                                                         NetworkManager::Device::State oldState, NetworkManager::Device::StateChangeReason reason) {
+        TraceEvent event = deviceEvent(TraceEvent::DeviceStateChanged, path);
+        event.device.state = state;
+        event.oldDeviceState = oldState;
+        event.deviceStateReason = reason;
+        record(event);
+    });
+    connect(m_backend, &NetworkBackend::deviceInterfaceNameChanged, this, [this] (const QString &path) {
+        TraceEvent event = deviceEvent(TraceEvent::DeviceInterfaceNameChanged, path);
+        record(event);
+    });
+    connect(m_backend, &NetworkBackend::deviceDetailsChanged, this, [this] (const QString &path) {
+        TraceEvent event = deviceEvent(TraceEvent::DeviceDetailsChanged, path);
+        record(event);
+    });
+    connect(m_backend, &NetworkBackend::deviceStatisticsChanged, this, [this] (const QString &path, qulonglong rxBytes, qulonglong txBytes) {
+        TraceEvent event = deviceEvent(TraceEvent::DeviceStatisticsChanged, path);
+        event.device.rxBytes = rxBytes;
+        event.device.txBytes = txBytes;
+        record(event);
+    });
+    connect(m_backend, &NetworkBackend::deviceSignalChanged, this, [this] (const QString &path, int signal) {
+        TraceEvent event = deviceEvent(TraceEvent::DeviceSignalChanged, path);
+        event.device.signal = signal;
+        record(event);
+    });
+    connect(m_backend, &NetworkBackend::availableConnectionAppeared, this, [this] (const QString &devicePath, const QString &connection) {
+        TraceEvent event = deviceEvent(TraceEvent::AvailableConnectionAppeared, devicePath);
+        event.path = connection;
+        record(event);
+    });
+    connect(m_backend, &NetworkBackend::availableConnectionDisappeared, this, [this] (const QString &devicePath, const QString &connection) {
+        TraceEvent event = deviceEvent(TraceEvent::AvailableConnectionDisappeared, devicePath);
+        event.path = connection;
+        record(event);
+    });
+
+    connect(m_backend, &NetworkBackend::activeConnectionAdded, this, [this] (const QString &path) {
+        TraceEvent event = activeConnectionEvent(TraceEvent::ActiveConnectionAdded, path);
+        record(event);
+    });
+    connect(m_backend, &NetworkBackend::activeConnectionRemoved, this, [this] (const QString &path) {
+        TraceEvent event = pathEvent(TraceEvent::ActiveConnectionRemoved, path);
+        record(event);
+    });
+    connect(m_backend, &NetworkBackend::activeConnectionStateChanged, this, [this] (const QString &path, NetworkManager::ActiveConnection::State state) {
+        TraceEvent event = activeConnectionEvent(TraceEvent::ActiveConnectionStateChanged, path);
+        event.activeConnection.state = state;
+        record(event);
+    });
+    connect(m_backend, &NetworkBackend::vpnConnectionStateChanged, this, [this] (const QString &path, NetworkManager::VpnConnection::State state,
+                                                                                NetworkManager::VpnConnection::StateChangeReason reason) {
+        TraceEvent event = activeConnectionEvent(TraceEvent::VpnConnectionStateChanged, path);
+        event.activeConnection.vpnState = state;
+        event.vpnStateReason = reason;
+        record(event);
+    });
+    connect(m_backend, &NetworkBackend::vpnConnectionBannerChanged, this, [this] (const QString &path, const QString &banner) {
+        TraceEvent event = activeConnectionEvent(TraceEvent::VpnConnectionBannerChanged, path);
+        event.activeConnection.vpnBanner = banner;
+        record(event);
+    });
+
+    connect(m_backend, &NetworkBackend::connectionAdded, this, [this] (const QString &path) {
+        TraceEvent event = connectionEvent(TraceEvent::ConnectionAdded, path);
+        if (event.connection.isValid()) {
+            record(event);
+        }
+    });
+    connect(m_backend, &NetworkBackend::connectionRemoved, this, [this] (const QString &path) {
+        TraceEvent event = pathEvent(TraceEvent::ConnectionRemoved, path);
+        record(event);
+    });
+    connect(m_backend, &NetworkBackend::connectionUpdated, this, [this] (const QString &path) {
+        TraceEvent event = connectionEvent(TraceEvent::ConnectionUpdated, path);
+        if (event.connection.isValid()) {
+            record(event);
+        }
+    });
+
+    connect(m_backend, &NetworkBackend::wirelessNetworkAppeared, this, [this] (const QString &devicePath, const QString &ssid) {
+        TraceEvent event = wirelessNetworkEvent(TraceEvent::WirelessNetworkAppeared, devicePath, ssid);
+        record(event);
+    });
+    connect(m_backend, &NetworkBackend::wirelessNetworkDisappeared, this, [this] (const QString &devicePath, const QString &ssid) {
+        // The network is gone already, its device and SSID are all the replay needs
+        TraceEvent event;
+        event.type = TraceEvent::WirelessNetworkDisappeared;
+        event.network.devicePath = devicePath;
+        event.network.ssid = ssid;
+        record(event);
+    });
+    connect(m_backend, &NetworkBackend::wirelessNetworkSignalChanged, this, [this] (const QString &devicePath, const QString &ssid, const QString &referenceAccessPoint, int signal) {
+        TraceEvent event = wirelessNetworkEvent(TraceEvent::WirelessNetworkSignalChanged, devicePath, ssid);
+        event.network.referenceAccessPoint.path = referenceAccessPoint;
+        event.network.signal = signal;
+        record(event);
+    });
+    connect(m_backend, &NetworkBackend::wirelessNetworkReferenceAccessPointChanged, this, [this] (const QString &devicePath, const QString &ssid, const QString &accessPoint) {
+        TraceEvent event = wirelessNetworkEvent(TraceEvent::WirelessNetworkReferenceAccessPointChanged, devicePath, ssid);
+        event.network.referenceAccessPoint.path = accessPoint;
+        record(event);
+    });
+    connect(m_backend, &NetworkBackend::accessPointSignalChanged, this, [this] (const QString &devicePath, const QString &accessPoint, int signal) {
+        TraceEvent event;
+        event.type = TraceEvent::AccessPointSignalChanged;
+        event.path = accessPoint;
+        event.network = m_backend->wirelessNetworkOfAccessPoint(devicePath, accessPoint);
+        if (!event.network.isValid()) {
+            return;
+        }
+        for (BackendAccessPoint &ap : event.network.accessPoints) {
+            if (ap.path == accessPoint) {
+                ap.signal = signal;
+            }
+        }
+        record(event);
+    });
+}
+
+void TraceRecorder::record(TraceEvent &event)
+{
+    event.time = m_clock.elapsed();
+    m_stream << event;
+    ++m_eventCount;
+}
+
+TraceEvent TraceRecorder::deviceEvent(TraceEvent::Type type, const QString &path) const
+{
+    TraceEvent event;
+    event.type = type;
+    event.device = m_backend->device(path);
+    // Keep the path even when the device is already gone
+    event.device.path = path;
+    return event;
+}
+
+TraceEvent TraceRecorder::activeConnectionEvent(TraceEvent::Type type, const QString &path) const
+{
+    TraceEvent event;
+    event.type = type;
+    event.activeConnection = m_backend->activeConnection(path);
+    event.activeConnection.path = path;
+    return event;
+}
+
+TraceEvent TraceRecorder::connectionEvent(TraceEvent::Type type, const QString &path) const
+{
+    TraceEvent event;
+    event.type = type;
+    event.connection = m_backend->connection(path);
+    return event;
+}
+
+TraceEvent TraceRecorder::wirelessNetworkEvent(TraceEvent::Type type, const QString &devicePath, const QString &ssid)
+{
+    TraceEvent event;
+    event.type = type;
+    event.network = m_backend->wirelessNetwork(devicePath, ssid);
+    event.network.devicePath = devicePath;
+    event.network.ssid = ssid;
+
+    // The backend reports signal changes of single access points only for the watched ones
+    for (const BackendAccessPoint &ap : qAsConst(event.network.accessPoints)) {
+        m_backend->watchAccessPoint(devicePath, ap.path);
+    }
+
+    return event;
+}
+
+TraceEvent TraceRecorder::pathEvent(TraceEvent::Type type, const QString &path) const
+{
+    TraceEvent event;
+    event.type = type;
+    event.path = path;
+    return event;
+}
@@ -0,0 +1,87 @@
+/*
+    Copyright 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PLASMA_NM_TRACE_RECORDER_H
+#define PLASMA_NM_TRACE_RECORDER_H
+
+#include "tracebackend.h"
+
+#include <QDataStream>
+#include <QElapsedTimer>
+#include <QObject>
+
+class QFile;
+
+/**
+ * Records what a NetworkBackend reports into a trace TraceBackend can replay. The trace starts
+ * with the state of the backend once all the saved connections are listed, every change
+ * reported afterwards is appended together with the new state of the object.
+ */
+class Q_DECL_EXPORT TraceRecorder : public QObject
+{
+Q_OBJECT
+public:
+    explicit TraceRecorder(NetworkBackend *backend, QObject *parent = nullptr);
+    ~TraceRecorder() override;
+
+    /**
+     * Starts recording into @p device, which has to stay open until stop()
+     */
+    void start(QIODevice *device);
+    bool start(const QString &fileName);
+    void stop();
+
+    bool isRecording() const;
+    /**
+     * Number of events recorded after the initial state
+     */
+    int eventCount() const;
+
+Q_SIGNALS:
+    /**
+     * The initial state is written, changes are recorded from now on
+     */
+    void started();
+
+private Q_SLOTS:
+    void connectionsListed(const QStringList &connections);
+
+private:
+    void initializeSignals();
+    void record(TraceEvent &event);
+    // Events carrying the current state of the object from the backend
+    TraceEvent deviceEvent(TraceEvent::Type type, const QString &path) const;
+    TraceEvent activeConnectionEvent(TraceEvent::Type type, const QString &path) const;
+    TraceEvent connectionEvent(TraceEvent::Type type, const QString &path) const;
+    TraceEvent wirelessNetworkEvent(TraceEvent::Type type, const QString &devicePath, const QString &ssid);
+    // Events carrying only a path, e.g. of a removed object
+    TraceEvent pathEvent(TraceEvent::Type type, const QString &path) const;
+    void writeSnapshot(const QStringList &connections);
+
+    NetworkBackend *m_backend;
+    QFile *m_file;
+    QDataStream m_stream;
+    QElapsedTimer m_clock;
+    // Waiting for the saved connections to be listed
+    bool m_listing;
+    int m_eventCount;
+};
+
+#endif // PLASMA_NM_TRACE_RECORDER_H
@@ -0,0 +1,134 @@
+/*
+    Copyright 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "trafficrates.h"
+
+TrafficRates::TrafficRates()
+    : m_first(0)
+    , m_count(0)
+{
+}
+
+void TrafficRates::addSample(qint64 timestamp, qulonglong rxBytes, qulonglong txBytes)
+{
+    if (m_count) {
+        const int lastIndex = (m_first + m_count - 1) % m_samples.size();
+        Sample &last = m_samples[lastIndex];
+
+        if (timestamp - last.timestamp < MergeInterval) {
+            last.rxBytes = rxBytes;
+            last.txBytes = txBytes;
+            return;
+        }
+
+        // Counters were reset or nothing was sampled for a while, previous rates are meaningless
+        if (timestamp - last.timestamp > MaximumGap || rxBytes < last.rxBytes || txBytes < last.txBytes) {
+            clear();
+        }
+    }
+
+    if (m_count < static_cast<int>(m_samples.size())) {
+        m_samples[(m_first + m_count) % m_samples.size()] = {timestamp, rxBytes, txBytes};
+        ++m_count;
+    } else {
+        m_samples[m_first] = {timestamp, rxBytes, txBytes};
+        m_first = (m_first + 1) % m_samples.size();
+    }
+}
+
+void TrafficRates::clear()
+{
+    m_first = 0;
+    m_count = 0;
+}
+
+bool TrafficRates::isEmpty() const
+{
+    return !m_count;
+}
+
+qint64 TrafficRates::lastTimestamp() const
+{
+    return m_count ? sampleAt(m_count - 1).timestamp : 0;
+}
+
+qulonglong TrafficRates::lastRxBytes() const
+{
+    return m_count ? sampleAt(m_count - 1).rxBytes : 0;
+}
+
+qulonglong TrafficRates::lastTxBytes() const
+{
+    return m_count ? sampleAt(m_count - 1).txBytes : 0;
+}
+
+qreal TrafficRates::rxRate() const
+{
+    return rate(m_count - 1, &Sample::rxBytes);
+}
+
+qreal TrafficRates::txRate() const
+{
+    return rate(m_count - 1, &Sample::txBytes);
+}
+
+QVariantList TrafficRates::rxRateHistory() const
+{
+    return rateHistory(&Sample::rxBytes);
+}
+
+QVariantList TrafficRates::txRateHistory() const
+{
+    return rateHistory(&Sample::txBytes);
+}
+
+const TrafficRates::Sample &TrafficRates::sampleAt(int index) const
+{
+    return m_samples[(m_first + index) % m_samples.size()];
+}
+
+qreal TrafficRates::rate(int index, qulonglong Sample::*counter) const
+{
+    if (index < 1 || index >= m_count) {
+        return 0;
+    }
+
+    const Sample &previous = sampleAt(index - 1);
+    const Sample &current = sampleAt(index);
+    const qint64 elapsed = current.timestamp - previous.timestamp;
+    if (elapsed <= 0) {
+        return 0;
+    }
+
+    return (current.*counter - previous.*counter) * 1000.0 / elapsed;
+}
+
+QVariantList TrafficRates::rateHistory(qulonglong Sample::*counter) const
+{
+    QVariantList history;
+    if (m_count > 1) {
+        history.reserve(m_count - 1);
+        // Newest first, the traffic monitor plots it with ZeroAtEnd
+        for (int i = m_count - 1; i >= 1; --i) {
+            history << rate(i, counter);
+        }
+    }
+    return history;
+}
@@ -0,0 +1,79 @@
+/*
+    Copyright 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PLASMA_NM_TRAFFIC_RATES_H
+#define PLASMA_NM_TRAFFIC_RATES_H
+
+#include <QVariantList>
+
+#include <array>
+
+/**
+ * Transfer rates of a device computed from its rx/tx counters. The last samples are kept
+ * in a preallocated ring buffer together with the time they were taken at, so the rates
+ * don't depend on the samples coming in regular intervals.
+ */
+class Q_DECL_EXPORT TrafficRates
+{
+public:
+    enum {
+        // Number of rates kept in the history
+        HistorySize = 40,
+        // Counters reported within this interval (ms) belong to the same sample, NetworkManager reports rx and tx separately
+        MergeInterval = 100,
+        // The history is dropped when there was no sample for this long (ms), i.e. the statistics were turned off
+        MaximumGap = 10000
+    };
+
+    TrafficRates();
+
+    void addSample(qint64 timestamp, qulonglong rxBytes, qulonglong txBytes);
+    void clear();
+
+    bool isEmpty() const;
+    qint64 lastTimestamp() const;
+    qulonglong lastRxBytes() const;
+    qulonglong lastTxBytes() const;
+
+    // Bytes per second between the last two samples
+    qreal rxRate() const;
+    qreal txRate() const;
+
+    // Rates between all the adjacent samples, the newest first
+    QVariantList rxRateHistory() const;
+    QVariantList txRateHistory() const;
+
+private:
+    struct Sample {
+        qint64 timestamp;
+        qulonglong rxBytes;
+        qulonglong txBytes;
+    };
+
+    const Sample &sampleAt(int index) const;
+    qreal rate(int index, qulonglong Sample::*counter) const;
+    QVariantList rateHistory(qulonglong Sample::*counter) const;
+
+    std::array<Sample, HistorySize + 1> m_samples;
+    int m_first;
+    int m_count;
+};
+
+#endif // PLASMA_NM_TRAFFIC_RATES_H
@@ -0,0 +1,138 @@
+/*
+    Copyright 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "perfcounters.h"
+#include "networkmodel.h"
+
+#include <QMetaEnum>
+
+static const char * const counterNames[] = {
+    "ItemUpdates",
+    "DataChangedSignals",
+    "ProxySorts",
+    "ProxyResorts",
+    "DetailsUpdates",
+    "ScansRequested",
+    "ScansIssued",
+    "ScansThrottled",
+    "SecretsRequests"
+};
+static_assert(sizeof(counterNames) / sizeof(counterNames[0]) == PerfCounters::CounterCount, "Every counter needs a name");
+
+static const char * const histogramNames[] = {
+    "ItemUpdateLatency",
+    "SecretsRequestLatency",
+    "SecretsQueueDepth"
+};
+static_assert(sizeof(histogramNames) / sizeof(histogramNames[0]) == PerfCounters::HistogramCount, "Every histogram needs a name");
+
+PerfCounters *PerfCounters::instance()
+{
+    static PerfCounters counters;
+    return &counters;
+}
+
+PerfCounters::PerfCounters()
+{
+    reset();
+}
+
+void PerfCounters::record(Histogram histogram, quint64 value)
+{
+    HistogramData &data = m_histograms[histogram];
+    const int bucket = value ? qMin<int>(64 - qCountLeadingZeroBits(value), BucketCount - 1) : 0;
+
+    data.count.fetch_add(1, std::memory_order_relaxed);
+    data.sum.fetch_add(value, std::memory_order_relaxed);
+    data.buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+
+    quint64 max = data.max.load(std::memory_order_relaxed);
+    while (value > max && !data.max.compare_exchange_weak(max, value, std::memory_order_relaxed)) {
+    }
+}
+
+void PerfCounters::recordRoles(quint64 mask)
+{
+    for (; mask; mask &= mask - 1) {
+        m_roles[qCountTrailingZeroBits(mask)].fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+QVariantMap PerfCounters::snapshot() const
+{
+    QVariantMap counters;
+    for (int i = 0; i < CounterCount; ++i) {
+        counters.insert(QLatin1String(counterNames[i]), m_counters[i].load(std::memory_order_relaxed));
+    }
+
+    QVariantMap histograms;
+    for (int i = 0; i < HistogramCount; ++i) {
+        const HistogramData &data = m_histograms[i];
+        QVariantList buckets;
+        for (int bucket = 0; bucket < BucketCount; ++bucket) {
+            buckets << data.buckets[bucket].load(std::memory_order_relaxed);
+        }
+
+        QVariantMap histogram;
+        histogram.insert(QStringLiteral("Count"), data.count.load(std::memory_order_relaxed));
+        histogram.insert(QStringLiteral("Sum"), data.sum.load(std::memory_order_relaxed));
+        histogram.insert(QStringLiteral("Max"), data.max.load(std::memory_order_relaxed));
+        histogram.insert(QStringLiteral("Buckets"), buckets);
+        histograms.insert(QLatin1String(histogramNames[i]), histogram);
+    }
+
+    const QMetaEnum roleEnum = NetworkModel::staticMetaObject.enumerator(NetworkModel::staticMetaObject.indexOfEnumerator("ItemRole"));
+    QVariantMap roles;
+    for (int i = 0; i < RoleCount; ++i) {
+        const quint64 count = m_roles[i].load(std::memory_order_relaxed);
+        if (!count) {
+            continue;
+        }
+        const int role = NetworkModel::ConnectionDetailsRole + i;
+        const char *name = roleEnum.valueToKey(role);
+        roles.insert(name ? QString::fromLatin1(name) : QString::number(role), count);
+    }
+
+    QVariantMap result;
+    result.insert(QStringLiteral("Counters"), counters);
+    result.insert(QStringLiteral("Histograms"), histograms);
+    result.insert(QStringLiteral("DataChangedRoles"), roles);
+    return result;
+}
+
+void PerfCounters::reset()
+{
+    for (std::atomic<quint64> &counter : m_counters) {
+        counter.store(0, std::memory_order_relaxed);
+    }
+
+    for (HistogramData &data : m_histograms) {
+        data.count.store(0, std::memory_order_relaxed);
+        data.sum.store(0, std::memory_order_relaxed);
+        data.max.store(0, std::memory_order_relaxed);
+        for (std::atomic<quint64> &bucket : data.buckets) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    for (std::atomic<quint64> &role : m_roles) {
+        role.store(0, std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,105 @@
+/*
+    Copyright 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PLASMA_NM_PERF_COUNTERS_H
+#define PLASMA_NM_PERF_COUNTERS_H
+
+#include <QElapsedTimer>
+#include <QVariantMap>
+
+#include <atomic>
+
+/**
+ * Counters and histograms of the work done on the hot paths of the process, cheap enough
+ * to be always on. Every process has its own set; the applet publishes its set through
+ * Handler::performanceCounters() and the kded module through its D-Bus object.
+ */
+class Q_DECL_EXPORT PerfCounters
+{
+public:
+    enum Counter {
+        ItemUpdates,            // NetworkModel::updateItem() calls
+        DataChangedSignals,     // dataChanged() emitted by NetworkModel
+        ProxySorts,             // complete sorts of the proxy models
+        ProxyResorts,           // changed rows moved by AppletProxyModel, layout changes of MobileProxyModel
+        DetailsUpdates,         // NetworkModelItem::updateDetails() calls
+        ScansRequested,         // Handler::requestScan() calls
+        ScansIssued,            // scans requested from NetworkManager
+        ScansThrottled,         // scans postponed because of the rate limit or an unavailable device
+        SecretsRequests,        // requests of NetworkManager the secret agent finished
+        CounterCount
+    };
+
+    enum Histogram {
+        ItemUpdateLatency,      // from the first queued item update to its dataChanged(), in microseconds
+        SecretsRequestLatency,  // from the arrival of a secrets request to its completion, in microseconds
+        SecretsQueueDepth,      // requests queued by the secret agent whenever the queue is processed
+        HistogramCount
+    };
+
+    enum {
+        // Bucket i counts the values below 2^i, the last one all the bigger values
+        BucketCount = 24,
+        // Changed roles are counted by their bit in NetworkModelItem::changedRolesMask()
+        RoleCount = 64
+    };
+
+    static PerfCounters *instance();
+
+    void increment(Counter counter, quint64 value = 1)
+    {
+        m_counters[counter].fetch_add(value, std::memory_order_relaxed);
+    }
+    void record(Histogram histogram, quint64 value);
+    /**
+     * Records the time elapsed since @p timer was started in microseconds
+     */
+    void recordElapsed(Histogram histogram, const QElapsedTimer &timer)
+    {
+        record(histogram, timer.nsecsElapsed() / 1000);
+    }
+    /**
+     * Counts one dataChanged() for each role in @p mask, see NetworkModelItem::rolesFromMask()
+     */
+    void recordRoles(quint64 mask);
+
+    /**
+     * Returns Counters and DataChangedRoles as maps of names to counts and Histograms
+     * as a map of names to maps with Count, Sum, Max and Buckets
+     */
+    QVariantMap snapshot() const;
+    void reset();
+
+private:
+    PerfCounters();
+
+    struct HistogramData {
+        std::atomic<quint64> count;
+        std::atomic<quint64> sum;
+        std::atomic<quint64> max;
+        std::atomic<quint64> buckets[BucketCount];
+    };
+
+    std::atomic<quint64> m_counters[CounterCount];
+    HistogramData m_histograms[HistogramCount];
+    std::atomic<quint64> m_roles[RoleCount];
+};
+
+#endif // PLASMA_NM_PERF_COUNTERS_H
@@ -0,0 +1,432 @@
+/*
+    Copyright 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "scanscheduler.h"
+#include "debug.h"
+#include "perfcounters.h"
+
+#include <NetworkManagerQt/Manager>
+
+#include <QDBusArgument>
+#include <QDBusConnection>
+#include <QDBusConnectionInterface>
+#include <QDBusMessage>
+#include <QDBusPendingCallWatcher>
+#include <QDBusPendingReply>
+#include <QDBusServiceWatcher>
+#include <QTimer>
+
+#define SCAN_SERVICE "org.kde.plasmanetworkmanagement"
+#define SCAN_PATH "/org/kde/plasmanetworkmanagement"
+#define SCAN_IFACE "org.kde.plasmanetworkmanagement"
+
+ScanScheduler *ScanScheduler::instance()
+{
+    static ScanScheduler scheduler;
+    return &scheduler;
+}
+
+ScanScheduler::ScanScheduler(QObject *parent)
+    : QObject(parent)
+{
+    for (const NetworkManager::Device::Ptr &device : NetworkManager::networkInterfaces()) {
+        if (device->type() == NetworkManager::Device::Wifi) {
+            addDevice(device.objectCast<NetworkManager::WirelessDevice>());
+        }
+    }
+
+    connect(NetworkManager::notifier(), &NetworkManager::Notifier::deviceAdded, this, &ScanScheduler::deviceAdded);
+    connect(NetworkManager::notifier(), &NetworkManager::Notifier::deviceRemoved, this, &ScanScheduler::deviceRemoved);
+
+    m_serviceWatcher = new QDBusServiceWatcher(QStringLiteral(SCAN_SERVICE), QDBusConnection::sessionBus(),
+                                               QDBusServiceWatcher::WatchForRegistration | QDBusServiceWatcher::WatchForUnregistration, this);
+    connect(m_serviceWatcher, &QDBusServiceWatcher::serviceRegistered, this, &ScanScheduler::serviceRegistered);
+    connect(m_serviceWatcher, &QDBusServiceWatcher::serviceUnregistered, this, &ScanScheduler::serviceUnregistered);
+
+    QDBusPendingReply<bool> reply = QDBusConnection::sessionBus().interface()->asyncCall(QStringLiteral("NameHasOwner"), QStringLiteral(SCAN_SERVICE));
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(reply, this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [this] (QDBusPendingCallWatcher *watcher) {
+        QDBusPendingReply<bool> reply = *watcher;
+        watcher->deleteLater();
+        if (!reply.isError() && reply.value()) {
+            serviceRegistered();
+        }
+    });
+}
+
+ScanScheduler::~ScanScheduler()
+{
+    qDeleteAll(m_interfaces);
+}
+
+void ScanScheduler::setInterested(QObject *consumer, bool interested)
+{
+    if (!consumer || interested == m_consumers.contains(consumer)) {
+        return;
+    }
+
+    if (interested) {
+        m_consumers.insert(consumer);
+        connect(consumer, &QObject::destroyed, this, &ScanScheduler::consumerDestroyed);
+    } else {
+        m_consumers.remove(consumer);
+        disconnect(consumer, &QObject::destroyed, this, &ScanScheduler::consumerDestroyed);
+    }
+
+    // Only the first and the last consumer change anything
+    if (m_consumers.count() <= 1) {
+        if (m_remote) {
+            callService(QStringLiteral("setScanInterest"), {!m_consumers.isEmpty()});
+        }
+        for (Interface *interface : qAsConst(m_interfaces)) {
+            reschedule(interface);
+        }
+    }
+}
+
+void ScanScheduler::setAuthoritative()
+{
+    serviceUnregistered();
+    m_authoritative = true;
+}
+
+bool ScanScheduler::isInterested(QObject *consumer) const
+{
+    return m_consumers.contains(consumer);
+}
+
+void ScanScheduler::scanNow(const QString &interface)
+{
+    if (m_remote) {
+        callService(QStringLiteral("requestScan"), {interface});
+        return;
+    }
+
+    for (Interface *iface : qAsConst(m_interfaces)) {
+        if (!interface.isEmpty() && interface != iface->device->interfaceName()) {
+            continue;
+        }
+
+        iface->interval = MinimumInterval;
+        scan(iface);
+    }
+}
+
+QVariantList ScanScheduler::schedule() const
+{
+    if (m_remote) {
+        return m_remoteSchedule;
+    }
+
+    QVariantList result;
+    for (auto it = m_interfaces.constBegin(); it != m_interfaces.constEnd(); ++it) {
+        QVariantMap decision;
+        decision.insert(QStringLiteral("Interface"), it.key());
+        decision.insert(QStringLiteral("Interval"), it.value()->interval);
+        decision.insert(QStringLiteral("NextScan"), it.value()->nextScan);
+        decision.insert(QStringLiteral("Reason"), it.value()->reason);
+        result << decision;
+    }
+    return result;
+}
+
+void ScanScheduler::consumerDestroyed(QObject *consumer)
+{
+    m_consumers.remove(consumer);
+    if (m_consumers.isEmpty()) {
+        if (m_remote) {
+            callService(QStringLiteral("setScanInterest"), {false});
+        }
+        for (Interface *interface : qAsConst(m_interfaces)) {
+            reschedule(interface);
+        }
+    }
+}
+
+void ScanScheduler::deviceAdded(const QString &device)
+{
+    NetworkManager::Device::Ptr dev = NetworkManager::findNetworkInterface(device);
+    if (dev && dev->type() == NetworkManager::Device::Wifi) {
+        addDevice(dev.objectCast<NetworkManager::WirelessDevice>());
+        Q_EMIT scheduleChanged();
+    }
+}
+
+void ScanScheduler::deviceRemoved(const QString &device)
+{
+    for (auto it = m_interfaces.begin(); it != m_interfaces.end(); ++it) {
+        if (it.value()->device->uni() == device) {
+            // The lambdas capture the interface, the device may outlive it when someone else holds it
+            disconnect(it.value()->device.data(), nullptr, this, nullptr);
+            delete it.value()->timer;
+            delete it.value();
+            m_interfaces.erase(it);
+            Q_EMIT scheduleChanged();
+            return;
+        }
+    }
+}
+
+void ScanScheduler::lastScanChanged()
+{
+    NetworkManager::WirelessDevice *device = qobject_cast<NetworkManager::WirelessDevice*>(sender());
+    Interface *interface = device ? m_interfaces.value(device->interfaceName()) : nullptr;
+    if (!interface) {
+        return;
+    }
+
+    // Back off while the scans don't find anything new
+    const uint hash = networksHash(interface->device);
+    if (hash == interface->networksHash) {
+        interface->interval = qMin(interface->interval * 2, static_cast<int>(MaximumInterval));
+    } else {
+        interface->interval = MinimumInterval;
+        interface->networksHash = hash;
+    }
+
+    reschedule(interface);
+}
+
+void ScanScheduler::scanReplyFinished(QDBusPendingCallWatcher *watcher)
+{
+    QDBusPendingReply<> reply = *watcher;
+    const QString interfaceName = watcher->property("interface").toString();
+    watcher->deleteLater();
+
+    Interface *interface = m_interfaces.value(interfaceName);
+    if (!interface) {
+        return;
+    }
+
+    if (reply.isError()) {
+        qCWarning(PLASMA_NM) << "Wireless scan on" << interfaceName << "failed:" << reply.error().message();
+        setDecision(interface, RetryInterval, QStringLiteral("Retrying a failed scan"));
+    } else {
+        qCDebug(PLASMA_NM) << "Wireless scan on" << interfaceName << "succeeded";
+    }
+}
+
+void ScanScheduler::serviceRegistered()
+{
+    if (m_authoritative || m_remote) {
+        return;
+    }
+
+    qCDebug(PLASMA_NM) << "Wireless scans are scheduled by" << SCAN_SERVICE;
+    m_remote = true;
+    QDBusConnection::sessionBus().connect(QStringLiteral(SCAN_SERVICE), QStringLiteral(SCAN_PATH), QStringLiteral(SCAN_IFACE),
+                                          QStringLiteral("scanScheduleChanged"), this, SLOT(serviceScheduleChanged()));
+    if (!m_consumers.isEmpty()) {
+        callService(QStringLiteral("setScanInterest"), {true});
+    }
+
+    for (Interface *interface : qAsConst(m_interfaces)) {
+        reschedule(interface);
+    }
+    serviceScheduleChanged();
+}
+
+void ScanScheduler::serviceUnregistered()
+{
+    if (!m_remote) {
+        return;
+    }
+
+    qCDebug(PLASMA_NM) << "Wireless scans are scheduled locally";
+    m_remote = false;
+    m_remoteSchedule.clear();
+    QDBusConnection::sessionBus().disconnect(QStringLiteral(SCAN_SERVICE), QStringLiteral(SCAN_PATH), QStringLiteral(SCAN_IFACE),
+                                             QStringLiteral("scanScheduleChanged"), this, SLOT(serviceScheduleChanged()));
+
+    for (Interface *interface : qAsConst(m_interfaces)) {
+        reschedule(interface);
+    }
+    Q_EMIT scheduleChanged();
+}
+
+void ScanScheduler::serviceCallFinished(QDBusPendingCallWatcher *watcher)
+{
+    QDBusPendingReply<> reply = *watcher;
+    watcher->deleteLater();
+
+    // E.g. an older kded module without the scanning service, fall back to the local schedule
+    if (reply.isError()) {
+        qCWarning(PLASMA_NM) << "Failed to use the scanning service:" << reply.error().message();
+        serviceUnregistered();
+    }
+}
+
+void ScanScheduler::serviceScheduleChanged()
+{
+    QDBusMessage message = QDBusMessage::createMethodCall(QStringLiteral(SCAN_SERVICE), QStringLiteral(SCAN_PATH),
+                                                          QStringLiteral(SCAN_IFACE), QStringLiteral("scanSchedule"));
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(QDBusConnection::sessionBus().asyncCall(message), this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, &ScanScheduler::serviceScheduleFinished);
+}
+
+void ScanScheduler::serviceScheduleFinished(QDBusPendingCallWatcher *watcher)
+{
+    QDBusPendingReply<QVariantList> reply = *watcher;
+    watcher->deleteLater();
+
+    if (!m_remote || reply.isError()) {
+        return;
+    }
+
+    // Decisions arrive as a{sv} structures with NextScan in milliseconds since epoch, -1 when no scan is planned
+    m_remoteSchedule.clear();
+    for (const QVariant &entry : reply.value()) {
+        QVariantMap decision = qdbus_cast<QVariantMap>(entry.value<QDBusArgument>());
+        const qlonglong nextScan = decision.value(QStringLiteral("NextScan")).toLongLong();
+        decision.insert(QStringLiteral("NextScan"), nextScan < 0 ? QDateTime() : QDateTime::fromMSecsSinceEpoch(nextScan));
+        m_remoteSchedule << decision;
+    }
+    Q_EMIT scheduleChanged();
+}
+
+void ScanScheduler::addDevice(const NetworkManager::WirelessDevice::Ptr &device)
+{
+    if (!device || m_interfaces.contains(device->interfaceName())) {
+        return;
+    }
+
+    Interface *interface = new Interface;
+    interface->device = device;
+    interface->timer = new QTimer(this);
+    interface->timer->setSingleShot(true);
+    interface->networksHash = networksHash(device);
+    m_interfaces.insert(device->interfaceName(), interface);
+
+    connect(interface->timer, &QTimer::timeout, this, [this, interface] () {
+        scan(interface);
+    });
+    connect(device.data(), &NetworkManager::WirelessDevice::lastScanChanged, this, &ScanScheduler::lastScanChanged);
+    // Periodic scans are skipped while connected, but not while connecting or disconnected
+    connect(device.data(), &NetworkManager::Device::stateChanged, this, [this, interface] () {
+        reschedule(interface);
+    });
+
+    reschedule(interface);
+}
+
+void ScanScheduler::reschedule(Interface *interface)
+{
+    if (m_remote) {
+        setDecision(interface, -1, QStringLiteral("Scheduled by the scanning service"));
+    } else if (m_consumers.isEmpty()) {
+        setDecision(interface, -1, QStringLiteral("No consumer is interested"));
+    } else if (interface->device->state() == NetworkManager::Device::Unavailable) {
+        setDecision(interface, -1, QStringLiteral("Device is unavailable"));
+    } else if (interface->device->state() == NetworkManager::Device::Activated && interface->interval >= MaximumInterval) {
+        setDecision(interface, -1, QStringLiteral("Connected and the results don't change"));
+    } else if (interface->interval > MinimumInterval) {
+        setDecision(interface, interface->interval, QStringLiteral("Backing off, the results don't change"));
+    } else {
+        setDecision(interface, interface->interval, QStringLiteral("Periodic scan"));
+    }
+}
+
+void ScanScheduler::scan(Interface *interface)
+{
+    if (interface->device->state() == NetworkManager::Device::Unavailable) {
+        PerfCounters::instance()->increment(PerfCounters::ScansThrottled);
+        reschedule(interface);
+        return;
+    }
+
+    const int timeout = rateLimitTimeout(interface->device);
+    if (timeout > 0) {
+        PerfCounters::instance()->increment(PerfCounters::ScansThrottled);
+        // +1 ms is added to avoid having the scan being rejected by NetworkManager
+        // because it is run at the exact last millisecond of the rate limit
+        setDecision(interface, timeout + 1, QStringLiteral("Rate limited by NetworkManager"));
+        return;
+    }
+
+    qCDebug(PLASMA_NM) << "Requesting wifi scan on device" << interface->device->interfaceName();
+    PerfCounters::instance()->increment(PerfCounters::ScansIssued);
+    QDBusPendingReply<> reply = interface->device->requestScan();
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(reply, this);
+    watcher->setProperty("interface", interface->device->interfaceName());
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, &ScanScheduler::scanReplyFinished);
+
+    // The next scan is planned once this one finishes, this covers NetworkManager not reporting it
+    reschedule(interface);
+}
+
+void ScanScheduler::setDecision(Interface *interface, int timeout, const QString &reason)
+{
+    const bool wasPlanned = interface->nextScan.isValid();
+
+    if (timeout < 0) {
+        interface->timer->stop();
+        interface->nextScan = QDateTime();
+    } else {
+        interface->timer->start(timeout);
+        interface->nextScan = QDateTime::currentDateTime().addMSecs(timeout);
+    }
+
+    if (interface->reason != reason) {
+        qCDebug(PLASMA_NM) << "Scans on" << interface->device->interfaceName() << ":" << reason << "- next in" << timeout << "ms";
+        interface->reason = reason;
+    } else if (interface->announcedInterval == interface->interval && wasPlanned == (timeout >= 0)) {
+        // Only the time of the next scan moved, clients can follow it from the interval
+        return;
+    }
+
+    interface->announcedInterval = interface->interval;
+    Q_EMIT scheduleChanged();
+}
+
+int ScanScheduler::rateLimitTimeout(const NetworkManager::WirelessDevice::Ptr &device) const
+{
+    const QDateTime now = QDateTime::currentDateTime();
+    // For NM < 1.12, lastScan is not available
+    const QDateTime lastScan = device->lastScan();
+    const QDateTime lastRequestScan = device->lastRequestScan();
+
+    qint64 timeout = 0;
+    if (lastScan.isValid()) {
+        timeout = qMax(timeout, MinimumInterval - lastScan.msecsTo(now));
+    }
+    if (lastRequestScan.isValid()) {
+        timeout = qMax(timeout, MinimumInterval - lastRequestScan.msecsTo(now));
+    }
+    return static_cast<int>(qMin<qint64>(timeout, MinimumInterval));
+}
+
+uint ScanScheduler::networksHash(const NetworkManager::WirelessDevice::Ptr &device) const
+{
+    // Networks and their rough signal strength, small fluctuations are not a change worth scanning for
+    uint hash = 0;
+    for (const NetworkManager::WirelessNetwork::Ptr &network : device->networks()) {
+        hash ^= qHash(network->ssid(), network->signalStrength() / 20);
+    }
+    return hash;
+}
+
+void ScanScheduler::callService(const QString &method, const QVariantList &arguments)
+{
+    QDBusMessage message = QDBusMessage::createMethodCall(QStringLiteral(SCAN_SERVICE), QStringLiteral(SCAN_PATH),
+                                                          QStringLiteral(SCAN_IFACE), method);
+    message.setArguments(arguments);
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(QDBusConnection::sessionBus().asyncCall(message), this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, &ScanScheduler::serviceCallFinished);
+}
@@ -0,0 +1,135 @@
+/*
+    Copyright 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PLASMA_NM_SCAN_SCHEDULER_H
+#define PLASMA_NM_SCAN_SCHEDULER_H
+
+#include <QDateTime>
+#include <QHash>
+#include <QObject>
+#include <QSet>
+#include <QVariantList>
+
+#include <NetworkManagerQt/WirelessDevice>
+
+class QDBusPendingCallWatcher;
+class QDBusServiceWatcher;
+class QTimer;
+
+/**
+ * Schedules wireless scans for all the consumers in the process. Scans run periodically while
+ * at least one consumer is interested; the interval is doubled every time a scan brings no
+ * change and periodic scans stop entirely while the device is connected and the results are
+ * stable. A scan requested explicitly, e.g. when the list of networks is shown, runs as soon
+ * as NetworkManager allows it.
+ *
+ * While the kded module provides the scanning service on the session bus, the schedule is
+ * kept there for all the processes and this one only forwards the interest and the requests.
+ */
+class Q_DECL_EXPORT ScanScheduler : public QObject
+{
+Q_OBJECT
+public:
+    enum {
+        // NetworkManager refuses scans requested more often
+        MinimumInterval = 10000,
+        MaximumInterval = 160000,
+        RetryInterval = 2000
+    };
+
+    static ScanScheduler *instance();
+
+    /**
+     * Makes this scheduler the one serving the other processes, it never forwards anything then
+     */
+    void setAuthoritative();
+
+    /**
+     * Periodic scanning runs while at least one consumer is interested, consumers are
+     * removed automatically when destroyed
+     */
+    void setInterested(QObject *consumer, bool interested);
+    bool isInterested(QObject *consumer) const;
+
+    /**
+     * Scans the given interface, or all of them, as soon as possible and restarts the backoff
+     */
+    void scanNow(const QString &interface = QString());
+
+    /**
+     * Current decision for every wireless interface, with Interface, Interval (ms),
+     * NextScan (date time, invalid when no scan is planned) and Reason, taken from
+     * the scanning service when it's used
+     */
+    QVariantList schedule() const;
+
+Q_SIGNALS:
+    /**
+     * Emitted when a scan gets planned or cancelled or the reason or interval of a decision changes,
+     * but not when only NextScan moves because a periodic scan was rescheduled
+     */
+    void scheduleChanged();
+
+private Q_SLOTS:
+    void consumerDestroyed(QObject *consumer);
+    void deviceAdded(const QString &device);
+    void deviceRemoved(const QString &device);
+    void lastScanChanged();
+    void scanReplyFinished(QDBusPendingCallWatcher *watcher);
+    void serviceRegistered();
+    void serviceUnregistered();
+    void serviceCallFinished(QDBusPendingCallWatcher *watcher);
+    void serviceScheduleChanged();
+    void serviceScheduleFinished(QDBusPendingCallWatcher *watcher);
+
+private:
+    struct Interface {
+        NetworkManager::WirelessDevice::Ptr device;
+        QTimer *timer = nullptr;
+        int interval = MinimumInterval;
+        uint networksHash = 0;
+        QDateTime nextScan;
+        QString reason;
+        // Interval the last scheduleChanged() was emitted for
+        int announcedInterval = 0;
+    };
+
+    explicit ScanScheduler(QObject *parent = nullptr);
+    ~ScanScheduler() override;
+
+    void addDevice(const NetworkManager::WirelessDevice::Ptr &device);
+    void reschedule(Interface *interface);
+    void scan(Interface *interface);
+    void setDecision(Interface *interface, int timeout, const QString &reason);
+    int rateLimitTimeout(const NetworkManager::WirelessDevice::Ptr &device) const;
+    uint networksHash(const NetworkManager::WirelessDevice::Ptr &device) const;
+    void callService(const QString &method, const QVariantList &arguments = QVariantList());
+
+    bool m_authoritative = false;
+    // Whether the schedule is kept by the scanning service
+    bool m_remote = false;
+    QVariantList m_remoteSchedule;
+    QDBusServiceWatcher *m_serviceWatcher;
+    QSet<QObject*> m_consumers;
+    // Wireless interfaces by their name
+    QHash<QString, Interface*> m_interfaces;
+};
+
+#endif // PLASMA_NM_SCAN_SCHEDULER_H
@@ -0,0 +1,98 @@
+/*
+    Copyright 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "tracespans.h"
+
+#include <QCoreApplication>
+#include <QDBusConnection>
+#include <QThread>
+
+#include <chrono>
+
+TraceSpans *TraceSpans::instance()
+{
+    static TraceSpans spans;
+    return &spans;
+}
+
+TraceSpans::TraceSpans()
+    : QObject()
+    , m_enabled(qEnvironmentVariableIsSet("PLASMA_NM_TRACE_SPANS"))
+    , m_next(0)
+{
+    QDBusConnection::sessionBus().registerObject(QStringLiteral("/org/kde/plasmanetworkmanagement/TraceSpans"), this, QDBusConnection::ExportScriptableSlots);
+}
+
+qint64 TraceSpans::now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void TraceSpans::add(const char *name, qint64 start, qint64 end)
+{
+    const Span span = { name, start, end, quintptr(QThread::currentThreadId()) };
+
+    QMutexLocker locker(&m_mutex);
+    if (m_spans.count() < Capacity) {
+        m_spans << span;
+    } else {
+        m_spans[m_next] = span;
+        m_next = (m_next + 1) % Capacity;
+    }
+}
+
+void TraceSpans::setEnabled(bool enabled)
+{
+    m_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+QString TraceSpans::dump() const
+{
+    QMutexLocker locker(&m_mutex);
+
+    const QString pid = QString::number(QCoreApplication::applicationPid());
+    QString json;
+    json.reserve(m_spans.count() * 120);
+    json += QLatin1String("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+
+    // Oldest first
+    for (int i = 0; i < m_spans.count(); ++i) {
+        const Span &span = m_spans.at((m_next + i) % m_spans.count());
+        if (i) {
+            json += QLatin1Char(',');
+        }
+        // Names are function names, nothing to escape
+        json += QLatin1String("{\"name\":\"") + QLatin1String(span.name)
+              + QLatin1String("\",\"cat\":\"plasma-nm\",\"ph\":\"X\",\"ts\":") + QString::number(span.start / 1000.0, 'f', 3)
+              + QLatin1String(",\"dur\":") + QString::number((span.end - span.start) / 1000.0, 'f', 3)
+              + QLatin1String(",\"pid\":") + pid
+              + QLatin1String(",\"tid\":") + QString::number(span.thread) + QLatin1Char('}');
+    }
+
+    json += QLatin1String("]}");
+    return json;
+}
+
+void TraceSpans::clear()
+{
+    QMutexLocker locker(&m_mutex);
+    m_spans.clear();
+    m_next = 0;
+}
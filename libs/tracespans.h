@@ -0,0 +1,121 @@
+/*
+    Copyright 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PLASMA_NM_TRACE_SPANS_H
+#define PLASMA_NM_TRACE_SPANS_H
+
+#include <QMutex>
+#include <QObject>
+#include <QVector>
+
+#include <atomic>
+
+/**
+ * Ring buffer of the most recent timed spans of the process, dumped in the Chrome trace event
+ * format which chrome://tracing and Perfetto open. Recording is off unless PLASMA_NM_TRACE_SPANS
+ * is set in the environment or it's enabled through the session bus, where every process
+ * using plasma-nm exports this object as /org/kde/plasmanetworkmanagement/TraceSpans, e.g.
+ *
+ *   qdbus org.kde.plasmashell /org/kde/plasmanetworkmanagement/TraceSpans setEnabled true
+ *   qdbus org.kde.plasmashell /org/kde/plasmanetworkmanagement/TraceSpans dump > plasmashell.json
+ *
+ * Timestamps come from the monotonic clock, so dumps of several processes can be merged.
+ * It's built into plasmanm_editor, the library every other part links to, to have one
+ * buffer per process.
+ */
+class Q_DECL_EXPORT TraceSpans : public QObject
+{
+Q_OBJECT
+Q_CLASSINFO("D-Bus Interface", "org.kde.plasmanetworkmanagement.TraceSpans")
+public:
+    enum {
+        // Spans kept, the oldest ones are overwritten
+        Capacity = 8192
+    };
+
+    static TraceSpans *instance();
+
+    bool isEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+    /**
+     * Nanoseconds of the monotonic clock
+     */
+    static qint64 now();
+    /**
+     * Adds a span, @p name has to stay valid for the lifetime of the process, e.g. a string literal
+     */
+    void add(const char *name, qint64 start, qint64 end);
+
+public Q_SLOTS:
+    Q_SCRIPTABLE void setEnabled(bool enabled);
+    /**
+     * Returns the buffered spans as Chrome trace event JSON
+     */
+    Q_SCRIPTABLE QString dump() const;
+    Q_SCRIPTABLE void clear();
+
+private:
+    TraceSpans();
+
+    struct Span {
+        const char *name;
+        qint64 start;
+        qint64 end;
+        quintptr thread;
+    };
+
+    std::atomic<bool> m_enabled;
+    mutable QMutex m_mutex;
+    QVector<Span> m_spans;
+    // Position of the next span in m_spans once it's full
+    int m_next;
+};
+
+/**
+ * Records the time from its construction to its destruction as a span, see TRACE_SPAN()
+ */
+class TraceSpan
+{
+public:
+    explicit TraceSpan(const char *name)
+        : m_name(TraceSpans::instance()->isEnabled() ? name : nullptr)
+        , m_start(m_name ? TraceSpans::now() : 0)
+    {
+    }
+
+    ~TraceSpan()
+    {
+        if (m_name) {
+            TraceSpans::instance()->add(m_name, m_start, TraceSpans::now());
+        }
+    }
+
+private:
+    Q_DISABLE_COPY(TraceSpan)
+
+    const char *m_name;
+    qint64 m_start;
+};
+
+/**
+ * Records the rest of the enclosing scope as a span named @p name
+ */
+#define TRACE_SPAN(name) TraceSpan traceSpan(name)
+
+#endif // PLASMA_NM_TRACE_SPANS_H
@@ -29,6 +29,7 @@ ScrollViewKCM {
 
     PlasmaNM.Handler {
         id: handler
+        periodicScanning: main.visible
     }
 
     PlasmaNM.EnabledConnections {
@@ -51,15 +52,6 @@ ScrollViewKCM {
 
     Component.onCompleted: handler.requestScan()
 
-    Timer {
-        id: scanTimer
-        interval: 10200
-        repeat: true
-        running: parent.visible
-
-        onTriggered: handler.requestScan()
-    }
-
     header: Kirigami.InlineMessage {
         id: inlineError
         showCloseButton: true
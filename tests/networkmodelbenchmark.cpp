@@ -0,0 +1,473 @@
+/*
+    Copyright 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "appletproxymodel.h"
+#include "mobileproxymodel.h"
+#include "networkmodel.h"
+#include "tracebackend.h"
+
+#include <QBuffer>
+#include <QRandomGenerator>
+#include <QTest>
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#if __GLIBC_PREREQ(2, 33)
+#define HAVE_MALLINFO2 1
+#endif
+#endif
+
+// Changes replayed between two flushes, NetworkManager usually reports them in bursts
+#define EVENTS_PER_FLUSH 100
+// Flushes after which the scripted events repeat
+#define FLUSHES_PER_TRACE 10
+
+/**
+ * Trace of a simulated system which NetworkModel follows through TraceBackend: saved connections,
+ * wireless devices and the networks they see, followed by a scripted sequence of events
+ */
+class SimulatedTrace
+{
+public:
+    /**
+     * Adds @p connections saved connections and @p networks networks seen by each of
+     * the @p devices wireless devices, every fourth network has a saved connection
+     */
+    SimulatedTrace(int connections, int devices, int networks)
+        : m_random(1)
+        , m_devices(devices)
+        , m_networks(networks)
+        , m_nextAccessPoint(0)
+    {
+        TraceEvent event;
+        event.type = TraceEvent::Status;
+        event.status = NetworkManager::Connected;
+        m_snapshot << event;
+
+        event.type = TraceEvent::ConnectionAdded;
+        for (int i = 0; i < connections; ++i) {
+            event.connection = ConnectionSummary();
+            event.connection.path = QStringLiteral("/org/freedesktop/NetworkManager/Settings/%1").arg(i);
+            event.connection.id = QStringLiteral("Connection %1").arg(i);
+            event.connection.uuid = QStringLiteral("00000000-0000-0000-0000-%1").arg(i, 12, 10, QLatin1Char('0'));
+            event.connection.timestamp = QDateTime::fromSecsSinceEpoch(1500000000 + i * 3600);
+            event.connection.type = i % 3 ? NetworkManager::ConnectionSettings::Wireless : NetworkManager::ConnectionSettings::Wired;
+            if (event.connection.type == NetworkManager::ConnectionSettings::Wireless) {
+                event.connection.ssid = event.connection.id;
+                event.connection.securityType = NetworkManager::Wpa2Psk;
+            }
+            m_snapshot << event;
+        }
+
+        QStringList availableConnections;
+        for (int i = 0; i < networks; i += 4) {
+            event.connection = ConnectionSummary();
+            event.connection.path = networkConnectionPath(i);
+            event.connection.id = ssid(i);
+            event.connection.uuid = QStringLiteral("11111111-0000-0000-0000-%1").arg(i, 12, 10, QLatin1Char('0'));
+            event.connection.type = NetworkManager::ConnectionSettings::Wireless;
+            event.connection.ssid = ssid(i);
+            event.connection.securityType = securityType(i);
+            m_snapshot << event;
+            availableConnections << event.connection.path;
+        }
+
+        event.type = TraceEvent::DeviceAdded;
+        for (int device = 0; device < devices; ++device) {
+            event.device = BackendDevice();
+            event.device.path = devicePath(device);
+            event.device.interfaceName = QStringLiteral("wlan%1").arg(device);
+            event.device.type = NetworkManager::Device::Wifi;
+            event.device.state = NetworkManager::Device::Disconnected;
+            event.device.managed = true;
+            event.device.availableConnections = availableConnections;
+            m_snapshot << event;
+        }
+
+        event.type = TraceEvent::WirelessNetworkAppeared;
+        m_accessPoints.fill(0, devices * networks);
+        m_signals.fill(0, devices * networks);
+        for (int device = 0; device < devices; ++device) {
+            for (int i = 0; i < networks; ++i) {
+                m_accessPoints[device * networks + i] = m_nextAccessPoint++;
+                m_signals[device * networks + i] = m_random.bounded(101);
+                event.network = network(device, i);
+                m_snapshot << event;
+            }
+        }
+    }
+
+    /**
+     * Appends @p count signal strength changes of random networks, like a scan would report them
+     */
+    void addSignalChurn(int count)
+    {
+        TraceEvent event;
+        event.type = TraceEvent::WirelessNetworkSignalChanged;
+        for (int i = 0; i < count && m_networks; ++i) {
+            const int device = m_random.bounded(m_devices);
+            const int index = m_random.bounded(m_networks);
+            m_signals[device * m_networks + index] = m_random.bounded(101);
+            event.time = m_events.count();
+            event.network = network(device, index);
+            m_events << event;
+        }
+    }
+
+    /**
+     * Appends @p count random networks which disappear and reappear with another access point,
+     * networks with a saved connection stay so that the rows are the same after each pair of events
+     */
+    void addNetworkChurn(int count)
+    {
+        TraceEvent event;
+        for (int i = 0; i < count && m_networks > 1; ++i) {
+            const int device = m_random.bounded(m_devices);
+            int index;
+            do {
+                index = m_random.bounded(m_networks);
+            } while (index % 4 == 0);
+            event.time = m_events.count();
+            event.type = TraceEvent::WirelessNetworkDisappeared;
+            event.network = network(device, index);
+            m_events << event;
+
+            m_accessPoints[device * m_networks + index] = m_nextAccessPoint++;
+            event.type = TraceEvent::WirelessNetworkAppeared;
+            event.network = network(device, index);
+            m_events << event;
+        }
+    }
+
+    bool load(TraceBackend *backend) const
+    {
+        QBuffer buffer;
+        buffer.open(QIODevice::WriteOnly);
+        QDataStream stream(&buffer);
+        TraceBackend::writeHeader(stream);
+        for (const TraceEvent &event : m_snapshot) {
+            stream << event;
+        }
+        TraceEvent end;
+        end.type = TraceEvent::SnapshotEnd;
+        stream << end;
+        for (const TraceEvent &event : m_events) {
+            stream << event;
+        }
+        buffer.close();
+
+        buffer.open(QIODevice::ReadOnly);
+        return backend->load(&buffer);
+    }
+
+private:
+    static QString devicePath(int device)
+    {
+        return QStringLiteral("/org/freedesktop/NetworkManager/Devices/%1").arg(device);
+    }
+
+    static QString networkConnectionPath(int index)
+    {
+        return QStringLiteral("/org/freedesktop/NetworkManager/Settings/ap%1").arg(index);
+    }
+
+    static QString ssid(int index)
+    {
+        return QStringLiteral("Network %1").arg(index);
+    }
+
+    static NetworkManager::WirelessSecurityType securityType(int index)
+    {
+        return index % 2 ? NetworkManager::Wpa2Psk : NetworkManager::NoneSecurity;
+    }
+
+    BackendWirelessNetwork network(int device, int index) const
+    {
+        const int accessPoint = m_accessPoints.at(device * m_networks + index);
+        BackendAccessPoint ap;
+        ap.path = QStringLiteral("/org/freedesktop/NetworkManager/AccessPoint/%1").arg(accessPoint);
+        ap.hardwareAddress = QStringLiteral("00:11:22:%1:%2:%3").arg(accessPoint >> 16 & 0xff, 2, 16, QLatin1Char('0'))
+                                                                .arg(accessPoint >> 8 & 0xff, 2, 16, QLatin1Char('0'))
+                                                                .arg(accessPoint & 0xff, 2, 16, QLatin1Char('0'));
+        ap.signal = m_signals.at(device * m_networks + index);
+
+        BackendWirelessNetwork network;
+        network.devicePath = devicePath(device);
+        network.ssid = ssid(index);
+        network.signal = ap.signal;
+        network.referenceAccessPoint = ap;
+        network.accessPoints << ap;
+        network.securityType = securityType(index);
+        return network;
+    }
+
+    QRandomGenerator m_random;
+    int m_devices;
+    int m_networks;
+    int m_nextAccessPoint;
+    // Current access point and signal strength per device and network
+    QVector<int> m_accessPoints;
+    QVector<int> m_signals;
+    QVector<TraceEvent> m_snapshot;
+    QVector<TraceEvent> m_events;
+};
+
+// Returns once all the saved connections are in the model, they are added in batches from the event loop
+static void waitForLoading(const NetworkModel &model)
+{
+    while (model.loading()) {
+        QCoreApplication::processEvents();
+    }
+}
+
+// Replays @p count events, starting over once the trace ends, and lets the model publish them
+static void replay(TraceBackend *backend, int count)
+{
+    for (int i = 0; i < count; ++i) {
+        if (backend->atEnd()) {
+            backend->rewind();
+        }
+        backend->step();
+    }
+    QCoreApplication::processEvents();
+}
+
+class NetworkModelBenchmark : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initialization_data();
+    void initialization();
+    void signalChurn_data();
+    void signalChurn();
+    void networkChurn_data();
+    void networkChurn();
+    void appletSort_data();
+    void appletSort();
+    void appletFilter_data();
+    void appletFilter();
+    void mobileSort_data();
+    void mobileSort();
+    void memoryPerItem_data();
+    void memoryPerItem();
+
+private:
+    void setupData();
+};
+
+void NetworkModelBenchmark::setupData()
+{
+    QTest::addColumn<int>("connections");
+    QTest::addColumn<int>("devices");
+    QTest::addColumn<int>("networks");
+
+    QTest::newRow("laptop") << 20 << 1 << 30;
+    QTest::newRow("office") << 100 << 2 << 150;
+    QTest::newRow("stress") << 1000 << 4 << 500;
+}
+
+void NetworkModelBenchmark::initialization_data()
+{
+    setupData();
+}
+
+void NetworkModelBenchmark::initialization()
+{
+    QFETCH(int, connections);
+    QFETCH(int, devices);
+    QFETCH(int, networks);
+
+    TraceBackend backend;
+    QVERIFY(SimulatedTrace(connections, devices, networks).load(&backend));
+
+    QBENCHMARK {
+        NetworkModel model(&backend);
+        waitForLoading(model);
+        AppletProxyModel proxy;
+        proxy.setSourceModel(&model);
+    }
+}
+
+void NetworkModelBenchmark::signalChurn_data()
+{
+    setupData();
+}
+
+void NetworkModelBenchmark::signalChurn()
+{
+    QFETCH(int, connections);
+    QFETCH(int, devices);
+    QFETCH(int, networks);
+
+    SimulatedTrace trace(connections, devices, networks);
+    trace.addSignalChurn(EVENTS_PER_FLUSH * FLUSHES_PER_TRACE);
+    TraceBackend backend;
+    QVERIFY(trace.load(&backend));
+    NetworkModel model(&backend);
+    waitForLoading(model);
+    AppletProxyModel proxy;
+    proxy.setSourceModel(&model);
+
+    // One iteration is EVENTS_PER_FLUSH events
+    QBENCHMARK {
+        replay(&backend, EVENTS_PER_FLUSH);
+    }
+}
+
+void NetworkModelBenchmark::networkChurn_data()
+{
+    setupData();
+}
+
+void NetworkModelBenchmark::networkChurn()
+{
+    QFETCH(int, connections);
+    QFETCH(int, devices);
+    QFETCH(int, networks);
+
+    SimulatedTrace trace(connections, devices, networks);
+    trace.addNetworkChurn(EVENTS_PER_FLUSH * FLUSHES_PER_TRACE);
+    TraceBackend backend;
+    QVERIFY(trace.load(&backend));
+    NetworkModel model(&backend);
+    waitForLoading(model);
+    AppletProxyModel proxy;
+    proxy.setSourceModel(&model);
+    const int rows = model.rowCount(QModelIndex());
+
+    // One iteration is EVENTS_PER_FLUSH networks disappearing and appearing again
+    QBENCHMARK {
+        replay(&backend, 2 * EVENTS_PER_FLUSH);
+    }
+
+    QTRY_COMPARE(model.rowCount(QModelIndex()), rows);
+}
+
+void NetworkModelBenchmark::appletSort_data()
+{
+    setupData();
+}
+
+void NetworkModelBenchmark::appletSort()
+{
+    QFETCH(int, connections);
+    QFETCH(int, devices);
+    QFETCH(int, networks);
+
+    TraceBackend backend;
+    QVERIFY(SimulatedTrace(connections, devices, networks).load(&backend));
+    NetworkModel model(&backend);
+    waitForLoading(model);
+
+    QBENCHMARK {
+        AppletProxyModel proxy;
+        proxy.setSourceModel(&model);
+    }
+}
+
+void NetworkModelBenchmark::appletFilter_data()
+{
+    setupData();
+}
+
+void NetworkModelBenchmark::appletFilter()
+{
+    QFETCH(int, connections);
+    QFETCH(int, devices);
+    QFETCH(int, networks);
+
+    TraceBackend backend;
+    QVERIFY(SimulatedTrace(connections, devices, networks).load(&backend));
+    NetworkModel model(&backend);
+    waitForLoading(model);
+    AppletProxyModel proxy;
+    proxy.setSourceModel(&model);
+    const int rows = proxy.rowCount();
+
+    QBENCHMARK {
+        proxy.setFilterRegExp(QStringLiteral("network 1"));
+        proxy.setFilterRegExp(QString());
+    }
+
+    QCOMPARE(proxy.rowCount(), rows);
+}
+
+void NetworkModelBenchmark::mobileSort_data()
+{
+    setupData();
+}
+
+void NetworkModelBenchmark::mobileSort()
+{
+    QFETCH(int, connections);
+    QFETCH(int, devices);
+    QFETCH(int, networks);
+
+    TraceBackend backend;
+    QVERIFY(SimulatedTrace(connections, devices, networks).load(&backend));
+    NetworkModel model(&backend);
+    waitForLoading(model);
+
+    QBENCHMARK {
+        MobileProxyModel proxy;
+        proxy.setShowSavedMode(false);
+        proxy.setSourceModel(&model);
+    }
+}
+
+void NetworkModelBenchmark::memoryPerItem_data()
+{
+    setupData();
+}
+
+void NetworkModelBenchmark::memoryPerItem()
+{
+#ifdef HAVE_MALLINFO2
+    QFETCH(int, connections);
+    QFETCH(int, devices);
+    QFETCH(int, networks);
+
+    // The state of the backend is not counted
+    TraceBackend backend;
+    QVERIFY(SimulatedTrace(connections, devices, networks).load(&backend));
+
+    const qint64 before = qint64(mallinfo2().uordblks);
+    {
+        NetworkModel model(&backend);
+        waitForLoading(model);
+        AppletProxyModel proxy;
+        proxy.setSourceModel(&model);
+
+        // The heap may shrink in between, e.g. when freed memory is returned to the system
+        const qint64 after = qint64(mallinfo2().uordblks);
+        const int items = model.rowCount(QModelIndex());
+        QVERIFY(items > 0);
+        qInfo("%d items, %lld bytes per item including the indexes and the applet proxy model",
+              items, (after - before) / items);
+    }
+#else
+    QSKIP("Heap usage is measured only with glibc");
+#endif
+}
+
+QTEST_GUILESS_MAIN(NetworkModelBenchmark)
+
+#include "networkmodelbenchmark.moc"
@@ -0,0 +1,93 @@
+/*
+    Copyright 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "networkmodel.h"
+#include "perfcounters.h"
+
+#include <QTest>
+
+class PerfCountersTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void counterTest();
+    void histogramTest();
+    void rolesTest();
+};
+
+void PerfCountersTest::init()
+{
+    PerfCounters::instance()->reset();
+}
+
+void PerfCountersTest::counterTest()
+{
+    PerfCounters *counters = PerfCounters::instance();
+    counters->increment(PerfCounters::ScansIssued);
+    counters->increment(PerfCounters::ScansThrottled, 3);
+
+    const QVariantMap snapshot = counters->snapshot().value(QStringLiteral("Counters")).toMap();
+    QCOMPARE(snapshot.count(), int(PerfCounters::CounterCount));
+    QCOMPARE(snapshot.value(QStringLiteral("ScansIssued")).toULongLong(), 1ULL);
+    QCOMPARE(snapshot.value(QStringLiteral("ScansThrottled")).toULongLong(), 3ULL);
+    QCOMPARE(snapshot.value(QStringLiteral("ItemUpdates")).toULongLong(), 0ULL);
+}
+
+void PerfCountersTest::histogramTest()
+{
+    PerfCounters *counters = PerfCounters::instance();
+    counters->record(PerfCounters::SecretsQueueDepth, 0);
+    counters->record(PerfCounters::SecretsQueueDepth, 3);
+    counters->record(PerfCounters::SecretsQueueDepth, 4);
+    // Too big for any bucket but the last one
+    counters->record(PerfCounters::SecretsQueueDepth, Q_UINT64_C(1) << 40);
+
+    const QVariantMap histogram = counters->snapshot().value(QStringLiteral("Histograms")).toMap().value(QStringLiteral("SecretsQueueDepth")).toMap();
+    QCOMPARE(histogram.value(QStringLiteral("Count")).toULongLong(), 4ULL);
+    QCOMPARE(histogram.value(QStringLiteral("Sum")).toULongLong(), 7ULL + (Q_UINT64_C(1) << 40));
+    QCOMPARE(histogram.value(QStringLiteral("Max")).toULongLong(), Q_UINT64_C(1) << 40);
+
+    const QVariantList buckets = histogram.value(QStringLiteral("Buckets")).toList();
+    QCOMPARE(buckets.count(), int(PerfCounters::BucketCount));
+    QCOMPARE(buckets.at(0).toULongLong(), 1ULL);
+    QCOMPARE(buckets.at(2).toULongLong(), 1ULL);
+    QCOMPARE(buckets.at(3).toULongLong(), 1ULL);
+    QCOMPARE(buckets.last().toULongLong(), 1ULL);
+}
+
+void PerfCountersTest::rolesTest()
+{
+    PerfCounters *counters = PerfCounters::instance();
+    const quint64 signalBit = Q_UINT64_C(1) << (NetworkModel::SignalRole - NetworkModel::ConnectionDetailsRole);
+    const quint64 nameBit = Q_UINT64_C(1) << (NetworkModel::NameRole - NetworkModel::ConnectionDetailsRole);
+    counters->recordRoles(signalBit);
+    counters->recordRoles(signalBit | nameBit);
+
+    const QVariantMap roles = counters->snapshot().value(QStringLiteral("DataChangedRoles")).toMap();
+    QCOMPARE(roles.count(), 2);
+    QCOMPARE(roles.value(QStringLiteral("SignalRole")).toULongLong(), 2ULL);
+    QCOMPARE(roles.value(QStringLiteral("NameRole")).toULongLong(), 1ULL);
+}
+
+QTEST_MAIN(PerfCountersTest)
+
+#include "perfcounterstest.moc"
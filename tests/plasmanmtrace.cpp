@@ -0,0 +1,149 @@
+/*
+    Copyright 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "appletproxymodel.h"
+#include "networkmanagerbackend.h"
+#include "networkmodel.h"
+#include "tracebackend.h"
+#include "tracerecorder.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QTextStream>
+#include <QTimer>
+
+/**
+ * Records what NetworkManager and ModemManager report to plasma-nm into a trace and replays
+ * such a trace into NetworkModel and AppletProxyModel, printing how long the models took.
+ * It's a development tool built with the tests, it's not installed.
+ *
+ *   plasma-nm-trace record crowded.pnmt --duration 120
+ *   plasma-nm-trace replay crowded.pnmt --speed 0
+ */
+
+static int record(const QString &fileName, int duration)
+{
+    NetworkManagerBackend backend;
+    TraceRecorder recorder(&backend);
+    if (!recorder.start(fileName)) {
+        return 1;
+    }
+
+    QTextStream out(stdout);
+    QObject::connect(&recorder, &TraceRecorder::started, [&out, duration] () {
+        out << "Recording for " << duration << " seconds" << Qt::endl;
+        QTimer::singleShot(duration * 1000, QCoreApplication::instance(), &QCoreApplication::quit);
+    });
+
+    const int result = QCoreApplication::exec();
+    const int events = recorder.eventCount();
+    recorder.stop();
+    out << events << " events recorded into " << fileName << Qt::endl;
+    return result;
+}
+
+static int replay(const QString &fileName, qreal speed)
+{
+    TraceBackend backend;
+    if (!backend.load(fileName)) {
+        return 1;
+    }
+    backend.setSpeed(speed);
+
+    QElapsedTimer timer;
+    timer.start();
+    NetworkModel model(&backend);
+    AppletProxyModel proxy;
+    proxy.setSourceModel(&model);
+
+    int dataChanged = 0;
+    int rowsInserted = 0;
+    int rowsRemoved = 0;
+    QObject::connect(&model, &NetworkModel::dataChanged, [&dataChanged] () {
+        ++dataChanged;
+    });
+    QObject::connect(&model, &NetworkModel::rowsInserted, [&rowsInserted] (const QModelIndex &, int first, int last) {
+        rowsInserted += last - first + 1;
+    });
+    QObject::connect(&model, &NetworkModel::rowsRemoved, [&rowsRemoved] (const QModelIndex &, int first, int last) {
+        rowsRemoved += last - first + 1;
+    });
+
+    QTextStream out(stdout);
+    qint64 loadTime = 0;
+    QElapsedTimer replayTimer;
+    auto startReplay = [&] () {
+        loadTime = timer.elapsed();
+        out << model.rowCount(QModelIndex()) << " rows loaded in " << loadTime << " ms, replaying "
+            << backend.eventCount() << " events" << Qt::endl;
+        replayTimer.start();
+        backend.start();
+    };
+
+    // The recorded changes apply to the complete list of saved connections
+    if (model.loading()) {
+        QObject::connect(&model, &NetworkModel::loadingChanged, startReplay);
+    } else {
+        QTimer::singleShot(0, startReplay);
+    }
+
+    QObject::connect(&backend, &TraceBackend::finished, [&] () {
+        // Let the last coalesced updates reach the proxy
+        QTimer::singleShot(model.updateInterval(), QCoreApplication::instance(), &QCoreApplication::quit);
+    });
+
+    const int result = QCoreApplication::exec();
+
+    out << "Replayed in " << replayTimer.elapsed() << " ms: " << dataChanged << " dataChanged, "
+        << rowsInserted << " rows inserted, " << rowsRemoved << " rows removed, "
+        << model.rowCount(QModelIndex()) << " rows and " << proxy.rowCount(QModelIndex()) << " shown at the end" << Qt::endl;
+    return result;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    app.setApplicationName(QStringLiteral("plasma-nm-trace"));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Records and replays traces of the network state plasma-nm follows"));
+    parser.addHelpOption();
+    parser.addPositionalArgument(QStringLiteral("command"), QStringLiteral("record or replay"));
+    parser.addPositionalArgument(QStringLiteral("file"), QStringLiteral("Trace file"));
+    QCommandLineOption durationOption(QStringLiteral("duration"), QStringLiteral("Seconds to record for, 60 by default"), QStringLiteral("seconds"), QStringLiteral("60"));
+    QCommandLineOption speedOption(QStringLiteral("speed"), QStringLiteral("Replay speed relative to the recording, 0 (the default) replays as fast as possible"), QStringLiteral("factor"), QStringLiteral("0"));
+    parser.addOption(durationOption);
+    parser.addOption(speedOption);
+    parser.process(app);
+
+    const QStringList args = parser.positionalArguments();
+    if (args.count() != 2) {
+        parser.showHelp(1);
+    }
+
+    if (args.at(0) == QLatin1String("record")) {
+        return record(args.at(1), qMax(1, parser.value(durationOption).toInt()));
+    } else if (args.at(0) == QLatin1String("replay")) {
+        return replay(args.at(1), parser.value(speedOption).toDouble());
+    }
+
+    parser.showHelp(1);
+}
@@ -0,0 +1,281 @@
+/*
+    Copyright 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "networkmodel.h"
+#include "tracebackend.h"
+#include "tracerecorder.h"
+
+#include <QBuffer>
+#include <QSignalSpy>
+#include <QTest>
+
+#define DEVICE_PATH "/org/freedesktop/NetworkManager/Devices/1"
+#define CONNECTION_PATH "/org/freedesktop/NetworkManager/Settings/1"
+
+class TraceBackendTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void snapshotTest();
+    void replayTest();
+    void recordTest();
+    void stateReasonTest();
+
+private:
+    static BackendWirelessNetwork network(const QString &ssid, int accessPoint, int signal);
+    int rowOf(const NetworkModel &model, const QString &ssid) const;
+
+    QByteArray m_trace;
+};
+
+BackendWirelessNetwork TraceBackendTest::network(const QString &ssid, int accessPoint, int signal)
+{
+    BackendAccessPoint ap;
+    ap.path = QStringLiteral("/org/freedesktop/NetworkManager/AccessPoint/%1").arg(accessPoint);
+    ap.hardwareAddress = QStringLiteral("00:11:22:33:44:%1").arg(accessPoint, 2, 10, QLatin1Char('0'));
+    ap.signal = signal;
+
+    BackendWirelessNetwork network;
+    network.devicePath = QStringLiteral(DEVICE_PATH);
+    network.ssid = ssid;
+    network.signal = signal;
+    network.referenceAccessPoint = ap;
+    network.accessPoints << ap;
+    network.securityType = NetworkManager::Wpa2Psk;
+    return network;
+}
+
+int TraceBackendTest::rowOf(const NetworkModel &model, const QString &ssid) const
+{
+    for (int row = 0; row < model.rowCount(QModelIndex()); ++row) {
+        const QModelIndex index = model.index(row, 0);
+        if (index.data(NetworkModel::SsidRole).toString() == ssid) {
+            return row;
+        }
+    }
+    return -1;
+}
+
+void TraceBackendTest::init()
+{
+    m_trace.clear();
+    QBuffer buffer(&m_trace);
+    buffer.open(QIODevice::WriteOnly);
+    QDataStream stream(&buffer);
+    TraceBackend::writeHeader(stream);
+
+    TraceEvent event;
+    event.type = TraceEvent::Status;
+    event.status = NetworkManager::Connected;
+    stream << event;
+
+    event.type = TraceEvent::ConnectionAdded;
+    event.connection.path = QStringLiteral(CONNECTION_PATH);
+    event.connection.id = QStringLiteral("Home");
+    event.connection.uuid = QStringLiteral("c4b2f0a6-52b8-4a4e-9a3b-6f1d4e0a0001");
+    event.connection.type = NetworkManager::ConnectionSettings::Wireless;
+    event.connection.ssid = QStringLiteral("Home");
+    event.connection.securityType = NetworkManager::Wpa2Psk;
+    stream << event;
+
+    event.type = TraceEvent::DeviceAdded;
+    event.device.path = QStringLiteral(DEVICE_PATH);
+    event.device.interfaceName = QStringLiteral("wlan0");
+    event.device.type = NetworkManager::Device::Wifi;
+    event.device.state = NetworkManager::Device::Disconnected;
+    event.device.managed = true;
+    event.device.availableConnections << QStringLiteral(CONNECTION_PATH);
+    event.device.permanentHardwareAddress = QStringLiteral("00:11:22:33:44:55");
+    stream << event;
+
+    event.type = TraceEvent::WirelessNetworkAppeared;
+    event.network = network(QStringLiteral("Home"), 1, 50);
+    stream << event;
+    event.network = network(QStringLiteral("Cafe"), 2, 30);
+    stream << event;
+
+    event.type = TraceEvent::SnapshotEnd;
+    stream << event;
+
+    event.time = 10;
+    event.type = TraceEvent::WirelessNetworkSignalChanged;
+    event.network = network(QStringLiteral("Cafe"), 2, 80);
+    stream << event;
+
+    event.time = 20;
+    event.type = TraceEvent::WirelessNetworkDisappeared;
+    stream << event;
+}
+
+void TraceBackendTest::snapshotTest()
+{
+    TraceBackend backend;
+    QBuffer trace(&m_trace);
+    trace.open(QIODevice::ReadOnly);
+    QVERIFY(backend.load(&trace));
+    QCOMPARE(backend.eventCount(), 2);
+    QCOMPARE(backend.status(), NetworkManager::Connected);
+    QCOMPARE(backend.devices(), QStringList{QStringLiteral(DEVICE_PATH)});
+    QCOMPARE(backend.wirelessNetworks(QStringLiteral(DEVICE_PATH)).count(), 2);
+    QCOMPARE(backend.connection(QStringLiteral(CONNECTION_PATH)).id, QStringLiteral("Home"));
+
+    // The connection is merged with its network, the other network is listed on its own
+    NetworkModel model(&backend);
+    QTRY_VERIFY(!model.loading());
+    QCOMPARE(model.rowCount(QModelIndex()), 2);
+    const int home = rowOf(model, QStringLiteral("Home"));
+    QVERIFY(home >= 0);
+    QCOMPARE(model.index(home, 0).data(NetworkModel::ConnectionPathRole).toString(), QStringLiteral(CONNECTION_PATH));
+    QCOMPARE(model.index(home, 0).data(NetworkModel::SignalRole).toInt(), 50);
+    // Details are built from the recorded device, not from the system bus
+    QVERIFY(model.index(home, 0).data(NetworkModel::ConnectionDetailsRole).toStringList().contains(QStringLiteral("00:11:22:33:44:55")));
+}
+
+void TraceBackendTest::replayTest()
+{
+    TraceBackend backend;
+    QBuffer trace(&m_trace);
+    trace.open(QIODevice::ReadOnly);
+    QVERIFY(backend.load(&trace));
+    NetworkModel model(&backend);
+    QTRY_VERIFY(!model.loading());
+
+    QVERIFY(backend.step());
+    QTRY_COMPARE(model.index(rowOf(model, QStringLiteral("Cafe")), 0).data(NetworkModel::SignalRole).toInt(), 80);
+
+    QVERIFY(backend.step());
+    QVERIFY(backend.atEnd());
+    QCOMPARE(model.rowCount(QModelIndex()), 1);
+    QCOMPARE(rowOf(model, QStringLiteral("Cafe")), -1);
+}
+
+void TraceBackendTest::recordTest()
+{
+    TraceBackend source;
+    QBuffer trace(&m_trace);
+    trace.open(QIODevice::ReadOnly);
+    QVERIFY(source.load(&trace));
+
+    QByteArray recording;
+    QBuffer buffer(&recording);
+    buffer.open(QIODevice::WriteOnly);
+    TraceRecorder recorder(&source);
+    recorder.start(&buffer);
+    QTRY_VERIFY(recorder.isRecording());
+
+    QSignalSpy finished(&source, &TraceBackend::finished);
+    source.start();
+    QVERIFY(finished.wait());
+    recorder.stop();
+    QCOMPARE(recorder.eventCount(), 2);
+
+    // The recording replays to the same state as the trace it was recorded from
+    TraceBackend replay;
+    buffer.close();
+    buffer.open(QIODevice::ReadOnly);
+    QVERIFY(replay.load(&buffer));
+    QCOMPARE(replay.eventCount(), 2);
+    QCOMPARE(replay.status(), NetworkManager::Connected);
+    QCOMPARE(replay.devices(), QStringList{QStringLiteral(DEVICE_PATH)});
+    QCOMPARE(replay.wirelessNetworks(QStringLiteral(DEVICE_PATH)).count(), 2);
+    QCOMPARE(replay.connection(QStringLiteral(CONNECTION_PATH)).id, QStringLiteral("Home"));
+    QCOMPARE(replay.wirelessNetwork(QStringLiteral(DEVICE_PATH), QStringLiteral("Cafe")).signal, 30);
+
+    while (replay.step()) {
+    }
+    QCOMPARE(replay.wirelessNetworks(QStringLiteral(DEVICE_PATH)), QStringList{QStringLiteral("Home")});
+}
+
+void TraceBackendTest::stateReasonTest()
+{
+    QByteArray trace;
+    QBuffer buffer(&trace);
+    buffer.open(QIODevice::WriteOnly);
+    QDataStream stream(&buffer);
+    TraceBackend::writeHeader(stream);
+
+    TraceEvent event;
+    event.type = TraceEvent::DeviceAdded;
+    event.device.path = QStringLiteral(DEVICE_PATH);
+    event.device.type = NetworkManager::Device::Wifi;
+    event.device.state = NetworkManager::Device::Activated;
+    stream << event;
+
+    event.type = TraceEvent::ConnectivityChanged;
+    event.connectivity = NetworkManager::Full;
+    stream << event;
+
+    event.type = TraceEvent::PrimaryConnectionChanged;
+    event.path = QStringLiteral("/org/freedesktop/NetworkManager/ActiveConnection/1");
+    stream << event;
+
+    event.type = TraceEvent::SnapshotEnd;
+    stream << event;
+
+    event.time = 10;
+    event.type = TraceEvent::DeviceStateChanged;
+    event.device.state = NetworkManager::Device::Disconnected;
+    event.oldDeviceState = NetworkManager::Device::Activated;
+    event.deviceStateReason = NetworkManager::Device::CarrierReason;
+    stream << event;
+
+    event.type = TraceEvent::ConnectivityChanged;
+    event.connectivity = NetworkManager::NoConnectivity;
+    stream << event;
+
+    event.type = TraceEvent::PrimaryConnectionChanged;
+    event.path.clear();
+    stream << event;
+    buffer.close();
+
+    // The reasons the notifications are based on and what the icon follows are replayed too
+    TraceBackend backend;
+    buffer.open(QIODevice::ReadOnly);
+    QVERIFY(backend.load(&buffer));
+    QCOMPARE(backend.eventCount(), 3);
+    QCOMPARE(backend.connectivity(), NetworkManager::Full);
+    QCOMPARE(backend.primaryConnection(), QStringLiteral("/org/freedesktop/NetworkManager/ActiveConnection/1"));
+
+    NetworkManager::Device::State oldState = NetworkManager::Device::UnknownState;
+    NetworkManager::Device::StateChangeReason reason = NetworkManager::Device::UnknownReason;
+    connect(&backend, &NetworkBackend::deviceStateChanged, this, [&oldState, &reason] (const QString &path, NetworkManager::Device::State state,
+                                                                                        NetworkManager::Device::State previousState, NetworkManager::Device::StateChangeReason stateReason) {
+        Q_UNUSED(path);
+        Q_UNUSED(state);
+        oldState = previousState;
+        reason = stateReason;
+    });
+
+    QVERIFY(backend.step());
+    QCOMPARE(backend.device(QStringLiteral(DEVICE_PATH)).state, NetworkManager::Device::Disconnected);
+    QCOMPARE(oldState, NetworkManager::Device::Activated);
+    QCOMPARE(reason, NetworkManager::Device::CarrierReason);
+
+    QVERIFY(backend.step());
+    QCOMPARE(backend.connectivity(), NetworkManager::NoConnectivity);
+    QVERIFY(backend.step());
+    QVERIFY(backend.primaryConnection().isEmpty());
+}
+
+QTEST_MAIN(TraceBackendTest)
+
+#include "tracebackendtest.moc"
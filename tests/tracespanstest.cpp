@@ -0,0 +1,106 @@
+/*
+    Copyright 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "tracespans.h"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTest>
+
+class TraceSpansTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void disabledTest();
+    void dumpTest();
+    void ringTest();
+};
+
+static QJsonArray traceEvents()
+{
+    QJsonParseError error;
+    const QJsonDocument document = QJsonDocument::fromJson(TraceSpans::instance()->dump().toUtf8(), &error);
+    if (error.error != QJsonParseError::NoError) {
+        qWarning() << error.errorString();
+        return QJsonArray();
+    }
+    return document.object().value(QStringLiteral("traceEvents")).toArray();
+}
+
+void TraceSpansTest::init()
+{
+    TraceSpans::instance()->clear();
+    TraceSpans::instance()->setEnabled(true);
+}
+
+void TraceSpansTest::disabledTest()
+{
+    TraceSpans::instance()->setEnabled(false);
+    {
+        TRACE_SPAN("disabled");
+    }
+    QCOMPARE(traceEvents().count(), 0);
+}
+
+void TraceSpansTest::dumpTest()
+{
+    {
+        TRACE_SPAN("outer");
+        QTest::qSleep(2);
+        {
+            TRACE_SPAN("inner");
+        }
+    }
+
+    const QJsonArray events = traceEvents();
+    QCOMPARE(events.count(), 2);
+
+    // Spans are added when they end, the inner one first
+    const QJsonObject inner = events.at(0).toObject();
+    const QJsonObject outer = events.at(1).toObject();
+    QCOMPARE(inner.value(QStringLiteral("name")).toString(), QStringLiteral("inner"));
+    QCOMPARE(outer.value(QStringLiteral("name")).toString(), QStringLiteral("outer"));
+    QCOMPARE(outer.value(QStringLiteral("ph")).toString(), QStringLiteral("X"));
+    QCOMPARE(outer.value(QStringLiteral("pid")).toVariant().toLongLong(), QCoreApplication::applicationPid());
+    QVERIFY(outer.value(QStringLiteral("dur")).toDouble() >= 2000.0);
+    QVERIFY(inner.value(QStringLiteral("ts")).toDouble() >= outer.value(QStringLiteral("ts")).toDouble());
+}
+
+void TraceSpansTest::ringTest()
+{
+    TraceSpans *spans = TraceSpans::instance();
+    for (int i = 0; i < TraceSpans::Capacity; ++i) {
+        spans->add("old", i, i + 1);
+    }
+    spans->add("new", TraceSpans::Capacity, TraceSpans::Capacity + 1);
+
+    // The oldest span is overwritten and the newest one comes last
+    const QJsonArray events = traceEvents();
+    QCOMPARE(events.count(), int(TraceSpans::Capacity));
+    QCOMPARE(events.first().toObject().value(QStringLiteral("ts")).toDouble(), 0.001);
+    QCOMPARE(events.last().toObject().value(QStringLiteral("name")).toString(), QStringLiteral("new"));
+}
+
+QTEST_MAIN(TraceSpansTest)
+
+#include "tracespanstest.moc"
@@ -0,0 +1,109 @@
+/*
+    Copyright 2026 agent <agent@local>
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "trafficrates.h"
+#include <QTest>
+
+class TrafficRatesTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void jitterTest();
+    void mergeTest();
+    void resetTest();
+    void historyTest();
+    void historyOrderTest();
+};
+
+void TrafficRatesTest::jitterTest()
+{
+    TrafficRates rates;
+    QCOMPARE(rates.rxRate(), 0.0);
+
+    rates.addSample(1000, 0, 0);
+    QCOMPARE(rates.rxRate(), 0.0);
+
+    // The sample came late, the rate has to be computed from the real interval
+    rates.addSample(3500, 5000, 2500);
+    QCOMPARE(rates.rxRate(), 2000.0);
+    QCOMPARE(rates.txRate(), 1000.0);
+}
+
+void TrafficRatesTest::mergeTest()
+{
+    TrafficRates rates;
+    rates.addSample(0, 0, 0);
+    // rx and tx are reported one after the other
+    rates.addSample(2000, 4000, 0);
+    rates.addSample(2001, 4000, 2000);
+    QCOMPARE(rates.rxRate(), 2000.0);
+    QCOMPARE(rates.txRate(), 1000.0);
+    QCOMPARE(rates.rxRateHistory().count(), 1);
+}
+
+void TrafficRatesTest::resetTest()
+{
+    TrafficRates rates;
+    rates.addSample(0, 1000, 1000);
+    rates.addSample(2000, 3000, 3000);
+
+    // Counters of the device were reset
+    rates.addSample(4000, 10, 10);
+    QCOMPARE(rates.rxRate(), 0.0);
+    QVERIFY(rates.rxRateHistory().isEmpty());
+
+    // Statistics weren't refreshed for a long time
+    rates.addSample(6000, 2010, 2010);
+    QCOMPARE(rates.rxRate(), 1000.0);
+    rates.addSample(6000 + TrafficRates::MaximumGap + 1, 4010, 4010);
+    QCOMPARE(rates.rxRate(), 0.0);
+}
+
+void TrafficRatesTest::historyTest()
+{
+    TrafficRates rates;
+    for (int i = 0; i <= 2 * TrafficRates::HistorySize; ++i) {
+        rates.addSample(i * 1000, i * i * 1000, 0);
+    }
+
+    const QVariantList history = rates.rxRateHistory();
+    QCOMPARE(history.count(), static_cast<int>(TrafficRates::HistorySize));
+    // The newest rate goes first
+    QCOMPARE(history.first().toReal(), (4.0 * TrafficRates::HistorySize - 1) * 1000);
+    QCOMPARE(history.last().toReal(), (2.0 * (TrafficRates::HistorySize + 1) - 1) * 1000);
+    QCOMPARE(rates.rxRate(), history.first().toReal());
+}
+
+void TrafficRatesTest::historyOrderTest()
+{
+    TrafficRates rates;
+    rates.addSample(0, 0, 0);
+    rates.addSample(1000, 1000, 3000);
+    rates.addSample(2000, 3000, 5000);
+    rates.addSample(3000, 6000, 6000);
+
+    QCOMPARE(rates.rxRateHistory(), QVariantList({3000.0, 2000.0, 1000.0}));
+    QCOMPARE(rates.txRateHistory(), QVariantList({1000.0, 2000.0, 3000.0}));
+}
+
+QTEST_GUILESS_MAIN(TrafficRatesTest)
+
+#include "trafficratestest.moc"